@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+#include <unistd.h>
+
+namespace mxl::bench
+{
+    namespace
+    {
+        std::filesystem::path getDomainRoot()
+        {
+#ifdef __linux__
+            // Flows are meant to live on a tmpfs, so measure them there.
+            return "/dev/shm";
+#else
+            return std::filesystem::temp_directory_path();
+#endif
+        }
+
+        std::filesystem::path makeDomainPath()
+        {
+            static auto counter = std::atomic<unsigned>{0U};
+            return getDomainRoot() / ("mxl-bench-" + std::to_string(::getpid()) + "-" + std::to_string(counter.fetch_add(1U)));
+        }
+
+        std::string makeVideoFlowDef(std::string const& id, std::uint32_t rateNumerator, std::uint32_t rateDenominator, std::uint32_t width,
+            std::uint32_t height)
+        {
+            auto result = std::string{};
+            result += R"({"id": ")" + id + R"(",)";
+            result += R"("description": "mxl-bench video flow", "label": "mxl-bench video flow", "parents": [],)";
+            result += R"("tags": {"urn:x-nmos:tag:grouphint/v1.0": ["mxl-bench:Video"]},)";
+            result += R"("format": "urn:x-nmos:format:video", "media_type": "video/v210",)";
+            result += R"("grain_rate": {"numerator": )" + std::to_string(rateNumerator) + R"(, "denominator": )" +
+                      std::to_string(rateDenominator) + "},";
+            result += R"("frame_width": )" + std::to_string(width) + R"(, "frame_height": )" + std::to_string(height) + ",";
+            result += R"("interlace_mode": "progressive", "colorspace": "BT709", "components": [)";
+            result += R"({"name": "Y", "width": )" + std::to_string(width) + R"(, "height": )" + std::to_string(height) +
+                      R"(, "bit_depth": 10},)";
+            result += R"({"name": "Cb", "width": )" + std::to_string(width / 2U) + R"(, "height": )" + std::to_string(height) +
+                      R"(, "bit_depth": 10},)";
+            result += R"({"name": "Cr", "width": )" + std::to_string(width / 2U) + R"(, "height": )" + std::to_string(height) +
+                      R"(, "bit_depth": 10}]})";
+            return result;
+        }
+    }
+
+    Domain::Domain(std::string const& domainOptions)
+        : _path{makeDomainPath()}
+    {
+        std::filesystem::remove_all(_path);
+        std::filesystem::create_directories(_path);
+        if (!domainOptions.empty())
+        {
+            std::ofstream{_path / "options.json"} << domainOptions;
+        }
+    }
+
+    Domain::~Domain()
+    {
+        auto ec = std::error_code{};
+        std::filesystem::remove_all(_path, ec);
+    }
+
+    InstancePtr makeInstance(Domain const& domain, char const* options)
+    {
+        return InstancePtr{mxlCreateInstance(domain.path().string().c_str(), options)};
+    }
+
+    std::string makeFlowId(std::size_t n)
+    {
+        char buffer[37];
+        std::snprintf(buffer, sizeof(buffer), "6d786c00-6265-4e63-8800-%012zx", n);
+        return buffer;
+    }
+
+    std::string makeVideoFlowDef(std::string const& id, std::uint32_t height)
+    {
+        return makeVideoFlowDef(id, 30000U, 1001U, 1920U, height);
+    }
+
+    std::string makeSmallVideoFlowDef(std::string const& id, std::uint32_t rateNumerator)
+    {
+        return makeVideoFlowDef(id, rateNumerator, 1U, 48U, 8U);
+    }
+
+    std::string makeAudioFlowDef(std::string const& id, std::uint32_t channelCount)
+    {
+        auto result = std::string{};
+        result += R"({"id": ")" + id + R"(",)";
+        result += R"("description": "mxl-bench audio flow", "label": "mxl-bench audio flow", "parents": [],)";
+        result += R"("tags": {"urn:x-nmos:tag:grouphint/v1.0": ["mxl-bench:Audio"]},)";
+        result += R"("format": "urn:x-nmos:format:audio", "media_type": "audio/float32",)";
+        result += R"("sample_rate": {"numerator": 48000}, "bit_depth": 32, "channel_count": )" + std::to_string(channelCount) + "}";
+        return result;
+    }
+
+    void LatencyRecorder::merge(LatencyRecorder const& other)
+    {
+        _samples.insert(_samples.end(), other._samples.begin(), other._samples.end());
+    }
+
+    void LatencyRecorder::report(benchmark::State& state)
+    {
+        if (_samples.empty())
+        {
+            return;
+        }
+
+        std::ranges::sort(_samples);
+        auto const percentile = [this](double p)
+        {
+            auto const rank = static_cast<std::size_t>(p * static_cast<double>(_samples.size() - 1U));
+            return static_cast<double>(_samples[rank]);
+        };
+
+        state.counters["p50_ns"] = percentile(0.5);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+        state.counters["max_ns"] = static_cast<double>(_samples.back());
+    }
+}
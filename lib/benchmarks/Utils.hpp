@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/mxl.h>
+
+namespace mxl::bench
+{
+    //
+    // RAII helper that creates a uniquely named domain on a tmpfs for the duration of a benchmark.
+    //
+    class Domain
+    {
+    public:
+        /// Create an empty domain. If domainOptions is not empty it is written to the options.json file of the domain.
+        explicit Domain(std::string const& domainOptions = {});
+        ~Domain();
+
+        Domain(Domain const&) = delete;
+        Domain& operator=(Domain const&) = delete;
+
+        [[nodiscard]]
+        std::filesystem::path const& path() const noexcept
+        {
+            return _path;
+        }
+
+    private:
+        std::filesystem::path _path;
+    };
+
+    struct InstanceDeleter
+    {
+        void operator()(mxlInstance instance) const noexcept
+        {
+            mxlDestroyInstance(instance);
+        }
+    };
+
+    /// An owning handle of an mxl instance.
+    using InstancePtr = std::unique_ptr<mxlInstance_t, InstanceDeleter>;
+
+    /// Create an instance in the specified domain, or return an empty handle on failure.
+    InstancePtr makeInstance(Domain const& domain, char const* options = "");
+
+    /// Return a valid flow id that is unique within a benchmark for each value of n.
+    std::string makeFlowId(std::size_t n);
+
+    /// Return the definition of a v210 video flow with the specified id and frame height at 30000/1001.
+    std::string makeVideoFlowDef(std::string const& id, std::uint32_t height = 1080U);
+
+    /// Return the definition of a video flow with a tiny frame at the specified grain rate, for measurements that scale
+    /// with the number of grains rather than with their size.
+    std::string makeSmallVideoFlowDef(std::string const& id, std::uint32_t rateNumerator);
+
+    /// Return the definition of a 48kHz float32 audio flow with the specified id and channel count.
+    std::string makeAudioFlowDef(std::string const& id, std::uint32_t channelCount);
+
+    //
+    // Collects latency samples in nanoseconds and reports their distribution as benchmark counters.
+    //
+    class LatencyRecorder
+    {
+    public:
+        void record(std::uint64_t latencyNs)
+        {
+            _samples.push_back(latencyNs);
+        }
+
+        /// Append all samples of another recorder.
+        void merge(LatencyRecorder const& other);
+
+        /// Store the 50th, 99th and 99.9th percentile and the maximum of all samples in the counters of state.
+        void report(benchmark::State& state);
+
+    private:
+        std::vector<std::uint64_t> _samples;
+    };
+}
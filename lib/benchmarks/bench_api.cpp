@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    /// Per-call cost of mxlFlowReaderGetGrainNonBlocking() for a grain that is already available, which is dominated by
+    /// the dispatch from the C handle to the reader implementation.
+    void BM_ApiGetGrainNonBlocking(benchmark::State& state)
+    {
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeSmallVideoFlowDef(flowId, 100U);
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto reader = mxlFlowReader{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+            (mxlCreateFlowReader(instance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow.");
+            return;
+        }
+
+        auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        auto info = mxlGrainInfo{};
+        auto payload = static_cast<std::uint8_t*>(nullptr);
+        if (mxlFlowWriterOpenGrain(writer, index, &info, &payload) == MXL_STATUS_OK)
+        {
+            info.validSlices = info.totalSlices;
+            mxlFlowWriterCommitGrain(writer, &info);
+        }
+
+        for (auto _ : state)
+        {
+            if (mxlFlowReaderGetGrainNonBlocking(reader, index, &info, &payload) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to get the grain.");
+                break;
+            }
+            benchmark::DoNotOptimize(payload);
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        mxlReleaseFlowReader(instance.get(), reader);
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+
+    /// Per-call cost of opening and committing a grain through the C API.
+    void BM_ApiOpenCommitGrain(benchmark::State& state)
+    {
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeSmallVideoFlowDef(flowId, 100U);
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow writer.");
+            return;
+        }
+
+        auto index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        for (auto _ : state)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            if (mxlFlowWriterOpenGrain(writer, index++, &info, &payload) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to open the grain.");
+                break;
+            }
+            info.validSlices = info.totalSlices;
+            mxlFlowWriterCommitGrain(writer, &info);
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+
+    /// Per-call cost of mxlFlowReaderGetSamplesNonBlocking() for a range of samples that is already available.
+    void BM_ApiGetSamplesNonBlocking(benchmark::State& state)
+    {
+        constexpr auto sampleCount = std::size_t{48U};
+
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeAudioFlowDef(flowId, 2U);
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto reader = mxlFlowReader{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+            (mxlCreateFlowReader(instance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow.");
+            return;
+        }
+
+        auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        auto writeSlices = mxlMutableWrappedMultiBufferSlice{};
+        if (mxlFlowWriterOpenSamples(writer, index, sampleCount, &writeSlices) == MXL_STATUS_OK)
+        {
+            mxlFlowWriterCommitSamples(writer);
+        }
+
+        auto slices = mxlWrappedMultiBufferSlice{};
+        for (auto _ : state)
+        {
+            if (mxlFlowReaderGetSamplesNonBlocking(reader, index, sampleCount, &slices) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to get the samples.");
+                break;
+            }
+            benchmark::DoNotOptimize(slices);
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        mxlReleaseFlowReader(instance.get(), reader);
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+}
+
+BENCHMARK(BM_ApiGetGrainNonBlocking);
+BENCHMARK(BM_ApiOpenCommitGrain);
+BENCHMARK(BM_ApiGetSamplesNonBlocking);
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    constexpr auto TAI_CLOCK_SOURCES = std::array{"kernel", "realtime", "monotonic"};
+
+    /// Number of comparisons against the kernel TAI clock, spread out so that they span at least one refresh of the offset.
+    constexpr auto DRIFT_SAMPLES = 300;
+    constexpr auto DRIFT_SAMPLE_INTERVAL = std::chrono::milliseconds{5};
+
+    std::string makeClockSourceOptions(char const* source)
+    {
+        return std::string{R"({"urn:x-mxl:option:tai_clock_source/v1.0": ")"} + source + R"("})";
+    }
+
+    std::int64_t readKernelTai() noexcept
+    {
+        auto ts = std::timespec{};
+#if defined(CLOCK_TAI)
+        ::clock_gettime(CLOCK_TAI, &ts);
+        return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+#else
+        ::clock_gettime(CLOCK_REALTIME, &ts);
+        return (ts.tv_sec + 37) * 1'000'000'000LL + ts.tv_nsec;
+#endif
+    }
+
+    /// Per-call cost of mxlGetTime() with the TAI clock source selected by the argument. Afterwards, compares it against
+    /// the kernel TAI clock for a while and reports the largest difference seen as "max_drift_ns".
+    void BM_GetTime(benchmark::State& state)
+    {
+        auto const source = TAI_CLOCK_SOURCES[state.range(0)];
+        state.SetLabel(source);
+
+        auto const domain = Domain{};
+        auto const options = makeClockSourceOptions(source);
+        auto const instance = makeInstance(domain, options.c_str());
+        if (!instance)
+        {
+            state.SkipWithError("Failed to create the instance.");
+            return;
+        }
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mxlGetTime());
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        auto maxDrift = std::int64_t{0};
+        for (auto i = 0; i < DRIFT_SAMPLES; ++i)
+        {
+            // Compare against the middle of two kernel reads, to not count the time between the reads as drift.
+            auto const before = readKernelTai();
+            auto const time = static_cast<std::int64_t>(mxlGetTime());
+            auto const after = readKernelTai();
+            auto const drift = time - (before + (after - before) / 2);
+            maxDrift = std::max(maxDrift, (drift < 0) ? -drift : drift);
+
+            std::this_thread::sleep_for(DRIFT_SAMPLE_INTERVAL);
+        }
+        state.counters["max_drift_ns"] = static_cast<double>(maxDrift);
+
+        // The source applies to the whole process, so restore the default for the benchmarks that follow.
+        auto const defaultOptions = makeClockSourceOptions(TAI_CLOCK_SOURCES[0]);
+        makeInstance(domain, defaultOptions.c_str());
+    }
+}
+
+BENCHMARK(BM_GetTime)->ArgName("source")->DenseRange(0, TAI_CLOCK_SOURCES.size() - 1);
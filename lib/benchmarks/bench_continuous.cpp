@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    /// Copy all fragments of all channels of a sample range into a contiguous buffer.
+    void copySamples(mxlWrappedMultiBufferSlice const& slices, std::uint8_t* destination)
+    {
+        for (auto channel = std::size_t{0}; channel < slices.count; ++channel)
+        {
+            for (auto const& fragment : slices.base.fragments)
+            {
+                std::memcpy(destination, static_cast<std::uint8_t const*>(fragment.pointer) + channel * slices.stride, fragment.size);
+                destination += fragment.size;
+            }
+        }
+    }
+
+    /// Writes and reads back the specified number of samples per iteration, with every range chosen such that it straddles the
+    /// wrap-around point of the ring buffer. This is the worst case for readers, because every channel is split into two
+    /// fragments.
+    void BM_GetSamplesWrapAround(benchmark::State& state)
+    {
+        auto const channelCount = static_cast<std::uint32_t>(state.range(0));
+        auto const count = static_cast<std::size_t>(state.range(1));
+
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeAudioFlowDef(flowId, channelCount);
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto reader = mxlFlowReader{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+            (mxlCreateFlowReader(instance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow writer or reader.");
+            return;
+        }
+
+        auto const bufferLength = std::uint64_t{configInfo.continuous.bufferLength};
+        auto maxWriteLength = std::size_t{};
+        if ((mxlFlowWriterGetMaxWriteLengthSamples(writer, &maxWriteLength) != MXL_STATUS_OK) || (count > maxWriteLength))
+        {
+            state.SkipWithError("The sample count exceeds the maximum write length.");
+            return;
+        }
+
+        auto destination = std::vector<std::uint8_t>(count * channelCount * sizeof(float));
+        auto index = ((mxlGetCurrentIndex(&configInfo.common.grainRate) / bufferLength) + 1U) * bufferLength + (count / 2U);
+        for (auto _ : state)
+        {
+            auto writeSlices = mxlMutableWrappedMultiBufferSlice{};
+            if (mxlFlowWriterOpenSamples(writer, index, count, &writeSlices) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to open samples.");
+                break;
+            }
+            mxlFlowWriterCommitSamples(writer);
+
+            auto readSlices = mxlWrappedMultiBufferSlice{};
+            if (mxlFlowReaderGetSamples(reader, index, count, 0U, &readSlices) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to get samples.");
+                break;
+            }
+            copySamples(readSlices, destination.data());
+            benchmark::DoNotOptimize(destination.data());
+
+            index += bufferLength;
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(destination.size()));
+
+        mxlReleaseFlowReader(instance.get(), reader);
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+
+    /// Baseline for BM_CopySamplesInterleaved: What consumers that need interleaved samples do with the slices returned by
+    /// mxlFlowReaderGetSamples().
+    void interleaveSamples(mxlWrappedMultiBufferSlice const& slices, float* destination)
+    {
+        auto frame = std::size_t{0};
+        for (auto const& fragment : slices.base.fragments)
+        {
+            auto const frames = fragment.size / sizeof(float);
+            for (auto channel = std::size_t{0}; channel < slices.count; ++channel)
+            {
+                auto const samples = reinterpret_cast<float const*>(static_cast<std::uint8_t const*>(fragment.pointer) + channel * slices.stride);
+                for (auto i = std::size_t{0}; i < frames; ++i)
+                {
+                    destination[(frame + i) * slices.count + channel] = samples[i];
+                }
+            }
+            frame += frames;
+        }
+    }
+
+    /// Reads the specified number of samples per iteration into an interleaved buffer, either with a loop over the slices
+    /// returned by mxlFlowReaderGetSamples() (format -1), or with mxlFlowReaderCopySamplesInterleaved() converting to the
+    /// specified mxlSampleFormat. Integer formats are dithered.
+    void BM_CopySamplesInterleaved(benchmark::State& state)
+    {
+        auto const channelCount = static_cast<std::uint32_t>(state.range(0));
+        auto const count = static_cast<std::size_t>(state.range(1));
+        auto const format = state.range(2);
+
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeAudioFlowDef(flowId, channelCount);
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto reader = mxlFlowReader{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+            (mxlCreateFlowReader(instance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow writer or reader.");
+            return;
+        }
+
+        auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        auto writeSlices = mxlMutableWrappedMultiBufferSlice{};
+        if (mxlFlowWriterOpenSamples(writer, index, count, &writeSlices) != MXL_STATUS_OK)
+        {
+            state.SkipWithError("Failed to open samples.");
+            return;
+        }
+        mxlFlowWriterCommitSamples(writer);
+
+        auto destination = std::vector<float>(count * channelCount);
+        for (auto _ : state)
+        {
+            if (format < 0)
+            {
+                auto readSlices = mxlWrappedMultiBufferSlice{};
+                if (mxlFlowReaderGetSamplesNonBlocking(reader, index, count, &readSlices) != MXL_STATUS_OK)
+                {
+                    state.SkipWithError("Failed to get samples.");
+                    break;
+                }
+                interleaveSamples(readSlices, destination.data());
+            }
+            else if (mxlFlowReaderCopySamplesInterleaved(reader,
+                         index,
+                         count,
+                         0U,
+                         static_cast<mxlSampleFormat>(format),
+                         MXL_SAMPLE_CONVERSION_FLAG_DITHER,
+                         destination.data(),
+                         destination.size() * sizeof(float)) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to copy samples.");
+                break;
+            }
+            benchmark::DoNotOptimize(destination.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+
+        mxlReleaseFlowReader(instance.get(), reader);
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+
+    constexpr char const* CONTINUOUS_FLOW_LAYOUTS[] = {"planar", "interleaved"};
+
+    /// Streams the specified number of interleaved frames per iteration through a flow that stores them with the layout
+    /// selected by the argument: mxlFlowWriterWriteSamplesInterleaved() followed by mxlFlowReaderCopySamplesInterleaved(),
+    /// both in the native format. Planar flows transpose the frames on both sides, interleaved flows copy them as they are.
+    void BM_ContinuousLayout(benchmark::State& state)
+    {
+        auto const layout = CONTINUOUS_FLOW_LAYOUTS[state.range(0)];
+        auto const channelCount = static_cast<std::uint32_t>(state.range(1));
+        auto const count = static_cast<std::size_t>(state.range(2));
+        state.SetLabel(layout);
+
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeAudioFlowDef(flowId, channelCount);
+        auto const options = std::string{R"({"continuousFlowLayout": ")"} + layout + R"("})";
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto reader = mxlFlowReader{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), options.c_str(), &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+            (mxlCreateFlowReader(instance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow writer or reader.");
+            return;
+        }
+
+        auto maxWriteLength = std::size_t{};
+        if ((mxlFlowWriterGetMaxWriteLengthSamples(writer, &maxWriteLength) != MXL_STATUS_OK) || (count > maxWriteLength))
+        {
+            state.SkipWithError("The sample count exceeds the maximum write length.");
+            return;
+        }
+
+        auto source = std::vector<float>(count * channelCount, 0.5f);
+        auto destination = std::vector<float>(count * channelCount);
+        auto const bufferSize = destination.size() * sizeof(float);
+        auto index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        for (auto _ : state)
+        {
+            if (mxlFlowWriterWriteSamplesInterleaved(writer, index, count, MXL_SAMPLE_FORMAT_NATIVE, source.data(), bufferSize) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to write samples.");
+                break;
+            }
+            if (mxlFlowReaderCopySamplesInterleaved(reader, index, count, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, destination.data(), bufferSize) !=
+                MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to copy samples.");
+                break;
+            }
+            benchmark::DoNotOptimize(destination.data());
+            benchmark::ClobberMemory();
+
+            index += count;
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(2U * bufferSize));
+
+        mxlReleaseFlowReader(instance.get(), reader);
+        mxlReleaseFlowWriter(instance.get(), writer);
+    }
+}
+
+BENCHMARK(BM_GetSamplesWrapAround)->ArgNames({"channels", "samples"})->ArgsProduct({{2, 16}, {48, 480, 1920}});
+BENCHMARK(BM_CopySamplesInterleaved)
+    ->ArgNames({"channels", "samples", "format"})
+    ->ArgsProduct({{2, 16, 64}, {48, 480}, {-1, MXL_SAMPLE_FORMAT_NATIVE, MXL_SAMPLE_FORMAT_S16, MXL_SAMPLE_FORMAT_S24}});
+BENCHMARK(BM_ContinuousLayout)->ArgNames({"layout", "channels", "samples"})->ArgsProduct({{0, 1}, {2, 16, 64, 128}, {48, 480}});
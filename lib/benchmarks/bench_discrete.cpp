@@ -0,0 +1,313 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    constexpr auto READER_TIMEOUT_NS = std::uint64_t{100'000'000};
+
+    //
+    // A reader thread with its own instance that reads consecutive grains and acknowledges each grain it received.
+    //
+    class GrainReaderThread
+    {
+    public:
+        GrainReaderThread(Domain const& domain, std::string const& flowId, std::uint64_t firstIndex, std::atomic<std::uint64_t>& acks,
+            std::atomic<bool>& stop)
+            : _instance{makeInstance(domain)}
+            , _reader{nullptr}
+        {
+            if (!_instance || (mxlCreateFlowReader(_instance.get(), flowId.c_str(), "", &_reader) != MXL_STATUS_OK))
+            {
+                _reader = nullptr;
+                return;
+            }
+
+            _thread = std::thread{[this, firstIndex, &acks, &stop]
+                {
+                    run(firstIndex, acks, stop);
+                }};
+        }
+
+        ~GrainReaderThread()
+        {
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+            if (_reader != nullptr)
+            {
+                mxlReleaseFlowReader(_instance.get(), _reader);
+            }
+        }
+
+        [[nodiscard]]
+        bool isValid() const noexcept
+        {
+            return _reader != nullptr;
+        }
+
+        void join()
+        {
+            _thread.join();
+        }
+
+        [[nodiscard]]
+        LatencyRecorder const& latencies() const noexcept
+        {
+            return _latencies;
+        }
+
+        [[nodiscard]]
+        mxlFlowReaderWaitStatistics waitStatistics() const
+        {
+            auto result = mxlFlowReaderWaitStatistics{};
+            mxlFlowReaderGetWaitStatistics(_reader, &result);
+            return result;
+        }
+
+    private:
+        void run(std::uint64_t index, std::atomic<std::uint64_t>& acks, std::atomic<bool>& stop)
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                auto info = mxlGrainInfo{};
+                auto payload = static_cast<std::uint8_t*>(nullptr);
+                if (mxlFlowReaderGetGrain(_reader, index, READER_TIMEOUT_NS, &info, &payload) == MXL_STATUS_OK)
+                {
+                    auto const now = mxlGetTime();
+                    auto commitTime = std::uint64_t{};
+                    std::memcpy(&commitTime, payload, sizeof(commitTime));
+                    _latencies.record(now - commitTime);
+
+                    ++index;
+                    acks.fetch_add(1U, std::memory_order_release);
+                }
+            }
+        }
+
+        InstancePtr _instance;
+        mxlFlowReader _reader;
+        LatencyRecorder _latencies;
+        std::thread _thread;
+    };
+
+    //
+    // A video flow writer along with the readers attached to it.
+    //
+    struct GrainHandoff
+    {
+        GrainHandoff(std::size_t readerCount, char const* writerOptions = "")
+            : domain{}
+            , instance{makeInstance(domain)}
+            , writer{nullptr}
+            , acks{0U}
+            , stop{false}
+        {
+            auto const flowDef = makeVideoFlowDef(makeFlowId(0U));
+            auto configInfo = mxlFlowConfigInfo{};
+            if (!instance || (mxlCreateFlowWriter(instance.get(), flowDef.c_str(), writerOptions, &writer, &configInfo, nullptr) != MXL_STATUS_OK))
+            {
+                writer = nullptr;
+                return;
+            }
+
+            nextIndex = mxlGetCurrentIndex(&configInfo.common.grainRate);
+            for (auto i = std::size_t{0}; i < readerCount; ++i)
+            {
+                readers.push_back(std::make_unique<GrainReaderThread>(domain, makeFlowId(0U), nextIndex, acks, stop));
+            }
+        }
+
+        ~GrainHandoff()
+        {
+            stop.store(true, std::memory_order_relaxed);
+            readers.clear();
+            if (writer != nullptr)
+            {
+                mxlReleaseFlowWriter(instance.get(), writer);
+            }
+        }
+
+        [[nodiscard]]
+        bool isValid() const noexcept
+        {
+            return (writer != nullptr) && std::ranges::all_of(readers, [](auto const& reader) { return reader->isValid(); });
+        }
+
+        /// Wait until all readers have acknowledged all grains written so far.
+        void waitForReaders(std::uint64_t expectedAcks) const noexcept
+        {
+            while (acks.load(std::memory_order_acquire) < expectedAcks)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        /// Stop the readers and merge their latency samples.
+        LatencyRecorder finish()
+        {
+            stop.store(true, std::memory_order_relaxed);
+            auto result = LatencyRecorder{};
+            for (auto& reader : readers)
+            {
+                reader->join();
+                result.merge(reader->latencies());
+            }
+            return result;
+        }
+
+        Domain domain;
+        InstancePtr instance;
+        mxlFlowWriter writer;
+        std::uint64_t nextIndex;
+        std::atomic<std::uint64_t> acks;
+        std::atomic<bool> stop;
+        std::vector<std::unique_ptr<GrainReaderThread>> readers;
+    };
+
+    /// Single writer, N readers. Every iteration commits one full grain and waits for all readers to receive it, which yields
+    /// the grain throughput and the distribution of the latency between committing a grain and a reader returning it.
+    void BM_GrainHandoff(benchmark::State& state)
+    {
+        auto const readerCount = static_cast<std::size_t>(state.range(0));
+        auto handoff = GrainHandoff{readerCount};
+        if (!handoff.isValid())
+        {
+            state.SkipWithError("Failed to create the flow writer or readers.");
+            return;
+        }
+
+        auto expectedAcks = std::uint64_t{0};
+        for (auto _ : state)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            if (mxlFlowWriterOpenGrain(handoff.writer, handoff.nextIndex, &info, &payload) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to open grain.");
+                break;
+            }
+
+            auto const commitTime = mxlGetTime();
+            std::memcpy(payload, &commitTime, sizeof(commitTime));
+            info.validSlices = info.totalSlices;
+            mxlFlowWriterCommitGrain(handoff.writer, &info);
+            ++handoff.nextIndex;
+
+            expectedAcks += readerCount;
+            handoff.waitForReaders(expectedAcks);
+        }
+
+        handoff.finish().report(state);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Commits every grain in batches of the specified number of slices, while a reader waits for complete grains. Reports the
+    /// number of times per grain the reader was woken up without being able to make progress.
+    void BM_SlicedCommit(benchmark::State& state)
+    {
+        auto const slicesPerCommit = static_cast<std::uint16_t>(state.range(0));
+        auto handoff = GrainHandoff{1U};
+        if (!handoff.isValid())
+        {
+            state.SkipWithError("Failed to create the flow writer or reader.");
+            return;
+        }
+
+        auto expectedAcks = std::uint64_t{0};
+        for (auto _ : state)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            if (mxlFlowWriterOpenGrain(handoff.writer, handoff.nextIndex, &info, &payload) != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to open grain.");
+                break;
+            }
+
+            auto const commitTime = mxlGetTime();
+            std::memcpy(payload, &commitTime, sizeof(commitTime));
+            for (auto validSlices = std::uint32_t{0}; validSlices < info.totalSlices;)
+            {
+                validSlices = std::min<std::uint32_t>(validSlices + slicesPerCommit, info.totalSlices);
+                info.validSlices = static_cast<std::uint16_t>(validSlices);
+                mxlFlowWriterCommitGrain(handoff.writer, &info);
+            }
+            ++handoff.nextIndex;
+
+            handoff.waitForReaders(++expectedAcks);
+        }
+
+        auto const statistics = handoff.readers.front()->waitStatistics();
+        handoff.finish().report(state);
+        state.SetItemsProcessed(state.iterations());
+        state.counters["wasted_wakeups_per_grain"] = benchmark::Counter(static_cast<double>(statistics.wastedWakeups) /
+                                                                        static_cast<double>(std::max<std::int64_t>(state.iterations(), 1)));
+    }
+
+    /// Measures the time mxlCreateFlowReader() takes to attach to a flow, depending on the number of grains in the flow and on
+    /// the grain storage layout. Every iteration uses a fresh instance, so that no reader is reused from the instance cache.
+    void BM_AttachReader(benchmark::State& state)
+    {
+        constexpr auto grainRate = std::uint32_t{100U};
+        auto const grainCount = static_cast<std::uint64_t>(state.range(0));
+        auto const singleSegment = (state.range(1) != 0);
+
+        auto const historyDurationNs = grainCount * 1'000'000'000U / grainRate;
+        auto const domain = Domain{R"({"urn:x-mxl:option:history_duration/v1.0": )" + std::to_string(historyDurationNs) + "}"};
+        auto const writerInstance = makeInstance(domain);
+        auto const flowId = makeFlowId(0U);
+        auto const flowDef = makeSmallVideoFlowDef(flowId, grainRate);
+        auto const writerOptions = singleSegment ? R"({"discreteFlowLayout": "singleSegment"})" : R"({"discreteFlowLayout": "perGrainFiles"})";
+
+        auto writer = mxlFlowWriter{nullptr};
+        auto configInfo = mxlFlowConfigInfo{};
+        if (!writerInstance || (mxlCreateFlowWriter(writerInstance.get(), flowDef.c_str(), writerOptions, &writer, &configInfo, nullptr) != MXL_STATUS_OK))
+        {
+            state.SkipWithError("Failed to create the flow writer.");
+            return;
+        }
+
+        for (auto _ : state)
+        {
+            auto const readerInstance = makeInstance(domain);
+            auto reader = mxlFlowReader{nullptr};
+
+            auto const start = std::chrono::steady_clock::now();
+            auto const status = mxlCreateFlowReader(readerInstance.get(), flowId.c_str(), "", &reader);
+            auto const end = std::chrono::steady_clock::now();
+            if (status != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to create the flow reader.");
+                break;
+            }
+            state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+            mxlReleaseFlowReader(readerInstance.get(), reader);
+        }
+
+        state.counters["grain_count"] = static_cast<double>(configInfo.discrete.grainCount);
+        mxlReleaseFlowWriter(writerInstance.get(), writer);
+    }
+}
+
+BENCHMARK(BM_GrainHandoff)->ArgName("readers")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_SlicedCommit)->ArgName("slices_per_commit")->Arg(1)->Arg(8)->Arg(64)->Arg(1080)->UseRealTime();
+BENCHMARK(BM_AttachReader)->ArgNames({"grains", "single_segment"})->ArgsProduct({{4, 16, 64, 256}, {0, 1}})->UseManualTime();
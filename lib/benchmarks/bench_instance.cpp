@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    /// Brings up the specified number of 1080p video flows from as many threads at once and tears them down again, as a
+    /// media function with many inputs and outputs does on startup and shutdown. Every thread creates the writer of its flow
+    /// and opens a reader on it, both on the same instance, before releasing them again.
+    void BM_ParallelFlowLifecycle(benchmark::State& state)
+    {
+        auto const flowCount = static_cast<std::size_t>(state.range(0));
+
+        auto const domain = Domain{};
+        auto const instance = makeInstance(domain);
+        if (!instance)
+        {
+            state.SkipWithError("Failed to create the instance.");
+            return;
+        }
+
+        auto flowIds = std::vector<std::string>{};
+        auto flowDefs = std::vector<std::string>{};
+        for (auto i = std::size_t{0}; i < flowCount; ++i)
+        {
+            flowIds.push_back(makeFlowId(i));
+            flowDefs.push_back(makeVideoFlowDef(flowIds.back()));
+        }
+
+        for (auto _ : state)
+        {
+            auto failures = std::atomic<std::size_t>{0};
+            auto threads = std::vector<std::thread>{};
+            for (auto i = std::size_t{0}; i < flowCount; ++i)
+            {
+                threads.emplace_back(
+                    [&, i]()
+                    {
+                        auto writer = mxlFlowWriter{nullptr};
+                        auto reader = mxlFlowReader{nullptr};
+                        auto configInfo = mxlFlowConfigInfo{};
+                        if ((mxlCreateFlowWriter(instance.get(), flowDefs[i].c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+                            (mxlCreateFlowReader(instance.get(), flowIds[i].c_str(), "", &reader) != MXL_STATUS_OK))
+                        {
+                            ++failures;
+                        }
+
+                        if (reader != nullptr)
+                        {
+                            mxlReleaseFlowReader(instance.get(), reader);
+                        }
+                        if (writer != nullptr)
+                        {
+                            mxlReleaseFlowWriter(instance.get(), writer);
+                        }
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (failures != 0U)
+            {
+                state.SkipWithError("Failed to create the flows.");
+                break;
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(flowCount));
+    }
+}
+
+BENCHMARK(BM_ParallelFlowLifecycle)->Arg(1)->Arg(8)->Arg(64)->UseRealTime()->Unit(benchmark::kMillisecond);
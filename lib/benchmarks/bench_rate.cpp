@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/rational.h>
+#include <mxl/time.h>
+
+namespace
+{
+    constexpr auto RATES = std::array{
+        mxlRational{24000, 1001},
+        mxlRational{30000, 1001},
+        mxlRational{60000, 1001},
+        mxlRational{25, 1},
+        mxlRational{50, 1},
+        mxlRational{48'000, 1},
+        mxlRational{96'000, 1},
+        mxlRational{44'100, 1},
+    };
+
+    constexpr auto BATCH_SIZE = std::size_t{1024};
+
+    /// A mix of timestamps around the current time and random ones spread over the whole positive range, so that both the
+    /// common case and the edges of the multiply-shift path are exercised.
+    std::vector<std::uint64_t> makeValues(std::size_t count)
+    {
+        auto rng = std::mt19937_64{0x6d786cU};
+        auto const now = mxlGetTime();
+        auto values = std::vector<std::uint64_t>(count);
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            values[i] = ((i % 2) == 0) ? now + (rng() % 1'000'000'000'000ULL) : (rng() >> (1 + (rng() % 63)));
+        }
+        return values;
+    }
+
+    /// Compares the converter against the division based functions and reports the number of differing results.
+    /// Fails the benchmark if there are any, as they would change which grain or sample a reader gets.
+    bool verifyConverter(benchmark::State& state, mxlRational const& rate, mxlRateConverter const& converter)
+    {
+        auto mismatches = std::uint64_t{0};
+        for (auto const value : makeValues(1U << 20))
+        {
+            mismatches += (mxlRateConverterTimestampToIndex(&converter, value) != mxlTimestampToIndex(&rate, value)) ? 1U : 0U;
+            mismatches += (mxlRateConverterIndexToTimestamp(&converter, value) != mxlIndexToTimestamp(&rate, value)) ? 1U : 0U;
+        }
+
+        state.counters["mismatches"] = static_cast<double>(mismatches);
+        if (mismatches != 0U)
+        {
+            state.SkipWithError("The rate converter disagrees with the division based conversion.");
+            return false;
+        }
+        return true;
+    }
+
+    /// Baseline: mxlTimestampToIndex() divides by the edit rate on every call.
+    void BM_TimestampToIndex(benchmark::State& state)
+    {
+        auto const& rate = RATES[state.range(0)];
+        auto const values = makeValues(BATCH_SIZE);
+        for (auto _ : state)
+        {
+            for (auto const value : values)
+            {
+                benchmark::DoNotOptimize(mxlTimestampToIndex(&rate, value));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+
+    void BM_RateConverterTimestampToIndex(benchmark::State& state)
+    {
+        auto const& rate = RATES[state.range(0)];
+        auto converter = mxlRateConverter{};
+        mxlRateConverterInit(&converter, &rate);
+        if (!verifyConverter(state, rate, converter))
+        {
+            return;
+        }
+
+        auto const values = makeValues(BATCH_SIZE);
+        for (auto _ : state)
+        {
+            for (auto const value : values)
+            {
+                benchmark::DoNotOptimize(mxlRateConverterTimestampToIndex(&converter, value));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+
+    void BM_RateConverterTimestampsToIndices(benchmark::State& state)
+    {
+        auto const& rate = RATES[state.range(0)];
+        auto converter = mxlRateConverter{};
+        mxlRateConverterInit(&converter, &rate);
+        if (!verifyConverter(state, rate, converter))
+        {
+            return;
+        }
+
+        auto const values = makeValues(BATCH_SIZE);
+        auto results = std::vector<std::uint64_t>(BATCH_SIZE);
+        for (auto _ : state)
+        {
+            mxlRateConverterTimestampsToIndices(&converter, values.data(), results.data(), BATCH_SIZE);
+            benchmark::DoNotOptimize(results.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+
+    /// Baseline: mxlIndexToTimestamp() divides by the edit rate on every call.
+    void BM_IndexToTimestamp(benchmark::State& state)
+    {
+        auto const& rate = RATES[state.range(0)];
+        auto const values = makeValues(BATCH_SIZE);
+        for (auto _ : state)
+        {
+            for (auto const value : values)
+            {
+                benchmark::DoNotOptimize(mxlIndexToTimestamp(&rate, value));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+
+    void BM_RateConverterIndicesToTimestamps(benchmark::State& state)
+    {
+        auto const& rate = RATES[state.range(0)];
+        auto converter = mxlRateConverter{};
+        mxlRateConverterInit(&converter, &rate);
+        if (!verifyConverter(state, rate, converter))
+        {
+            return;
+        }
+
+        auto const values = makeValues(BATCH_SIZE);
+        auto results = std::vector<std::uint64_t>(BATCH_SIZE);
+        for (auto _ : state)
+        {
+            mxlRateConverterIndicesToTimestamps(&converter, values.data(), results.data(), BATCH_SIZE);
+            benchmark::DoNotOptimize(results.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+}
+
+BENCHMARK(BM_TimestampToIndex)->ArgName("rate")->DenseRange(0, RATES.size() - 1);
+BENCHMARK(BM_RateConverterTimestampToIndex)->ArgName("rate")->DenseRange(0, RATES.size() - 1);
+BENCHMARK(BM_RateConverterTimestampsToIndices)->ArgName("rate")->DenseRange(0, RATES.size() - 1);
+BENCHMARK(BM_IndexToTimestamp)->ArgName("rate")->DenseRange(0, RATES.size() - 1);
+BENCHMARK(BM_RateConverterIndicesToTimestamps)->ArgName("rate")->DenseRange(0, RATES.size() - 1);
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "Utils.hpp"
+
+namespace
+{
+    using namespace mxl::bench;
+
+    constexpr auto WAIT_TIMEOUT_NS = std::uint64_t{1'000'000'000};
+
+    /// Waits for grains across the specified number of flows, while another thread commits the awaited grain to all of them.
+    /// Reports the latency between starting the commit to the last flow and all grains being available. Waits through a
+    /// synchronization group if useGroup is set, and by blocking on one reader after the other otherwise.
+    void runFanIn(benchmark::State& state, bool useGroup)
+    {
+        auto const flowCount = static_cast<std::size_t>(state.range(0));
+
+        auto const domain = Domain{};
+        auto const writerInstance = makeInstance(domain);
+        auto const readerInstance = makeInstance(domain);
+        if (!writerInstance || !readerInstance)
+        {
+            state.SkipWithError("Failed to create the instances.");
+            return;
+        }
+
+        auto group = mxlFlowSynchronizationGroup{nullptr};
+        if (mxlCreateFlowSynchronizationGroup(readerInstance.get(), &group) != MXL_STATUS_OK)
+        {
+            state.SkipWithError("Failed to create the synchronization group.");
+            return;
+        }
+
+        auto writers = std::vector<mxlFlowWriter>{};
+        auto readers = std::vector<mxlFlowReader>{};
+        auto configInfo = mxlFlowConfigInfo{};
+        for (auto i = std::size_t{0}; i < flowCount; ++i)
+        {
+            auto const flowId = makeFlowId(i);
+            auto const flowDef = makeVideoFlowDef(flowId, 16U);
+            auto writer = mxlFlowWriter{nullptr};
+            auto reader = mxlFlowReader{nullptr};
+            if ((mxlCreateFlowWriter(writerInstance.get(), flowDef.c_str(), "", &writer, &configInfo, nullptr) != MXL_STATUS_OK) ||
+                (mxlCreateFlowReader(readerInstance.get(), flowId.c_str(), "", &reader) != MXL_STATUS_OK) ||
+                (mxlFlowSynchronizationGroupAddReader(group, reader) != MXL_STATUS_OK))
+            {
+                state.SkipWithError("Failed to create the flows.");
+                break;
+            }
+            writers.push_back(writer);
+            readers.push_back(reader);
+        }
+
+        auto const grainRate = configInfo.common.grainRate;
+        auto const firstIndex = mxlGetCurrentIndex(&grainRate);
+
+        // The index the writer thread is asked to commit next, and the time at which it started committing it to the last flow.
+        auto requested = std::atomic<std::uint64_t>{0U};
+        auto commitTime = std::atomic<std::uint64_t>{0U};
+        auto stop = std::atomic<bool>{false};
+        auto writerThread = std::thread{[&]
+            {
+                for (auto index = firstIndex; !stop.load(std::memory_order_relaxed);)
+                {
+                    if (requested.load(std::memory_order_acquire) != index)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    for (auto writer : writers)
+                    {
+                        if (writer == writers.back())
+                        {
+                            commitTime.store(mxlGetTime(), std::memory_order_release);
+                        }
+
+                        auto info = mxlGrainInfo{};
+                        auto payload = static_cast<std::uint8_t*>(nullptr);
+                        if (mxlFlowWriterOpenGrain(writer, index, &info, &payload) == MXL_STATUS_OK)
+                        {
+                            info.validSlices = info.totalSlices;
+                            mxlFlowWriterCommitGrain(writer, &info);
+                        }
+                    }
+                    ++index;
+                }
+            }};
+
+        auto latencies = LatencyRecorder{};
+        auto index = firstIndex;
+        for (auto _ : state)
+        {
+            if (readers.size() != flowCount)
+            {
+                break;
+            }
+
+            requested.store(index, std::memory_order_release);
+            auto status = mxlStatus{MXL_STATUS_OK};
+            if (useGroup)
+            {
+                status = mxlFlowSynchronizationGroupWaitForDataAt(group, mxlIndexToTimestamp(&grainRate, index), WAIT_TIMEOUT_NS);
+            }
+            else
+            {
+                for (auto reader : readers)
+                {
+                    auto info = mxlGrainInfo{};
+                    auto payload = static_cast<std::uint8_t*>(nullptr);
+                    if ((status = mxlFlowReaderGetGrain(reader, index, WAIT_TIMEOUT_NS, &info, &payload)) != MXL_STATUS_OK)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (status != MXL_STATUS_OK)
+            {
+                state.SkipWithError("Failed to wait for data.");
+                break;
+            }
+
+            auto const now = mxlGetTime();
+            latencies.record(now - std::min(now, commitTime.load(std::memory_order_acquire)));
+            ++index;
+        }
+
+        stop.store(true, std::memory_order_relaxed);
+        writerThread.join();
+
+        latencies.report(state);
+        state.SetItemsProcessed(state.iterations());
+
+        mxlReleaseFlowSynchronizationGroup(readerInstance.get(), group);
+        for (auto reader : readers)
+        {
+            mxlReleaseFlowReader(readerInstance.get(), reader);
+        }
+        for (auto writer : writers)
+        {
+            mxlReleaseFlowWriter(writerInstance.get(), writer);
+        }
+    }
+
+    /// Time-to-ready of a synchronization group, which waits on all flows at once where the kernel supports it.
+    void BM_SyncGroupFanIn(benchmark::State& state)
+    {
+        runFanIn(state, true);
+    }
+
+    /// Time-to-ready when waiting on the flows one after the other, for comparison with BM_SyncGroupFanIn.
+    void BM_SequentialFanIn(benchmark::State& state)
+    {
+        runFanIn(state, false);
+    }
+}
+
+BENCHMARK(BM_SyncGroupFanIn)->ArgName("flows")->Arg(1)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+BENCHMARK(BM_SequentialFanIn)->ArgName("flows")->Arg(1)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
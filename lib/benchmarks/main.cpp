@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    constexpr auto DEFAULT_OUT_ARG = "--benchmark_out=mxl-bench.json";
+    constexpr auto DEFAULT_OUT_FORMAT_ARG = "--benchmark_out_format=json";
+}
+
+int main(int argc, char** argv)
+{
+    // Unless told otherwise, store the results as JSON next to the console output, so that runs can be compared with the
+    // compare.py tool of Google Benchmark.
+    auto args = std::vector<char*>{argv, argv + argc};
+    auto const hasOut = std::ranges::any_of(args,
+        [](char const* arg) { return std::string_view{arg}.starts_with("--benchmark_out="); });
+    if (!hasOut)
+    {
+        args.push_back(const_cast<char*>(DEFAULT_OUT_ARG));
+        args.push_back(const_cast<char*>(DEFAULT_OUT_FORMAT_ARG));
+    }
+
+    auto argCount = static_cast<int>(args.size());
+    benchmark::Initialize(&argCount, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argCount, args.data()))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
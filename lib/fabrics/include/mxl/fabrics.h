@@ -280,7 +280,11 @@ extern "C"
      * \param in_initiator A valid fabrics initiator
      * \param in_config The initiator configuration. This will be used to create an endpoint and register a memory region. The memory region
      * corresponds to the one that will be shared with targets.
-     * \param in_options A json-formatted string with additional options
+     * \param in_options An optional json-formatted string with options. May be NULL or empty. Recognized fields:
+     *  - "firstChannel" (number >= 0): the first channel of a continuous flow to transfer. Defaults to 0.
+     *  - "channelCount" (number >= 1): the number of consecutive channels of a continuous flow to transfer, starting at "firstChannel".
+     *    Defaults to all remaining channels. Only the selected channels are read and sent, so the flow of the targets must have exactly
+     *    this many channels. Selecting channels of a discrete flow is an error.
      * \return The result code. \see mxlStatus
      */
     MXL_EXPORT
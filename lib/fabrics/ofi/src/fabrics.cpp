@@ -9,6 +9,7 @@
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <mxl-internal/FlowReader.hpp>
 #include <mxl-internal/Instance.hpp>
 #include <mxl-internal/Logging.hpp>
@@ -31,11 +32,8 @@ namespace mxl::lib::fabrics::ofi
 {
     namespace
     {
-        /// Parse the optional target setup options JSON and return the requested completion
-        /// queue depth, or std::nullopt (use the implementation default) when not specified.
-        ///
-        /// Recognized form: {"cqDepth": <positive integer>}
-        std::optional<std::size_t> parseCqDepthOption(char const* options)
+        /// Parse an optional options JSON string into its top level object, or std::nullopt when no options are given.
+        std::optional<picojson::object> parseOptionsObject(char const* options, std::string_view kind)
         {
             if ((options == nullptr) || (options[0] == '\0'))
             {
@@ -46,25 +44,54 @@ namespace mxl::lib::fabrics::ofi
             auto const err = picojson::parse(value, options);
             if (!err.empty() || !value.is<picojson::object>())
             {
-                throw Exception::invalidArgument("Invalid JSON target options: {}", err.empty() ? std::string{"expected an object"} : err);
+                throw Exception::invalidArgument("Invalid JSON {} options: {}", kind, err.empty() ? std::string{"expected an object"} : err);
             }
 
-            auto const& root = value.get<picojson::object>();
-            auto const it = root.find("cqDepth");
+            return value.get<picojson::object>();
+        }
+
+        /// Return the value of a numeric option that must be greater or equal to \p minimum, or std::nullopt when it is not specified.
+        std::optional<std::size_t> parseCountOption(picojson::object const& root, char const* key, double minimum)
+        {
+            auto const it = root.find(key);
             if (it == root.end())
             {
                 return std::nullopt;
             }
             if (!it->second.is<double>())
             {
-                throw Exception::invalidArgument("cqDepth must be a number.");
+                throw Exception::invalidArgument("{} must be a number.", key);
             }
-            auto const depth = it->second.get<double>();
-            if (depth < 1.0)
+            auto const count = it->second.get<double>();
+            if (count < minimum)
             {
-                throw Exception::invalidArgument("cqDepth must be greater or equal to 1.");
+                throw Exception::invalidArgument("{} must be greater or equal to {}.", key, minimum);
             }
-            return static_cast<std::size_t>(depth);
+            return static_cast<std::size_t>(count);
+        }
+
+        /// Parse the optional target setup options JSON and return the requested completion
+        /// queue depth, or std::nullopt (use the implementation default) when not specified.
+        ///
+        /// Recognized form: {"cqDepth": <positive integer>}
+        std::optional<std::size_t> parseCqDepthOption(char const* options)
+        {
+            auto const root = parseOptionsObject(options, "target");
+            return root ? parseCountOption(*root, "cqDepth", 1.0) : std::nullopt;
+        }
+
+        /// Parse the optional initiator setup options JSON.
+        ///
+        /// Recognized form: {"firstChannel": <integer>, "channelCount": <positive integer>}
+        InitiatorSetupOptions parseInitiatorOptions(char const* options)
+        {
+            auto result = InitiatorSetupOptions{};
+            if (auto const root = parseOptionsObject(options, "initiator"); root)
+            {
+                result.firstChannel = parseCountOption(*root, "firstChannel", 0.0).value_or(0);
+                result.channelCount = parseCountOption(*root, "channelCount", 1.0);
+            }
+            return result;
         }
 
         template<typename F>
@@ -406,7 +433,6 @@ mxlStatus mxlFabricsDestroyInitiator(mxlFabricsInstance in_fabricsInstance, mxlF
 extern "C" MXL_EXPORT
 mxlStatus mxlFabricsInitiatorSetup(mxlFabricsInitiator in_initiator, mxlFabricsInitiatorConfig const* in_config, char const* options)
 {
-    (void)options;
     if ((in_initiator == nullptr) || (in_config == nullptr))
     {
         return MXL_ERR_INVALID_ARG;
@@ -415,7 +441,7 @@ mxlStatus mxlFabricsInitiatorSetup(mxlFabricsInitiator in_initiator, mxlFabricsI
     return ofi::try_run(
         [&]()
         {
-            ofi::InitiatorWrapper::fromAPI(in_initiator)->setup(*in_config);
+            ofi::InitiatorWrapper::fromAPI(in_initiator)->setup(*in_config, ofi::parseInitiatorOptions(options));
 
             return MXL_STATUS_OK;
         },
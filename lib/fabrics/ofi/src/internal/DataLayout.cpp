@@ -42,6 +42,19 @@ namespace mxl::lib::fabrics::ofi
             [this](std::uint32_t lhs, std::uint32_t rhs) { return lhs + (rhs * static_cast<std::uint32_t>(totalSlices)); });
     }
 
+    DataLayout::Continuous DataLayout::Continuous::selectChannels(std::size_t first, std::size_t count) const
+    {
+        if ((count == 0) || (first >= channelCount) || (count > (channelCount - first)))
+        {
+            throw Exception::invalidArgument("Invalid channel range [{}, {}), the flow has {} channels.", first, first + count, channelCount);
+        }
+
+        auto result = *this;
+        result.firstChannel = firstChannel + first;
+        result.channelCount = count;
+        return result;
+    }
+
     DataLayout DataLayout::fromContinuous(std::size_t sampleSize, std::size_t channelCount, std::size_t bufferLength) noexcept
     {
         return DataLayout{
@@ -49,6 +62,11 @@ namespace mxl::lib::fabrics::ofi
         };
     }
 
+    DataLayout DataLayout::fromContinuous(Continuous const& layout) noexcept
+    {
+        return DataLayout{layout};
+    }
+
     bool DataLayout::isDiscrete() const noexcept
     {
         return std::holds_alternative<Discrete>(_inner);
@@ -46,9 +46,18 @@ namespace mxl::lib::fabrics::ofi
          */
         struct Continuous
         {
-            std::size_t sampleSize;   /**< Size of each audio sample in bytes. */
-            std::size_t channelCount; /**< Number of audio channels. */
-            std::size_t bufferLength; /**< The number of samples per channel. */
+            std::size_t sampleSize;       /**< Size of each audio sample in bytes. */
+            std::size_t channelCount;     /**< Number of audio channels. */
+            std::size_t bufferLength;     /**< The number of samples per channel. */
+            std::size_t firstChannel = 0; /**< Index of the first of the channels in the memory region. */
+
+            /** \brief Return a layout that only covers a range of the channels of this layout.
+             * \param first The index of the first channel to cover, relative to the channels of this layout.
+             * \param count The number of consecutive channels to cover.
+             * \throws Exception if the range is empty or exceeds the channels of this layout.
+             */
+            [[nodiscard]]
+            Continuous selectChannels(std::size_t first, std::size_t count) const;
         };
 
     public:
@@ -70,6 +79,13 @@ namespace mxl::lib::fabrics::ofi
         [[nodiscard]]
         static DataLayout fromContinuous(std::size_t sampleSize, std::size_t channelCount, std::size_t bufferLength) noexcept;
 
+        /** \brief Create a DataLayout representing audio data.
+         * \param layout The audio layout.
+         * \return A DataLayout representing the specified audio layout.
+         */
+        [[nodiscard]]
+        static DataLayout fromContinuous(Continuous const& layout) noexcept;
+
         /** \brief Check if the DataLayout is of discrete type.
          * \return true if the DataLayout is of discrete type, false otherwise.
          */
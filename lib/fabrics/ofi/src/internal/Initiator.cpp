@@ -22,7 +22,23 @@ namespace mxl::lib::fabrics::ofi
         return reinterpret_cast<mxlFabricsInitiator>(this);
     }
 
-    void InitiatorWrapper::setup(mxlFabricsInitiatorConfig const& config)
+    DataLayout InitiatorSetupOptions::apply(DataLayout const& layout) const
+    {
+        if (layout.isDiscrete())
+        {
+            if ((firstChannel != 0) || channelCount)
+            {
+                throw Exception::invalidArgument("A channel range can only be selected for continuous flows.");
+            }
+            return layout;
+        }
+
+        auto const& continuous = layout.asContinuous();
+        auto const count = channelCount.value_or((firstChannel < continuous.channelCount) ? (continuous.channelCount - firstChannel) : 0);
+        return DataLayout::fromContinuous(continuous.selectChannels(firstChannel, count));
+    }
+
+    void InitiatorWrapper::setup(mxlFabricsInitiatorConfig const& config, InitiatorSetupOptions const& options)
     {
         if (_inner)
         {
@@ -32,8 +48,8 @@ namespace mxl::lib::fabrics::ofi
         auto const [info, provierConfig] = selectSourceInterface(config.interface, /* target */ false);
         switch (info.view().endpointType())
         {
-            case FI_EP_MSG: _inner = RCInitiator::setup(config, info.view()); break;
-            case FI_EP_RDM: _inner = RDMInitiator::setup(config, info.view()); break;
+            case FI_EP_MSG: _inner = RCInitiator::setup(config, info.view(), options); break;
+            case FI_EP_RDM: _inner = RDMInitiator::setup(config, info.view(), options); break;
             default:        throw Exception::invalidState("unsupported endpoint type");
         }
     }
@@ -5,12 +5,38 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include "DataLayout.hpp"
 #include "Endpoint.hpp"
 #include "TargetInfo.hpp"
 
 namespace mxl::lib::fabrics::ofi
 {
 
+    /** \brief Provider-independent options for initiator setup.
+     *
+     * Groups the optional knobs that influence how an initiator is created so that
+     * new tunables can be added without changing the setup() signatures.
+     */
+    struct InitiatorSetupOptions
+    {
+        /** \brief Index of the first channel of a continuous flow to transfer.
+         */
+        std::size_t firstChannel = 0;
+
+        /** \brief Number of consecutive channels of a continuous flow to transfer.
+         *
+         * When left empty, all channels from firstChannel onwards are transferred.
+         */
+        std::optional<std::size_t> channelCount;
+
+        /** \brief Return the part of the data described by \p layout that the initiator transfers.
+         * \throws Exception if a channel range is selected for a discrete flow, or the range exceeds the channels of the flow.
+         */
+        [[nodiscard]]
+        DataLayout apply(DataLayout const& layout) const;
+    };
+
     /** \brief Abstract base class for Initiator implementations.
      */
     class Initiator
@@ -127,8 +153,9 @@ namespace mxl::lib::fabrics::ofi
          * based on the provided configuration.
          *
          * \param config The configuration to use for setting up the initiator.
+         * \param options Additional options for setting up the initiator.
          */
-        void setup(mxlFabricsInitiatorConfig const& config);
+        void setup(mxlFabricsInitiatorConfig const& config, InitiatorSetupOptions const& options = {});
 
         /** \copydoc Initiator::addTarget()
          */
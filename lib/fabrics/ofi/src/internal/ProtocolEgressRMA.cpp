@@ -225,13 +225,16 @@ namespace mxl::lib::fabrics::ofi
     std::vector<LocalRegion> RMASampleEgressProtocol::makeScatterGatherList(DataLayout::Continuous const& layout, std::uint64_t headIndex,
         std::size_t count, LocalRegion const& region)
     {
+        // Only the selected channels are transferred, so skip the channel buffers in front of them.
+        auto const channelsOffset = layout.firstChannel * layout.sampleSize * layout.bufferLength;
+
         auto slice = mxlMutableWrappedMultiBufferSlice{};
         AudioBounceBuffer::getMutableMultiBufferSlices(headIndex,
             count,
             layout.bufferLength,
             layout.sampleSize,
             layout.channelCount,
-            reinterpret_cast<std::uint8_t*>(region.addr), // NOLINT
+            reinterpret_cast<std::uint8_t*>(region.addr) + channelsOffset, // NOLINT
             slice);
 
         // Double the scatter-gather list length if the second fragment is present.
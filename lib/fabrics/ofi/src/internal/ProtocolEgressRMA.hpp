@@ -117,7 +117,7 @@ namespace mxl::lib::fabrics::ofi
 
         /** \brief Create the scatter-gather list for a given audio region and data layout. This will be used for the remote write transfer. The list
          * will be created based on the head index and count of samples to transfer.
-         * \param layout The audio data layout.
+         * \param layout The audio data layout. Only the channels covered by the layout are transferred.
          * \param headIndex The head index of the audio samples to transfer.
          * \param count The number of samples per channel to transfer.
          * \param region The local region corresponding to the user provided audio region. This is used to calculate the addresses for the
@@ -271,7 +271,8 @@ namespace mxl::lib::fabrics::ofi
         return Idle{.ep = Endpoint::create(old.domain(), old.id(), old.info()), .idleSince = std::chrono::steady_clock::now()};
     }
 
-    std::unique_ptr<RCInitiator> RCInitiator::setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info)
+    std::unique_ptr<RCInitiator> RCInitiator::setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info,
+        InitiatorSetupOptions const& options)
     {
         requireCapability(info, FI_WRITE, "Interface is missing required write capability");
         MXL_DEBUG("{}", fi_tostr(info.raw(), FI_TYPE_INFO));
@@ -283,7 +284,7 @@ namespace mxl::lib::fabrics::ofi
         auto cq = CompletionQueue::open(domain);
 
         auto regions = MxlRegions::forReader(config.reader);
-        auto proto = selectEgressProtocol(regions.dataLayout(), regions.regions());
+        auto proto = selectEgressProtocol(options.apply(regions.dataLayout()), regions.regions());
         proto->registerMemory(domain);
 
         struct MakeUniqueEnabler : RCInitiator
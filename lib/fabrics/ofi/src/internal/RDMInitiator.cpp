@@ -117,7 +117,8 @@ namespace mxl::lib::fabrics::ofi
             _state);
     }
 
-    std::unique_ptr<RDMInitiator> RDMInitiator::setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info)
+    std::unique_ptr<RDMInitiator> RDMInitiator::setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info,
+        InitiatorSetupOptions const& options)
     {
         requireCapability(info, FI_WRITE, "Interface is missing required remote write capability");
 
@@ -147,7 +148,7 @@ namespace mxl::lib::fabrics::ofi
         endpoint.enable();
 
         auto regions = MxlRegions::forReader(config.reader);
-        auto proto = selectEgressProtocol(regions.dataLayout(), regions.regions());
+        auto proto = selectEgressProtocol(options.apply(regions.dataLayout()), regions.regions());
 
         proto->registerMemory(domain);
 
@@ -110,7 +110,8 @@ namespace mxl::lib::fabrics::ofi
         /** \brief Set up a new RDMInitiator.
          */
         [[nodiscard]]
-        static std::unique_ptr<RDMInitiator> setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info);
+        static std::unique_ptr<RDMInitiator> setup(mxlFabricsInitiatorConfig const& config, FabricInfoView info,
+            InitiatorSetupOptions const& options);
 
         /** \copydoc Initiator::addTarget()
          */
@@ -195,9 +195,13 @@ namespace mxl::lib::fabrics::ofi
                 nullptr,
                 Region::Location::host());
 
-            return {std::move(regions),
-                DataLayout::fromContinuous(continuousFlow.sampleWordSize(), continuousFlow.channelCount(), continuousFlow.channelBufferLength()),
-                continuousFlow.flowInfo()->config.common.maxSyncBatchSizeHint};
+            // An interleaved flow is transferred as a single channel of whole frames.
+            auto const layout = (continuousFlow.layout() == ContinuousFlowLayout::Interleaved)
+                                  ? DataLayout::fromContinuous(continuousFlow.sampleStride(), 1U, continuousFlow.channelBufferLength())
+                                  : DataLayout::fromContinuous(
+                                        continuousFlow.sampleWordSize(), continuousFlow.channelCount(), continuousFlow.channelBufferLength());
+
+            return {std::move(regions), layout, continuousFlow.flowInfo()->config.common.maxSyncBatchSizeHint};
         }
         else
         {
@@ -40,6 +40,28 @@ extern "C"
  */
 #define MXL_GRAIN_VALID_SLICES_ALL ((uint16_t)UINT16_MAX)
 
+/**
+ * A flag that may be passed to functions converting samples to an integer sample format, in order to add
+ * triangular (TPDF) dither of +/-1 LSB before quantizing. Only applies to MXL_SAMPLE_FORMAT_S16 and
+ * MXL_SAMPLE_FORMAT_S24, as wider formats already exceed the precision of single precision samples.
+ */
+#define MXL_SAMPLE_CONVERSION_FLAG_DITHER 0x00000001 // 1 << 0.
+
+    /**
+     * Formats in which samples of continuous flows can be exchanged through interleaved buffers.
+     */
+    typedef enum mxlSampleFormat
+    {
+        /** The sample words as they are stored in the flow, i.e. 32 or 64 bit IEEE floats. */
+        MXL_SAMPLE_FORMAT_NATIVE,
+        /** Signed 16 bit integers in native byte order. */
+        MXL_SAMPLE_FORMAT_S16,
+        /** Signed 24 bit integers packed into three bytes, least significant byte first. */
+        MXL_SAMPLE_FORMAT_S24,
+        /** Signed 32 bit integers in native byte order. */
+        MXL_SAMPLE_FORMAT_S32,
+    } mxlSampleFormat;
+
     /**
      * A helper type used to describe consecutive sequences of bytes in memory.
      */
@@ -123,6 +145,70 @@ extern "C"
         size_t count;
     } mxlMutableWrappedMultiBufferSlice;
 
+    /**
+     * A helper type used to describe sequences of equally spaced elements in
+     * consecutive ring buffers separated by the specified stride of bytes,
+     * that may potentially straddle the wraparound point of the buffers. This
+     * generalizes mxlWrappedMultiBufferSlice to buffers whose elements are not
+     * adjacent, such as the channels of a continuous flow that stores its
+     * samples interleaved.
+     */
+    typedef struct mxlStridedWrappedMultiBufferSlice_t
+    {
+        /**
+         * The elements of the first buffer. Each fragment holds
+         * `size / elementStride` elements, the first of which is located at
+         * the beginning of the fragment.
+         */
+        mxlWrappedBufferSlice base;
+
+        /**
+         * The stride in bytes to get from a position in one buffer
+         * to the same position in the following buffer.
+         */
+        size_t stride;
+        /**
+         * The total number of buffers in the sequence.
+         */
+        size_t count;
+        /**
+         * The stride in bytes to get from one element of a buffer to the
+         * next one.
+         */
+        size_t elementStride;
+    } mxlStridedWrappedMultiBufferSlice;
+
+    /**
+     * A helper type used to describe sequences of equally spaced mutable
+     * elements in consecutive ring buffers separated by the specified stride
+     * of bytes, that may potentially straddle the wraparound point of the
+     * buffers.
+     */
+    typedef struct mxlMutableStridedWrappedMultiBufferSlice_t
+    {
+        /**
+         * The elements of the first buffer. Each fragment holds
+         * `size / elementStride` elements, the first of which is located at
+         * the beginning of the fragment.
+         */
+        mxlMutableWrappedBufferSlice base;
+
+        /**
+         * The stride in bytes to get from a position in one buffer
+         * to the same position in the following buffer.
+         */
+        size_t stride;
+        /**
+         * The total number of buffers in the sequence.
+         */
+        size_t count;
+        /**
+         * The stride in bytes to get from one element of a buffer to the
+         * next one.
+         */
+        size_t elementStride;
+    } mxlMutableStridedWrappedMultiBufferSlice;
+
     typedef struct mxlGrainInfo_t
     {
         /// Version of the structure. The only currently supported value is 2
@@ -147,6 +233,50 @@ extern "C"
         uint8_t reserved[4068];
     } mxlGrainInfo;
 
+    /**
+     * The frequently accessed subset of mxlGrainInfo, as returned by mxlFlowReaderGetGrainInfoLite(). Small enough to be
+     * retrieved on every iteration of a polling loop, contrary to the full mxlGrainInfo.
+     */
+    typedef struct mxlGrainInfoLite_t
+    {
+        /// Epoch Grain index used by that ring buffer entry.
+        uint64_t index;
+        /// Grain flags.
+        uint32_t flags;
+        /// Size in bytes of the complete payload of a grain
+        uint32_t grainSize;
+        /// Number of slices that make up a full grain.
+        uint16_t totalSlices;
+        /// How many slices of the grain are currently valid (committed).
+        uint16_t validSlices;
+        /// Padding. Do not use.
+        uint8_t reserved[4];
+    } mxlGrainInfoLite;
+
+    /**
+     * Statistics about the waits performed by the blocking accessors of a flow reader, as returned by
+     * mxlFlowReaderGetWaitStatistics(). All counters are cumulative since the reader was created.
+     */
+    typedef struct mxlFlowReaderWaitStatistics_t
+    {
+        /// Number of blocking reads that had to wait for new data.
+        uint64_t waits;
+        /// Number of waits that observed new data while spinning.
+        uint64_t spinWakeups;
+        /// Number of waits that observed new data after sleeping in the kernel.
+        uint64_t futexWakeups;
+        /// Number of waits that timed out.
+        uint64_t timeouts;
+        /// Number of wake-ups for which a wake-up latency was measured.
+        uint64_t latencySamples;
+        /// Sum of all measured wake-up latencies (time from the writer's commit until the reader noticed it) in nanoseconds.
+        uint64_t totalWakeupLatency;
+        /// Largest measured wake-up latency in nanoseconds.
+        uint64_t maxWakeupLatency;
+        /// Number of wake-ups after which the requested data was still not available, so that the reader had to wait again.
+        uint64_t wastedWakeups;
+    } mxlFlowReaderWaitStatistics;
+
     typedef struct mxlFlowReader_t* mxlFlowReader;
     typedef struct mxlFlowWriter_t* mxlFlowWriter;
 
@@ -198,6 +328,8 @@ extern "C"
      *     If not the null pointer, this structure will be updated with the flow information after the flow is created.
      * \param[out] created (optional) A pointer to a boolean.
      *     If not the null pointer, this variable will be set to true if a new flow was created, and to false if an existing flow was opened instead.
+     * \return The result code. MXL_ERR_INVALID_ARG if the options are malformed, or if they ask for a different 'channelMapping' than the
+     *     existing writer of a continuous flow in this instance was created with. \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlCreateFlowWriter(mxlInstance instance, char const* flowDef, char const* options, mxlFlowWriter* writer,
@@ -206,6 +338,19 @@ extern "C"
     MXL_EXPORT
     mxlStatus mxlReleaseFlowWriter(mxlInstance instance, mxlFlowWriter writer);
 
+    /**
+     * Create a flow reader for an existing flow, or obtain an additional reference to a reader previously created for the same flow by
+     * the same instance.
+     *
+     * \param[in] instance The mxl instance created using mxlCreateInstance
+     * \param[in] flowId The id of the flow to read from.
+     * \param[in] options (optional) A JSON object with reader options, can be NULL. Options are only applied if a new reader is created.
+     *     Supported options are 'waitPolicy' ("futex", "spin" or "adaptive"), which selects how blocking accessors wait for new data, and
+     *     'maxSpinNs', which bounds how long the "spin" and "adaptive" policies spin before going to sleep.
+     * \param[out] reader A pointer to a memory location where the created flow reader will be written.
+     * \return The result code. MXL_ERR_INVALID_ARG if the options are malformed, or if they ask for a different 'channelMapping' than the
+     *     existing reader of a continuous flow was created with. \see mxlStatus
+     */
     MXL_EXPORT
     mxlStatus mxlCreateFlowReader(mxlInstance instance, char const* flowId, char const* options, mxlFlowReader* reader);
 
@@ -278,6 +423,17 @@ extern "C"
     MXL_EXPORT
     mxlStatus mxlFlowReaderGetRuntimeInfo(mxlFlowReader reader, mxlFlowRuntimeInfo* info);
 
+    /**
+     * Get the statistics about the waits performed by the blocking accessors of a flow reader so far, including how long it took the
+     * reader to notice new data after the writer committed it.
+     *
+     * \param[in] reader A valid flow reader
+     * \param[out] statistics A valid pointer to an mxlFlowReaderWaitStatistics structure.
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetWaitStatistics(mxlFlowReader reader, mxlFlowReaderWaitStatistics* statistics);
+
     /**
      * Accessors for a flow grain at a specific index
      * This method is expected to wait until the full grain is available (or the timeout expires). For partial grain access use
@@ -350,6 +506,87 @@ extern "C"
     mxlStatus mxlFlowReaderGetGrainSliceNonBlocking(mxlFlowReader reader, uint64_t index, uint16_t minValidSlices, mxlGrainInfo* grain,
         uint8_t** payload);
 
+    /**
+     * Accessor for a range of consecutive, complete grains starting at a specific index. Waits until the first grain of the range
+     * is available (or the timeout expires), and then returns it along with all directly following grains in the range that are
+     * available at that time, without waiting for them. This amortizes the per-call overhead of mxlFlowReaderGetGrain() for
+     * readers that catch up with a backlog of grains or that need to look ahead.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] firstIndex The index of the first grain to obtain.
+     * \param[in] count The maximum number of grains to obtain. Must be greater than 0.
+     * \param[in] timeoutNs How long should we wait for the first grain (in nanoseconds)
+     * \param[out] grains An array of at least count mxlGrainInfo structures. The first *availableCount elements are set to the
+     *      infos of the obtained grains.
+     * \param[out] payloads An array of at least count payload pointers. The first *availableCount elements are set to the
+     *      payloads of the obtained grains.
+     * \param[out] availableCount The number of leading grains of the range that were obtained. Always set, even on failure.
+     * \return MXL_STATUS_OK if at least the first grain was obtained, otherwise the result code of trying to obtain the first
+     *      grain. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetGrainRange(mxlFlowReader reader, uint64_t firstIndex, size_t count, uint64_t timeoutNs, mxlGrainInfo* grains,
+        uint8_t** payloads, size_t* availableCount);
+
+    /**
+     * Non-blocking accessor for the index, flags, grain size and number of valid slices of a grain at a specific index. Contrary to
+     * the mxlFlowReaderGetGrain*() family of functions, this only copies the handful of bytes that are actually meaningful, and it
+     * returns partial grains regardless of how many of their slices are valid. It does not count as a read access of the flow.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] index The index of the grain to obtain the info of
+     * \param[out] grainInfo A valid pointer to an mxlGrainInfoLite structure. On success it is updated with a consistent snapshot
+     *      of the grain info, even if the writer commits to the grain concurrently.
+     * \return The result code. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetGrainInfoLite(mxlFlowReader reader, uint64_t index, mxlGrainInfoLite* grainInfo);
+
+    /**
+     * Determine whether the grains of a discrete flow are actually backed by huge pages in the address space of the reader. Flows
+     * that were created with the huge pages domain option carry MXL_FLOW_CONFIG_FLAG_HUGE_PAGES, but whether the kernel was able to
+     * honour that depends on the file system of the domain and on the available memory at the time the flow was created.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[out] isHugePageBacked A valid pointer that is set to true if the grains are backed by huge pages.
+     * \return The result code. \see mxlStatus
+     * \note This is a diagnostic function that inspects the memory mappings of the process and is not meant to be called on a hot
+     *      path. It can only be called on readers that operate on discrete flows.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderIsHugePageBacked(mxlFlowReader reader, bool* isHugePageBacked);
+
+    /**
+     * Obtain a pollable file descriptor that becomes readable once data is available at the specified index of a flow, which
+     * allows waiting for flows from within an existing event loop instead of dedicating a thread to blocking reads. Each reader has
+     * a single wait handle. Every call re-arms it for the specified index and resets it to not readable, and returns the same file
+     * descriptor. The wait handles of an instance are signalled by a notifier thread that is started on first use.
+     *
+     * The handle becomes readable once reading at the specified index would no longer fail with MXL_ERR_OUT_OF_RANGE_TOO_EARLY,
+     * i.e. also if the data has already been overwritten or the flow became invalid. Read the data with the non-blocking accessors
+     * of the reader to find out which of these happened.
+     *
+     * \param[in] instance The instance the reader was created on.
+     * \param[in] reader A valid flow reader.
+     * \param[in] index The index of the grain, or of the sample for continuous flows, to wait for.
+     * \param[in] minValidSlices For discrete flows the number of valid slices to wait for, or MXL_GRAIN_VALID_SLICES_ALL to wait
+     *      for complete grains. Ignored for continuous flows.
+     * \param[out] fd A valid pointer that is set to the file descriptor of the wait handle.
+     * \return The result code. \see mxlStatus
+     * \note The file descriptor is owned by the reader and closed once the reader is released. It must not be closed or read
+     *      from by the application.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetWaitHandle(mxlInstance instance, mxlFlowReader reader, uint64_t index, uint16_t minValidSlices, int* fd);
+
     /**
      * Get grain info for a given index. This is used to inspect the grain info without opening the grain for mutation.
      *
@@ -411,8 +648,9 @@ extern "C"
      *      the maximum number of samples a read operation may retrieve from the flow \p reader operates on.
      * \return The result code. \see mxlStatus
      * \note Please note that a read of the specified length is only guaranteed to be possible, if
-     *      1. enough history is available, and
-     *      2. the read is performed at the current head index.
+     *      1. enough history is available,
+     *      2. the read is performed at the current head index, and
+     *      3. the writer does not open batches of more than maxCommitBatchSizeHint samples.
      */
     MXL_EXPORT
     mxlStatus mxlFlowReaderGetMaxReadLengthSamples(mxlFlowReader reader, size_t* maxReadLength);
@@ -432,10 +670,18 @@ extern "C"
      * \return A status code describing the outcome of the call. Please note
      *      that this method will never return MXL_ERR_TIMEOUT, because the
      *      actual error that is being encountered in this case is
-     *      MXL_ERR_OUT_OF_RANGE_TOO_EARLY, even after waiting.
+     *      MXL_ERR_OUT_OF_RANGE_TOO_EARLY, even after waiting. Returns
+     *      MXL_ERR_UNSUPPORTED_OPERATION for flows that store their channels
+     *      interleaved, use mxlFlowReaderGetSamplesStrided() for those.
      * \note No guarantees are made as to how long the caller may
      *      safely hang on to the returned range of samples without the
-     *      risk of these samples being overwritten.
+     *      risk of these samples being overwritten. On flows that reserve a
+     *      single commit batch for the writer, the oldest samples of a window
+     *      of mxlFlowReaderGetMaxReadLengthSamples() samples are overwritten
+     *      as soon as the writer opens its next batch. Callers that process
+     *      the samples in place should request the same range again
+     *      afterwards, and discard their results if that fails with
+     *      MXL_ERR_OUT_OF_RANGE_TOO_LATE.
      */
     MXL_EXPORT
     mxlStatus mxlFlowReaderGetSamples(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs,
@@ -451,15 +697,171 @@ extern "C"
      *      slice that represents the requested range across all channel
      *      buffers.
      *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_UNSUPPORTED_OPERATION for flows that store their channels
+     *      interleaved, use mxlFlowReaderGetSamplesStridedNonBlocking() for
+     *      those.
+     * \note No guarantees are made as to how long the caller may
+     *      safely hang on to the returned range of samples without the
+     *      risk of these samples being overwritten, see
+     *      mxlFlowReaderGetSamples().
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count,
+        mxlWrappedMultiBufferSlice* payloadBuffersSlices);
+
+    /**
+     * Accessor for a specific set of samples across all channels ending at a
+     * specific index (`count` samples up to `index`), which works regardless of
+     * how the flow stores its channels. Behaves like mxlFlowReaderGetSamples(),
+     * except that the samples of a channel are `elementStride` bytes apart.
+     * For flows with one ring buffer per channel this is the size of a
+     * sample, for flows that store their channels interleaved it is the size
+     * of a frame and `stride` is the size of a sample.
+     *
+     * \param[in] index The head index of the samples to obtain.
+     * \param[in] count The number of samples to obtain.
+     * \param[in] timeoutNs How long to wait in nanoseconds for the range of
+     *      samples to become available.
+     * \param[out] payloadBuffersSlices A pointer to a strided wrapped multi
+     *      buffer slice that represents the requested range across all
+     *      channels.
+     *
+     * \return A status code describing the outcome of the call. Please note
+     *      that this method will never return MXL_ERR_TIMEOUT, because the
+     *      actual error that is being encountered in this case is
+     *      MXL_ERR_OUT_OF_RANGE_TOO_EARLY, even after waiting.
+     * \note No guarantees are made as to how long the caller may
+     *      safely hang on to the returned range of samples without the
+     *      risk of these samples being overwritten.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetSamplesStrided(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs,
+        mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices);
+
+    /**
+     * Non-blocking counterpart of mxlFlowReaderGetSamplesStrided().
+     *
+     * \param[in] index The head index of the samples to obtain.
+     * \param[in] count The number of samples to obtain.
+     * \param[out] payloadBuffersSlices A pointer to a strided wrapped multi
+     *      buffer slice that represents the requested range across all
+     *      channels.
+     *
      * \return A status code describing the outcome of the call.
      * \note No guarantees are made as to how long the caller may
      *      safely hang on to the returned range of samples without the
      *      risk of these samples being overwritten.
      */
     MXL_EXPORT
-    mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count,
+    mxlStatus mxlFlowReaderGetSamplesStridedNonBlocking(mxlFlowReader reader, uint64_t index, size_t count,
+        mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices);
+
+    /**
+     * Accessor for a specific set of samples across a range of channels ending
+     * at a specific index (`count` samples up to `index`). Behaves like
+     * mxlFlowReaderGetSamples(), except that the returned slices only cover
+     * the selected channels, so that consumers which are only interested in a
+     * few channels of a flow don't need to skip the others themselves.
+     *
+     * \param[in] index The head index of the samples to obtain.
+     * \param[in] count The number of samples to obtain.
+     * \param[in] firstChannel The index of the first channel to obtain.
+     * \param[in] channelCount The number of consecutive channels to obtain.
+     * \param[in] timeoutNs How long to wait in nanoseconds for the range of
+     *      samples to become available.
+     * \param[out] payloadBuffersSlices A pointer to a wrapped multi buffer
+     *      slice that represents the requested range across the selected
+     *      channel buffers.
+     *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_INVALID_ARG if the selected channels are empty or exceed
+     *      the channels of the flow, and MXL_ERR_UNSUPPORTED_OPERATION for
+     *      flows that store their channels interleaved.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetChannelSamples(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel, size_t channelCount,
+        uint64_t timeoutNs, mxlWrappedMultiBufferSlice* payloadBuffersSlices);
+
+    /**
+     * Non-blocking accessor for a specific set of samples across a range of
+     * channels ending at a specific index (`count` samples up to `index`).
+     *
+     * \param[in] index The head index of the samples to obtain.
+     * \param[in] count The number of samples to obtain.
+     * \param[in] firstChannel The index of the first channel to obtain.
+     * \param[in] channelCount The number of consecutive channels to obtain.
+     * \param[out] payloadBuffersSlices A pointer to a wrapped multi buffer
+     *      slice that represents the requested range across the selected
+     *      channel buffers.
+     *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_INVALID_ARG if the selected channels are empty or exceed
+     *      the channels of the flow, and MXL_ERR_UNSUPPORTED_OPERATION for
+     *      flows that store their channels interleaved.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetChannelSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel, size_t channelCount,
         mxlWrappedMultiBufferSlice* payloadBuffersSlices);
 
+    /**
+     * Copy a specific set of samples across all channels ending at a specific
+     * index (`count` samples up to `index`) into a caller provided buffer, with
+     * the samples of all channels interleaved frame by frame.
+     *
+     * \param[in] index The head index of the samples to copy.
+     * \param[in] count The number of samples per channel to copy.
+     * \param[in] timeoutNs How long to wait in nanoseconds for the range of
+     *      samples to become available.
+     * \param[in] format The format of the samples in \p buffer. Samples are
+     *      scaled such that a native sample of 1.0 corresponds to the full
+     *      scale of an integer format, and clipped to its range.
+     * \param[in] flags A bitwise combination of MXL_SAMPLE_CONVERSION_FLAG_*
+     *      values.
+     * \param[out] buffer The buffer to copy the samples to. Receives
+     *      `count * channelCount` samples in \p format.
+     * \param[in] bufferSize The size of \p buffer in bytes.
+     *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_INVALID_ARG if \p format is not supported for the flow or
+     *      \p buffer is too small to hold the samples.
+     * \note The samples are copied without holding off the writer. If the
+     *      writer started to overwrite some of them in the meantime, the copy
+     *      is discarded and MXL_ERR_OUT_OF_RANGE_TOO_LATE is returned.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderCopySamplesInterleaved(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs, mxlSampleFormat format,
+        uint32_t flags, void* buffer, size_t bufferSize);
+
+    /**
+     * Copy a specific set of samples across a range of channels ending at a
+     * specific index (`count` samples up to `index`) into a caller provided
+     * buffer, with the samples of the selected channels interleaved frame by
+     * frame. Behaves like mxlFlowReaderCopySamplesInterleaved(), except that
+     * only the selected channels are read and copied.
+     *
+     * \param[in] index The head index of the samples to copy.
+     * \param[in] count The number of samples per channel to copy.
+     * \param[in] firstChannel The index of the first channel to copy.
+     * \param[in] channelCount The number of consecutive channels to copy.
+     * \param[in] timeoutNs How long to wait in nanoseconds for the range of
+     *      samples to become available.
+     * \param[in] format The format of the samples in \p buffer.
+     * \param[in] flags A bitwise combination of MXL_SAMPLE_CONVERSION_FLAG_*
+     *      values.
+     * \param[out] buffer The buffer to copy the samples to. Receives
+     *      `count * channelCount` samples in \p format.
+     * \param[in] bufferSize The size of \p buffer in bytes.
+     *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_INVALID_ARG if the selected channels are empty or exceed
+     *      the channels of the flow, \p format is not supported for the flow
+     *      or \p buffer is too small to hold the samples.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderCopyChannelSamplesInterleaved(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel,
+        size_t channelCount, uint64_t timeoutNs, mxlSampleFormat format, uint32_t flags, void* buffer, size_t bufferSize);
+
     /**
      * Return the absolute maximum number of samples a write operation may write to a flow.
      *
@@ -482,11 +884,33 @@ extern "C"
      *      buffer slice that represents the requested range across all channel
      *      buffers.
      *
-     * \return A status code describing the outcome of the call.
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_UNSUPPORTED_OPERATION for flows that store their channels
+     *      interleaved, use mxlFlowWriterOpenSamplesStrided() for those.
      */
     MXL_EXPORT
     mxlStatus mxlFlowWriterOpenSamples(mxlFlowWriter writer, uint64_t index, size_t count, mxlMutableWrappedMultiBufferSlice* payloadBuffersSlices);
 
+    /**
+     * Open a specific set of mutable samples across all channels starting at a
+     * specific index for mutation, which works regardless of how the flow
+     * stores its channels. Behaves like mxlFlowWriterOpenSamples(), except
+     * that the samples of a channel are `elementStride` bytes apart, see
+     * mxlFlowReaderGetSamplesStrided().
+     *
+     * \param[in] index The head index of the samples that will be mutated.
+     * \param[in] count The number of samples in each channel that will be
+     *      mutated.
+     * \param[out] payloadBuffersSlices A pointer to a mutable strided wrapped
+     *      multi buffer slice that represents the requested range across all
+     *      channels.
+     *
+     * \return A status code describing the outcome of the call.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowWriterOpenSamplesStrided(mxlFlowWriter writer, uint64_t index, size_t count,
+        mxlMutableStridedWrappedMultiBufferSlice* payloadBuffersSlices);
+
     /**
      * Cancel the mutation of the previously opened range of samples.
      * \param[in] writer A valid flow writer
@@ -504,6 +928,30 @@ extern "C"
     MXL_EXPORT
     mxlStatus mxlFlowWriterCommitSamples(mxlFlowWriter writer);
 
+    /**
+     * Write a specific set of samples across all channels starting at a
+     * specific index from a buffer, in which the samples of all channels are
+     * interleaved frame by frame, and commit them. This is equivalent to
+     * opening the samples, copying each channel and committing the samples.
+     *
+     * \param[in] index The head index of the samples that will be written.
+     * \param[in] count The number of samples per channel to write.
+     * \param[in] format The format of the samples in \p buffer. Integer
+     *      samples are scaled such that their full scale corresponds to a
+     *      native sample of 1.0.
+     * \param[in] buffer The buffer holding `count * channelCount` samples in
+     *      \p format.
+     * \param[in] bufferSize The size of \p buffer in bytes.
+     *
+     * \return A status code describing the outcome of the call. Returns
+     *      MXL_ERR_INVALID_ARG if \p format is not supported for the flow or
+     *      \p buffer does not hold enough samples, in which case nothing is
+     *      committed.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowWriterWriteSamplesInterleaved(mxlFlowWriter writer, uint64_t index, size_t count, mxlSampleFormat format, void const* buffer,
+        size_t bufferSize);
+
     /**
      * Create a new, empty synchronization group that can be used to synchronize on data availability across multiple flows in parallel.
      * \param[in] instance The instance to which the flow readers handled by this group belong.
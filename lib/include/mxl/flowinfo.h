@@ -23,6 +23,13 @@
  */
 #define MXL_MAX_PLANES_PER_GRAIN 4
 
+/**
+ * Flag of mxlCommonFlowConfigInfo::flags indicating that the grain storage of the flow was sized and advised to be backed by
+ * huge pages. Whether it actually is depends on the file system of the domain and on the available memory.
+ * \see mxlFlowReaderIsHugePageBacked()
+ */
+#define MXL_FLOW_CONFIG_FLAG_HUGE_PAGES 0x00000001U
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -51,7 +58,7 @@ extern "C"
          */
         uint32_t format;
 
-        /** No flags defined yet. */
+        /** A combination of MXL_FLOW_CONFIG_FLAG_* values. */
         uint32_t flags;
 
         /**
@@ -63,8 +70,8 @@ extern "C"
 
         /**
          * The largest expected batch size in samples (for continuous flows) or slices (for discrete flows), in which new data is written to this this
-         * flow by its producer. For continuous flows, this value must be less than half of the buffer length. For discrete flows, this must be
-         * greater or equal to 1.
+         * flow by its producer. For continuous flows, this many samples of the buffer, but at most half of it, are reserved for the batch that is
+         * being written. Flows of flow data version 1 reserve half of the buffer instead. For discrete flows, this must be greater or equal to 1.
          */
         uint32_t maxCommitBatchSizeHint;
 
@@ -85,11 +92,21 @@ extern "C"
          */
         int32_t deviceIndex;
 
+        /**
+         * The time at which the creation of this flow started in nanoseconds since the epoch.
+         */
+        uint64_t creationTime;
+
+        /**
+         * How long it took to create this flow, including the allocation of its grains or channel buffers, in nanoseconds.
+         */
+        uint64_t creationDuration;
+
         /**
          * Reserved space for future extensions, padding the total size of this
          * structure to 128 bytes.
          */
-        uint8_t reserved[72];
+        uint8_t reserved[56];
     } mxlCommonFlowConfigInfo;
 
     /**
@@ -172,11 +189,36 @@ extern "C"
         /** The last time a consumer read from the flow in nanoseconds since the epoch. */
         uint64_t lastReadTime;
 
+        /**
+         * The time at which the producer expects to commit new data next, in
+         * nanoseconds since the epoch, extrapolated from the cadence of its
+         * previous commits. For continuous flows this refers to the next
+         * commit that completes a synchronization batch. 0 until the producer
+         * committed often enough to estimate it. This is a hint only, data
+         * may arrive earlier or later.
+         */
+        uint64_t nextCommitTime;
+
+        /**
+         * Exponentially weighted moving average of the time between two
+         * consecutive commits of the producer in nanoseconds, or 0 if unknown.
+         */
+        uint64_t commitInterval;
+
+        /**
+         * The highest head index that a producer of a continuous flow has
+         * opened for writing so far. The samples up to bufferLength before
+         * this index may be overwritten at any time, including those of a
+         * batch that was opened but not committed yet. 0 if the producer does
+         * not publish it.
+         */
+        uint64_t openHeadIndex;
+
         /**
          * Reserved space for future extensions, padding the total size of this
          * structure to 64 bytes.
          */
-        uint8_t reserved[40];
+        uint8_t reserved[16];
     } mxlFlowRuntimeInfo;
 
     /**
@@ -4,8 +4,10 @@
 #pragma once
 
 #ifdef __cplusplus
+#   include <cstddef>
 #   include <cstdint>
 #else
+#   include <stddef.h>
 #   include <stdint.h>
 #endif
 
@@ -57,6 +59,73 @@ extern "C"
     MXL_EXPORT
     uint64_t mxlIndexToTimestamp(mxlRational const* editRate, uint64_t index);
 
+    /**
+     * Converts between timestamps and indices of a fixed edit rate.
+     *
+     * All constants that do not depend on the converted value are computed once by mxlRateConverterInit(), so that
+     * converting many values at the same edit rate avoids the 128-bit divisions performed by mxlTimestampToIndex() and
+     * mxlIndexToTimestamp(). The results are always identical to the ones of these functions.
+     *
+     * The contents of this structure are private and must only be accessed through the mxlRateConverter* functions.
+     */
+    typedef struct mxlRateConverter_t
+    {
+        uint64_t opaque[24];
+    } mxlRateConverter;
+
+    /**
+     * Initialize a rate converter for the specified edit rate.
+     *
+     * \param[out] converter The converter to initialize.
+     * \param[in] editRate The edit rate of the Flow. If null or invalid, all conversions of the converter yield
+     *      MXL_UNDEFINED_INDEX.
+     */
+    MXL_EXPORT
+    void mxlRateConverterInit(mxlRateConverter* converter, mxlRational const* editRate);
+
+    /**
+     * Equivalent to mxlTimestampToIndex() for the edit rate of the converter.
+     *
+     * \param[in] converter The converter to use.
+     * \param[in] timestamp The time stamp in nanoseconds since the epoch.
+     * \return The index or MXL_UNDEFINED_INDEX if the converter is null or its edit rate is invalid.
+     */
+    MXL_EXPORT
+    uint64_t mxlRateConverterTimestampToIndex(mxlRateConverter const* converter, uint64_t timestamp);
+
+    /**
+     * Equivalent to mxlIndexToTimestamp() for the edit rate of the converter.
+     *
+     * \param[in] converter The converter to use.
+     * \param[in] index The index in the ringbuffer
+     * \return The time stamp in nanoseconds since the epoch or MXL_UNDEFINED_INDEX if the converter is null or its edit
+     *      rate is invalid.
+     */
+    MXL_EXPORT
+    uint64_t mxlRateConverterIndexToTimestamp(mxlRateConverter const* converter, uint64_t index);
+
+    /**
+     * Convert an array of timestamps to indices, as if by calling mxlRateConverterTimestampToIndex() on each of them.
+     *
+     * \param[in] converter The converter to use.
+     * \param[in] timestamps The time stamps in nanoseconds since the epoch.
+     * \param[out] indices Receives the indices. May be the same array as timestamps.
+     * \param[in] count The number of elements in both arrays.
+     */
+    MXL_EXPORT
+    void mxlRateConverterTimestampsToIndices(mxlRateConverter const* converter, uint64_t const* timestamps, uint64_t* indices, size_t count);
+
+    /**
+     * Convert an array of indices to timestamps, as if by calling mxlRateConverterIndexToTimestamp() on each of them.
+     *
+     * \param[in] converter The converter to use.
+     * \param[in] indices The indices in the ringbuffer.
+     * \param[out] timestamps Receives the time stamps in nanoseconds since the epoch. May be the same array as indices.
+     * \param[in] count The number of elements in both arrays.
+     */
+    MXL_EXPORT
+    void mxlRateConverterIndicesToTimestamps(mxlRateConverter const* converter, uint64_t const* indices, uint64_t* timestamps, size_t count);
+
     /**
      * Sleep for a specific amount of time.
      * \param[in] ns How long to sleep for, in nanoseconds.
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include "FlowData.hpp"
 
 namespace mxl::lib
@@ -20,6 +21,21 @@ namespace mxl::lib
         constexpr std::size_t sampleWordSize() const noexcept;
         constexpr std::size_t channelBufferLength() const noexcept;
 
+        /** How the samples of the flow are stored. */
+        constexpr ContinuousFlowLayout layout() const noexcept;
+
+        /**
+         * The largest window of samples that readers and writers may access at
+         * once. The most recent commit batch worth of samples of each channel
+         * buffer is reserved for the batch that the writer is working on, but
+         * never more than half of the buffer, which is what flows used to
+         * reserve. Flows of FLOW_DATA_VERSION reserve half of the buffer, as
+         * they may be shared with readers of SDK versions that don't know
+         * about openHeadIndex and expect the writer to stay within half of the
+         * buffer ahead of the head.
+         */
+        constexpr std::size_t maxAccessLength() const noexcept;
+
         void openChannelBuffers(char const* channelBuffersFilePath, std::size_t sampleWordSize);
 
         /** The size of the mapped channel data in bytes. */
@@ -31,8 +47,35 @@ namespace mxl::lib
         constexpr void* channelData() noexcept;
         constexpr void const* channelData() const noexcept;
 
+        /**
+         * Additionally map every channel buffer, or the single buffer of an
+         * interleaved flow, twice, back to back, so that channelRings() is
+         * contiguous across the end of each buffer.
+         * \return false if the channel buffers can't be mirrored, because their
+         *      size is not a multiple of the page size, in which case
+         *      channelRings() keeps referring to the channel data.
+         */
+        bool mirrorChannelBuffers();
+
+        /** Whether the channel buffers have been mirrored. */
+        constexpr bool channelRingsMirrored() const noexcept;
+
+        /**
+         * The channel buffers to access samples through, which is either the
+         * channel data or its mirrored mapping.
+         */
+        constexpr void* channelRings() noexcept;
+        constexpr void const* channelRings() const noexcept;
+
+        /** The distance in bytes between two consecutive channels in channelRings(). */
+        constexpr std::size_t channelRingStride() const noexcept;
+
+        /** The distance in bytes between two consecutive samples of a channel in channelRings(). */
+        constexpr std::size_t sampleStride() const noexcept;
+
     private:
         SharedMemorySegment _channelBuffers;
+        MirroredMapping _mirroredChannelBuffers;
         std::size_t _sampleWordSize;
     };
 
@@ -43,12 +86,14 @@ namespace mxl::lib
     inline ContinuousFlowData::ContinuousFlowData(SharedMemoryInstance<Flow>&& flowSegement) noexcept
         : FlowData{std::move(flowSegement)}
         , _channelBuffers{}
+        , _mirroredChannelBuffers{}
         , _sampleWordSize{1U}
     {}
 
     inline ContinuousFlowData::ContinuousFlowData(char const* flowFilePath, AccessMode mode, LockMode lockMode)
         : FlowData{flowFilePath, mode, lockMode}
         , _channelBuffers{}
+        , _mirroredChannelBuffers{}
         , _sampleWordSize{1U}
     {}
 
@@ -64,6 +109,30 @@ namespace mxl::lib
         return (info != nullptr) ? info->config.continuous.bufferLength : 0U;
     }
 
+    constexpr ContinuousFlowLayout ContinuousFlowData::layout() const noexcept
+    {
+        auto const info = flowInfo();
+        return ((info != nullptr) && (info->version == FLOW_DATA_VERSION_INTERLEAVED)) ? ContinuousFlowLayout::Interleaved
+                                                                                        : ContinuousFlowLayout::Planar;
+    }
+
+    constexpr std::size_t ContinuousFlowData::maxAccessLength() const noexcept
+    {
+        auto const info = flowInfo();
+        if (info != nullptr)
+        {
+            auto const bufferLength = std::size_t{info->config.continuous.bufferLength};
+            if (info->version == FLOW_DATA_VERSION)
+            {
+                return bufferLength / 2U;
+            }
+
+            auto const commitBatchSize = std::max(std::size_t{info->config.common.maxCommitBatchSizeHint}, std::size_t{1U});
+            return bufferLength - std::min(commitBatchSize, bufferLength / 2U);
+        }
+        return 0U;
+    }
+
     constexpr std::size_t ContinuousFlowData::sampleWordSize() const noexcept
     {
         return _sampleWordSize;
@@ -114,4 +183,49 @@ namespace mxl::lib
     {
         return _channelBuffers.data();
     }
+
+    inline bool ContinuousFlowData::mirrorChannelBuffers()
+    {
+        // Interleaved channels share a single ring buffer.
+        auto const interleaved = (layout() == ContinuousFlowLayout::Interleaved);
+        auto const ringSize = channelBufferLength() * _sampleWordSize * (interleaved ? channelCount() : 1U);
+        if (!_mirroredChannelBuffers.isValid())
+        {
+            if ((ringSize == 0U) || ((ringSize % pageSize()) != 0U))
+            {
+                return false;
+            }
+            _mirroredChannelBuffers = _channelBuffers.mapMirrored(ringSize, interleaved ? 1U : channelCount());
+        }
+        return true;
+    }
+
+    constexpr bool ContinuousFlowData::channelRingsMirrored() const noexcept
+    {
+        return _mirroredChannelBuffers.isValid();
+    }
+
+    constexpr void* ContinuousFlowData::channelRings() noexcept
+    {
+        return _mirroredChannelBuffers.isValid() ? _mirroredChannelBuffers.data() : _channelBuffers.data();
+    }
+
+    constexpr void const* ContinuousFlowData::channelRings() const noexcept
+    {
+        return _mirroredChannelBuffers.isValid() ? _mirroredChannelBuffers.data() : _channelBuffers.data();
+    }
+
+    constexpr std::size_t ContinuousFlowData::channelRingStride() const noexcept
+    {
+        if (layout() == ContinuousFlowLayout::Interleaved)
+        {
+            return _sampleWordSize;
+        }
+        return _mirroredChannelBuffers.isValid() ? _mirroredChannelBuffers.ringStride() : (channelBufferLength() * _sampleWordSize);
+    }
+
+    constexpr std::size_t ContinuousFlowData::sampleStride() const noexcept
+    {
+        return (layout() == ContinuousFlowLayout::Interleaved) ? (channelCount() * _sampleWordSize) : _sampleWordSize;
+    }
 }
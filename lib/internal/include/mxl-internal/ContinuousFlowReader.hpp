@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <utility>
 #include "FlowReader.hpp"
 #include "Timing.hpp"
 
@@ -11,6 +12,13 @@ namespace mxl::lib
     class MXL_EXPORT ContinuousFlowReader : public FlowReader
     {
     public:
+        /**
+         * Return how the samples of the flow are stored, which is fixed for
+         * the lifetime of the flow.
+         */
+        [[nodiscard]]
+        ContinuousFlowLayout getLayout() const noexcept;
+
         /**
          * Return the maximum number of samples that can be retrieved by a read
          * operation in one go.
@@ -38,6 +46,17 @@ namespace mxl::lib
          */
         virtual mxlStatus waitForSamples(std::uint64_t index, Timepoint deadline) const = 0;
 
+        /**
+         * Non-blocking counterpart of waitForSamples(). Checks whether the
+         * sample at the specified index is available, and whether the flow
+         * is still valid if it isn't.
+         *
+         * \param[in] index The index of the sample to check for.
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        virtual mxlStatus pollSamples(std::uint64_t index) const = 0;
+
         /**
          * Accessor for a specific set of samples across all channels
          * ending at a specific index (`count` samples up to `index`).
@@ -46,9 +65,9 @@ namespace mxl::lib
          * \param[in] count The number of samples to obtain.
          * \param[in] deadline The point in time of Clock::Realtime at which to
          *      stop waiting.
-         * \param[out] payloadBuffersSlices A reference to a wrapped multi
-         *      buffer slice that represents the requested range across all
-         *      channel buffers
+         * \param[out] payloadBuffersSlices A reference to a strided wrapped
+         *      multi buffer slice that represents the requested range across
+         *      all channels
          *
          * \return A status code describing the outcome of the call. Please note
          *      that this method will never return MXL_ERR_TIMEOUT, because the
@@ -58,7 +77,8 @@ namespace mxl::lib
          *      safely hang on to the returned range of samples without the
          *      risk of these samples being overwritten.
          */
-        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, Timepoint deadline, mxlWrappedMultiBufferSlice& payloadBufferSlices) = 0;
+        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, Timepoint deadline,
+            mxlStridedWrappedMultiBufferSlice& payloadBufferSlices) = 0;
 
         /**
          * Non-blocking accessor for a specific set of samples across all
@@ -66,18 +86,41 @@ namespace mxl::lib
          *
          * \param[in] index The starting index of the samples to obtain.
          * \param[in] count The number of samples to obtain.
-         * \param[out] payloadBuffersSlices A reference to a wrapped multi
-         *      buffer slice that represents the requested range across all
-         *      channel buffers
+         * \param[out] payloadBuffersSlices A reference to a strided wrapped
+         *      multi buffer slice that represents the requested range across
+         *      all channels
          *
          * \return A status code describing the outcome of the call.
          * \note No guarantees are made as to how long the caller may
          *      safely hang on to the returned range of samples without the
          *      risk of these samples being overwritten.
          */
-        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, mxlWrappedMultiBufferSlice& payloadBufferSlices) = 0;
+        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, mxlStridedWrappedMultiBufferSlice& payloadBufferSlices) = 0;
 
     protected:
-        using FlowReader::FlowReader;
+        ContinuousFlowReader(ContinuousFlowLayout layout, uuids::uuid&& flowId, std::filesystem::path const& domain);
+        ContinuousFlowReader(ContinuousFlowLayout layout, uuids::uuid const& flowId, std::filesystem::path const& domain);
+
+    private:
+        ContinuousFlowLayout _layout;
     };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline ContinuousFlowReader::ContinuousFlowReader(ContinuousFlowLayout layout, uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : FlowReader{FlowKind::Continuous, std::move(flowId), domain}
+        , _layout{layout}
+    {}
+
+    inline ContinuousFlowReader::ContinuousFlowReader(ContinuousFlowLayout layout, uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : FlowReader{FlowKind::Continuous, flowId, domain}
+        , _layout{layout}
+    {}
+
+    inline ContinuousFlowLayout ContinuousFlowReader::getLayout() const noexcept
+    {
+        return _layout;
+    }
 }
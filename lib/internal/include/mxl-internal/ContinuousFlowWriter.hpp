@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <utility>
 #include "FlowWriter.hpp"
 
 namespace mxl::lib
@@ -10,6 +11,13 @@ namespace mxl::lib
     class MXL_EXPORT ContinuousFlowWriter : public FlowWriter
     {
     public:
+        /**
+         * Return how the samples of the flow are stored, which is fixed for
+         * the lifetime of the flow.
+         */
+        [[nodiscard]]
+        ContinuousFlowLayout getLayout() const noexcept;
+
         /**
          * Return the maximum number of samples a write operation can write in
          * one go.
@@ -26,19 +34,42 @@ namespace mxl::lib
          *
          * \param[in] index The starting index of the samples to obtain.
          * \param[in] count The number of samples to obtain.
-         * \param[out] payloadBuffersSlices A reference to a mutable
+         * \param[out] payloadBuffersSlices A reference to a mutable strided
          *      wrapped multi buffer slice that represents the requested
-         *      range across all channel buffers
+         *      range across all channels
          *
          * \return A status code describing the outcome of the call.
          */
-        virtual mxlStatus openSamples(std::uint64_t index, std::size_t count, mxlMutableWrappedMultiBufferSlice& payloadBufferSlices) = 0;
+        virtual mxlStatus openSamples(std::uint64_t index, std::size_t count, mxlMutableStridedWrappedMultiBufferSlice& payloadBufferSlices) = 0;
 
         virtual mxlStatus commit() = 0;
 
         virtual mxlStatus cancel() = 0;
 
     protected:
-        using FlowWriter::FlowWriter;
+        ContinuousFlowWriter(ContinuousFlowLayout layout, uuids::uuid&& flowId, std::filesystem::path const& domain);
+        ContinuousFlowWriter(ContinuousFlowLayout layout, uuids::uuid const& flowId, std::filesystem::path const& domain);
+
+    private:
+        ContinuousFlowLayout _layout;
     };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline ContinuousFlowWriter::ContinuousFlowWriter(ContinuousFlowLayout layout, uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : FlowWriter{FlowKind::Continuous, std::move(flowId), domain}
+        , _layout{layout}
+    {}
+
+    inline ContinuousFlowWriter::ContinuousFlowWriter(ContinuousFlowLayout layout, uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : FlowWriter{FlowKind::Continuous, flowId, domain}
+        , _layout{layout}
+    {}
+
+    inline ContinuousFlowLayout ContinuousFlowWriter::getLayout() const noexcept
+    {
+        return _layout;
+    }
 }
@@ -3,10 +3,22 @@
 
 #pragma once
 
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <fmt/format.h>
 #include "Flow.hpp"
 #include "FlowData.hpp"
+#include "PathUtils.hpp"
+#include "ReaderHeartbeats.hpp"
+#include "Thread.hpp"
 
 namespace mxl::lib
 {
@@ -21,8 +33,92 @@ namespace mxl::lib
 
         std::size_t grainCount() const noexcept;
 
-        Grain* emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize);
+        /** Return how the grains of this flow are stored. */
+        DiscreteFlowLayout layout() const noexcept;
 
+        /**
+         * Create or open the shared memory file of a single grain and append it to the grains of this flow.
+         * Only used for flows using the DiscreteFlowLayout::PerGrainFiles layout.
+         *
+         * \param[in] grainFilePath The path of the grain file.
+         * \param[in] grainPayloadSize The payload size of the grain. With PageMode::Huge the file is enlarged to a multiple of the
+         *      huge page size. Ignored when opening an existing grain.
+         * \param[in] pageMode The kind of pages the grain should preferably be backed with.
+         */
+        Grain* emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize, PageMode pageMode = PageMode::Default);
+
+        /**
+         * Create the shared memory files of all grains of a newly created flow, spreading the work across up to maxThreads threads.
+         * Only used for flows using the DiscreteFlowLayout::PerGrainFiles layout.
+         *
+         * \param[in] grainFilePaths The paths of the grain files, in the order of the grains.
+         * \param[in] grainPayloadSize The payload size of each grain, padded as described for emplaceGrain().
+         * \param[in] pageMode The kind of pages the grains should preferably be backed with.
+         * \param[in] maxThreads The maximum number of threads to create the files with.
+         */
+        void createGrainFiles(std::vector<std::string> const& grainFilePaths, std::size_t grainPayloadSize, PageMode pageMode,
+            std::size_t maxThreads);
+
+        /**
+         * Map all pages of the grain storage of this flow into the address space of this process, so that the first access to each
+         * grain doesn't fault. The storage is split into chunks that are prefaulted by up to maxThreads threads.
+         */
+        void prefaultGrains(std::size_t maxThreads);
+
+        /**
+         * Defer mapping the grain files of this flow until they are first accessed through grainAt(), instead of opening them all up
+         * front with emplaceGrain(). Mapping a grain is thread safe. Only used when opening flows that use the
+         * DiscreteFlowLayout::PerGrainFiles layout.
+         *
+         * \param[in] grainDirectory The directory holding the grain files.
+         * \param[in] pageMode The kind of pages the grains should preferably be backed with.
+         */
+        void openGrainsLazily(std::filesystem::path const& grainDirectory, PageMode pageMode);
+
+        /** Return how many grains are currently mapped into the address space of this process. */
+        std::size_t mappedGrainCount() const noexcept;
+
+        /**
+         * Create or open the single shared memory segment holding all grains of this flow.
+         * Only used for flows using the DiscreteFlowLayout::SingleSegment layout.
+         *
+         * \param[in] grainSegmentFilePath The path of the grain segment file.
+         * \param[in] grainPayloadSize The payload size of each grain. Ignored when opening an existing segment, in which case it is
+         *      derived from the first grain header.
+         * \param[in] pageMode The kind of pages the segment should preferably be backed with.
+         * \throws std::invalid_argument If the segment is too small for the configured grain count, or a grain header has an
+         *      unsupported version.
+         */
+        void openGrainSegment(char const* grainSegmentFilePath, std::size_t grainPayloadSize, PageMode pageMode = PageMode::Default);
+
+        /**
+         * Create or open the reader heartbeat segment of this flow. The segment is always mapped writable, even if the flow itself
+         * was opened read-only, because readers store their heartbeats in it.
+         *
+         * \param[in] heartbeatsFilePath The path of the heartbeats file.
+         * \throws std::system_error If the segment could not be created or opened for writing.
+         * \throws std::invalid_argument If the segment has an unsupported version.
+         */
+        void openReaderHeartbeats(char const* heartbeatsFilePath);
+
+        /** Return the reader heartbeats of this flow, or the null pointer if the flow does not use reader heartbeats. */
+        ReaderHeartbeats* readerHeartbeats() noexcept;
+        ReaderHeartbeats const* readerHeartbeats() const noexcept;
+
+        /**
+         * Return a copy of the info of this flow, with the heartbeats of its readers folded into the last read time. The writer only
+         * stores them in the flow when it commits, so this keeps the last read time current while the writer is idle.
+         */
+        mxlFlowInfo flowInfoWithReaderHeartbeats() const noexcept;
+
+        /** Return whether the grain storage of this flow is backed by huge pages, judging by the first grain. */
+        [[nodiscard]]
+        bool isHugePageBacked() const;
+
+        /**
+         * Return the grain at the specified offset, or the null pointer if the offset is out of range. If the grains are mapped lazily,
+         * the grain is mapped if necessary, in which case the null pointer is also returned if mapping it failed.
+         */
         Grain* grainAt(std::size_t i) noexcept;
         Grain const* grainAt(std::size_t i) const noexcept;
 
@@ -30,7 +126,49 @@ namespace mxl::lib
         mxlGrainInfo const* grainInfoAt(std::size_t i) const noexcept;
 
     private:
-        std::vector<SharedMemoryInstance<Grain>> _grains;
+        /**
+         * The state of lazily mapped grains, see openGrainsLazily(). Grains stay mapped for the lifetime of the flow data once they
+         * were accessed, because callers hold on to pointers into them without telling us when they are done.
+         */
+        struct LazyGrains
+        {
+            LazyGrains(std::filesystem::path const& directory, PageMode pageMode, std::size_t grainCount);
+
+            /** The directory holding the grain files. */
+            std::filesystem::path directory;
+            /** The kind of pages the grains should preferably be backed with. */
+            PageMode pageMode;
+            /** Serializes mapping grains. */
+            std::mutex mutex;
+            /** The mapped grains, or the null pointer for grains that are not mapped. Read without holding the mutex. */
+            std::vector<std::atomic<Grain*>> grains;
+            /** The grain files backing the mapped grains. Protected by the mutex. */
+            std::vector<SharedMemoryInstance<Grain>> files;
+            /** The number of grains currently mapped. Protected by the mutex. */
+            std::size_t mapped;
+        };
+
+    private:
+        /** Return the payload size of a grain file that is about to be created, padded as described for emplaceGrain(). */
+        static std::size_t grainFilePayloadSize(std::size_t grainPayloadSize, PageMode pageMode) noexcept;
+
+        /** Return the lazily mapped grain at the specified offset, mapping it if necessary. */
+        Grain* lazyGrainAt(std::size_t i) const noexcept;
+
+        /** Map the lazily mapped grain at the specified offset. Must be called with the mutex of the lazy grains held. */
+        Grain* mapLazyGrain(std::size_t i) const;
+
+    private:
+        /** The individually mapped grain files (DiscreteFlowLayout::PerGrainFiles). */
+        std::vector<SharedMemoryInstance<Grain>> _grainFiles;
+        /** The segment holding all grains (DiscreteFlowLayout::SingleSegment). */
+        SharedMemorySegment _grainSegment;
+        /** Pointers to the grains, regardless of how they are stored. */
+        std::vector<Grain*> _grains;
+        /** The reader heartbeats, if the flow uses them. */
+        SharedMemoryInstance<ReaderHeartbeats> _readerHeartbeats;
+        /** The lazily mapped grains, if the grains are mapped on first access (DiscreteFlowLayout::PerGrainFiles). */
+        std::unique_ptr<LazyGrains> _lazyGrains;
     };
 
     /**************************************************************************/
@@ -39,27 +177,44 @@ namespace mxl::lib
 
     inline DiscreteFlowData::DiscreteFlowData(SharedMemoryInstance<Flow>&& flowSegement) noexcept
         : FlowData{std::move(flowSegement)}
+        , _grainFiles{}
+        , _grainSegment{}
         , _grains{}
+        , _readerHeartbeats{}
+        , _lazyGrains{}
     {
         _grains.reserve(flowInfo()->config.discrete.grainCount);
     }
 
     inline DiscreteFlowData::DiscreteFlowData(char const* flowFilePath, AccessMode mode, LockMode lockMode)
         : FlowData{flowFilePath, mode, lockMode}
+        , _grainFiles{}
+        , _grainSegment{}
         , _grains{}
+        , _readerHeartbeats{}
+        , _lazyGrains{}
     {
         _grains.reserve(flowInfo()->config.discrete.grainCount);
     }
 
     inline std::size_t DiscreteFlowData::grainCount() const noexcept
     {
-        return _grains.size();
+        return _lazyGrains ? _lazyGrains->grains.size() : _grains.size();
     }
 
-    inline Grain* DiscreteFlowData::emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize)
+    inline DiscreteFlowLayout DiscreteFlowData::layout() const noexcept
+    {
+        return _grainSegment.isValid() ? DiscreteFlowLayout::SingleSegment : DiscreteFlowLayout::PerGrainFiles;
+    }
+
+    inline Grain* DiscreteFlowData::emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize, PageMode pageMode)
     {
         auto const mode = this->created() ? AccessMode::CREATE_READ_WRITE : this->accessMode();
-        auto grain = SharedMemoryInstance<Grain>{grainFilePath, mode, grainPayloadSize, LockMode::Shared};
+        if (this->created())
+        {
+            grainPayloadSize = grainFilePayloadSize(grainPayloadSize, pageMode);
+        }
+        auto grain = SharedMemoryInstance<Grain>{grainFilePath, mode, grainPayloadSize, LockMode::Shared, pageMode};
 
         if (!this->created())
         {
@@ -71,17 +226,272 @@ namespace mxl::lib
             }
         }
 
-        return _grains.emplace_back(std::move(grain)).get();
+        return _grains.emplace_back(_grainFiles.emplace_back(std::move(grain)).get());
+    }
+
+    inline void DiscreteFlowData::createGrainFiles(std::vector<std::string> const& grainFilePaths, std::size_t grainPayloadSize,
+        PageMode pageMode, std::size_t maxThreads)
+    {
+        auto const payloadSize = grainFilePayloadSize(grainPayloadSize, pageMode);
+
+        // Each file is allocated by its own posix_fallocate() call, which only serializes on the inode of that file, so the
+        // allocations scale with the number of threads.
+        auto grainFiles = std::vector<SharedMemoryInstance<Grain>>(grainFilePaths.size());
+        parallelFor(grainFiles.size(),
+            maxThreads,
+            [&](std::size_t i)
+            {
+                grainFiles[i] = SharedMemoryInstance<Grain>{
+                    grainFilePaths[i].c_str(), AccessMode::CREATE_READ_WRITE, payloadSize, LockMode::Shared, pageMode};
+            });
+
+        _grainFiles.reserve(_grainFiles.size() + grainFiles.size());
+        for (auto& grainFile : grainFiles)
+        {
+            _grains.emplace_back(_grainFiles.emplace_back(std::move(grainFile)).get());
+        }
+    }
+
+    inline void DiscreteFlowData::prefaultGrains(std::size_t maxThreads)
+    {
+        if (_grainSegment.isValid())
+        {
+            // Populating a range only holds the mmap lock for reading, so chunks of the same mapping can be populated in parallel.
+            constexpr auto chunkSize = std::size_t{8U * 1024U * 1024U};
+            auto const chunkCount = (_grainSegment.mappedSize() + chunkSize - 1U) / chunkSize;
+            parallelFor(chunkCount, maxThreads, [&](std::size_t i) { _grainSegment.prefault(i * chunkSize, chunkSize); });
+        }
+        else
+        {
+            parallelFor(_grainFiles.size(), maxThreads, [&](std::size_t i) { _grainFiles[i].prefault(0U, _grainFiles[i].mappedSize()); });
+        }
+    }
+
+    inline DiscreteFlowData::LazyGrains::LazyGrains(std::filesystem::path const& directory, PageMode pageMode, std::size_t grainCount)
+        : directory{directory}
+        , pageMode{pageMode}
+        , mutex{}
+        , grains(grainCount)
+        , files(grainCount)
+        , mapped{0U}
+    {}
+
+    inline void DiscreteFlowData::openGrainsLazily(std::filesystem::path const& grainDirectory, PageMode pageMode)
+    {
+        _lazyGrains = std::make_unique<LazyGrains>(grainDirectory, pageMode, flowInfo()->config.discrete.grainCount);
+    }
+
+    inline std::size_t DiscreteFlowData::mappedGrainCount() const noexcept
+    {
+        if (_lazyGrains)
+        {
+            auto const lock = std::lock_guard{_lazyGrains->mutex};
+            return _lazyGrains->mapped;
+        }
+        return _grains.size();
+    }
+
+    inline Grain* DiscreteFlowData::lazyGrainAt(std::size_t i) const noexcept
+    {
+        auto& lazy = *_lazyGrains;
+        if (i >= lazy.grains.size())
+        {
+            return nullptr;
+        }
+
+        // Grains that are already mapped are handed out without taking the lock.
+        if (auto const grain = lazy.grains[i].load(std::memory_order_acquire); grain != nullptr)
+        {
+            return grain;
+        }
+
+        try
+        {
+            auto const lock = std::lock_guard{lazy.mutex};
+            return mapLazyGrain(i);
+        }
+        catch (std::exception const&)
+        {
+            // The grain file may have been removed along with the flow. Callers treat this like any other missing grain.
+            return nullptr;
+        }
+    }
+
+    inline Grain* DiscreteFlowData::mapLazyGrain(std::size_t i) const
+    {
+        auto& lazy = *_lazyGrains;
+
+        // Another thread may have mapped the grain while we were waiting for the lock.
+        if (auto const grain = lazy.grains[i].load(std::memory_order_relaxed); grain != nullptr)
+        {
+            return grain;
+        }
+
+        auto const grainPath = makeGrainDataFilePath(lazy.directory, static_cast<unsigned int>(i)).string();
+        auto file = SharedMemoryInstance<Grain>{grainPath.c_str(), this->accessMode(), 0U, LockMode::Shared, lazy.pageMode};
+
+        // Check for the version of the grain data structure in the memory that was just mapped.
+        if (file.get()->header.info.version != GRAIN_HEADER_VERSION)
+        {
+            throw std::invalid_argument{
+                fmt::format("Unsupported grain version: {}, supported version is: {}", file.get()->header.info.version, GRAIN_HEADER_VERSION)};
+        }
+
+        auto const grain = file.get();
+        lazy.files[i] = std::move(file);
+        lazy.mapped += 1U;
+        lazy.grains[i].store(grain, std::memory_order_release);
+        return grain;
+    }
+
+    inline std::size_t DiscreteFlowData::grainFilePayloadSize(std::size_t grainPayloadSize, PageMode pageMode) noexcept
+    {
+        if ((pageMode == PageMode::Huge) && ((sizeof(Grain) + grainPayloadSize) >= hugePageSize()))
+        {
+            // Only a file size that is a multiple of the huge page size allows the tail of the grain to be backed by a huge page
+            // as well. Grains smaller than a single huge page are left alone, because padding them would waste more memory than
+            // huge pages could ever save.
+            return roundUpToHugePageSize(sizeof(Grain) + grainPayloadSize) - sizeof(Grain);
+        }
+        return grainPayloadSize;
+    }
+
+    inline void DiscreteFlowData::openGrainSegment(char const* grainSegmentFilePath, std::size_t grainPayloadSize, PageMode pageMode)
+    {
+        auto const grainCount = std::size_t{flowInfo()->config.discrete.grainCount};
+
+        if (this->created())
+        {
+            auto segmentSize = grainSegmentSize(grainCount, grainPayloadSize);
+            if ((pageMode == PageMode::Huge) && (segmentSize >= hugePageSize()))
+            {
+                segmentSize = roundUpToHugePageSize(segmentSize);
+            }
+
+            auto segment = SharedMemorySegment{grainSegmentFilePath, AccessMode::CREATE_READ_WRITE, segmentSize, LockMode::Shared, pageMode};
+
+            auto const base = static_cast<std::uint8_t*>(segment.data());
+            auto const stride = grainSegmentStride(grainPayloadSize);
+            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            {
+                _grains.push_back(new (base + i * stride) Grain{});
+            }
+
+            _grainSegment = std::move(segment);
+        }
+        else
+        {
+            auto segment = SharedMemorySegment{grainSegmentFilePath, this->accessMode(), 0U, LockMode::Shared, pageMode};
+            if (grainCount == 0U)
+            {
+                _grainSegment = std::move(segment);
+                return;
+            }
+
+            if (segment.mappedSize() < sizeof(Grain))
+            {
+                throw std::invalid_argument{fmt::format("Grain segment of {} bytes is too small to hold a grain header.", segment.mappedSize())};
+            }
+
+            // All grains share the same payload size, so the stride can be derived from the first grain header.
+            auto const base = static_cast<std::uint8_t*>(segment.data());
+            auto const stride = grainSegmentStride(reinterpret_cast<Grain const*>(base)->header.info.grainSize);
+            if (segment.mappedSize() < grainCount * stride)
+            {
+                throw std::invalid_argument{
+                    fmt::format("Grain segment of {} bytes is too small to hold {} grains of {} bytes.", segment.mappedSize(), grainCount, stride)};
+            }
+
+            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            {
+                auto const grain = reinterpret_cast<Grain*>(base + i * stride);
+                // Check for the version of the grain data structure in the memory that was just mapped.
+                if (grain->header.info.version != GRAIN_HEADER_VERSION)
+                {
+                    throw std::invalid_argument{
+                        fmt::format("Unsupported grain version: {}, supported version is: {}", grain->header.info.version, GRAIN_HEADER_VERSION)};
+                }
+                _grains.push_back(grain);
+            }
+
+            _grainSegment = std::move(segment);
+        }
+    }
+
+    inline void DiscreteFlowData::openReaderHeartbeats(char const* heartbeatsFilePath)
+    {
+        auto const mode = this->created() ? AccessMode::CREATE_READ_WRITE : AccessMode::READ_WRITE;
+        auto heartbeats = SharedMemoryInstance<ReaderHeartbeats>{heartbeatsFilePath, mode, 0U, LockMode::None};
+
+        if (heartbeats.created())
+        {
+            heartbeats.get()->version = READER_HEARTBEATS_VERSION;
+        }
+        else if (heartbeats.get()->version != READER_HEARTBEATS_VERSION)
+        {
+            throw std::invalid_argument{fmt::format(
+                "Unsupported reader heartbeats version: {}, supported version is: {}", heartbeats.get()->version, READER_HEARTBEATS_VERSION)};
+        }
+
+        _readerHeartbeats = std::move(heartbeats);
+    }
+
+    inline ReaderHeartbeats* DiscreteFlowData::readerHeartbeats() noexcept
+    {
+        return _readerHeartbeats.get();
+    }
+
+    inline ReaderHeartbeats const* DiscreteFlowData::readerHeartbeats() const noexcept
+    {
+        return _readerHeartbeats.get();
+    }
+
+    inline mxlFlowInfo DiscreteFlowData::flowInfoWithReaderHeartbeats() const noexcept
+    {
+        auto result = *flowInfo();
+        if (auto const heartbeats = readerHeartbeats(); heartbeats != nullptr)
+        {
+            result.runtime.lastReadTime = std::max(result.runtime.lastReadTime, aggregateReaderHeartbeats(*heartbeats));
+        }
+        return result;
+    }
+
+    inline bool DiscreteFlowData::isHugePageBacked() const
+    {
+        if (_grainSegment.isValid())
+        {
+            return _grainSegment.isHugePageBacked();
+        }
+        if (_lazyGrains)
+        {
+            if (_lazyGrains->grains.empty())
+            {
+                return false;
+            }
+
+            auto const lock = std::lock_guard{_lazyGrains->mutex};
+            (void)mapLazyGrain(0U);
+            return _lazyGrains->files.front().isHugePageBacked();
+        }
+        return !_grainFiles.empty() && _grainFiles.front().isHugePageBacked();
     }
 
     inline Grain* DiscreteFlowData::grainAt(std::size_t i) noexcept
     {
-        return (i < _grains.size()) ? _grains[i].get() : nullptr;
+        if (_lazyGrains)
+        {
+            return lazyGrainAt(i);
+        }
+        return (i < _grains.size()) ? _grains[i] : nullptr;
     }
 
     inline Grain const* DiscreteFlowData::grainAt(std::size_t i) const noexcept
     {
-        return (i < _grains.size()) ? _grains[i].get() : nullptr;
+        if (_lazyGrains)
+        {
+            return lazyGrainAt(i);
+        }
+        return (i < _grains.size()) ? _grains[i] : nullptr;
     }
 
     inline mxlGrainInfo* DiscreteFlowData::grainInfoAt(std::size_t i) noexcept
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <utility>
 #include "FlowReader.hpp"
 #include "Timing.hpp"
 
@@ -28,6 +30,17 @@ namespace mxl::lib
          */
         virtual mxlStatus waitForGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline) const = 0;
 
+        /**
+         * Non-blocking counterpart of waitForGrain(). Checks whether the grain at a specific index has the expected number of valid
+         * slices, and whether the flow is still valid if it doesn't.
+         *
+         * \param in_index The grain index.
+         * \param in_minValidSlices The expected number of valid slices.
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        virtual mxlStatus pollGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices) const = 0;
+
         /**
          * Accessor for a specific grain at a specific index.
          * The index must be greater than or equal to the current tail index of the flow.
@@ -62,7 +75,55 @@ namespace mxl::lib
         virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) = 0;
 
+        /**
+         * Accessor for a range of consecutive, complete grains. Blocks until the first grain of the range is available, and then
+         * collects all directly following grains that are available without waiting for them. The flow access time is updated
+         * once for the whole range.
+         *
+         * \param in_firstIndex The index of the first grain.
+         * \param in_count The maximum number of grains to obtain.
+         * \param in_deadline The point in time of Clock::Realtime at which to stop waiting for the first grain.
+         * \param out_grainInfos A valid pointer to an array of at least in_count mxlGrainInfo elements.
+         * \param out_payloads A valid pointer to an array of at least in_count payload pointers.
+         * \param out_availableCount A valid pointer that will be set to the number of grains that were obtained.
+         *
+         * \return MXL_STATUS_OK if at least the first grain was obtained, or the status code describing why it wasn't.
+         */
+        virtual mxlStatus getGrainRange(std::uint64_t in_firstIndex, std::size_t in_count, Timepoint in_deadline, mxlGrainInfo* out_grainInfos,
+            std::uint8_t** out_payloads, std::size_t* out_availableCount) = 0;
+
+        /**
+         * Non-blocking accessor for the frequently used subset of the grain info at a specific index. Contrary to
+         * getGrain, partial grains are returned regardless of how many of their slices are valid, and the flow
+         * access time is not updated.
+         *
+         * \param in_index The grain index.
+         * \param out_grainInfo A valid pointer to mxlGrainInfoLite that will be copied to.
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        virtual mxlStatus getGrainInfoLite(std::uint64_t in_index, mxlGrainInfoLite* out_grainInfo) const = 0;
+
+        /**
+         * Return whether the grains of the flow are actually backed by huge pages in the address space of this reader.
+         */
+        [[nodiscard]]
+        virtual bool isHugePageBacked() const = 0;
+
     protected:
-        using FlowReader::FlowReader;
+        DiscreteFlowReader(uuids::uuid&& flowId, std::filesystem::path const& domain);
+        DiscreteFlowReader(uuids::uuid const& flowId, std::filesystem::path const& domain);
     };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline DiscreteFlowReader::DiscreteFlowReader(uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : FlowReader{FlowKind::Discrete, std::move(flowId), domain}
+    {}
+
+    inline DiscreteFlowReader::DiscreteFlowReader(uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : FlowReader{FlowKind::Discrete, flowId, domain}
+    {}
 }
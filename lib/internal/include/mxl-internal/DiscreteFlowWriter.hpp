@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <utility>
 #include "FlowWriter.hpp"
 
 namespace mxl::lib
@@ -23,6 +24,19 @@ namespace mxl::lib
         virtual mxlStatus cancel() = 0;
 
     protected:
-        using FlowWriter::FlowWriter;
+        DiscreteFlowWriter(uuids::uuid&& flowId, std::filesystem::path const& domain);
+        DiscreteFlowWriter(uuids::uuid const& flowId, std::filesystem::path const& domain);
     };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline DiscreteFlowWriter::DiscreteFlowWriter(uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : FlowWriter{FlowKind::Discrete, std::move(flowId), domain}
+    {}
+
+    inline DiscreteFlowWriter::DiscreteFlowWriter(uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : FlowWriter{FlowKind::Discrete, flowId, domain}
+    {}
 }
@@ -3,19 +3,37 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iosfwd>
 #include <mxl/flow.h>
 #include <mxl/platform.h>
 #include "FlowInfo.hpp"
 #include "FlowState.hpp"
+#include "Thread.hpp"
+#include "Timing.hpp"
 
 namespace mxl::lib
 {
-    /// The version of the flow data structs in shared memory that we expect and support.
+    /// The version of the flow data structs in shared memory that we expect and support. Flows of this version don't come with a
+    /// waiters segment, because they may be shared with SDK versions that neither register nor announce their waits.
     constexpr auto FLOW_DATA_VERSION = 1U;
 
+    /// The version of the flow data structs of discrete flows that store all of their grains in a single contiguous segment
+    /// instead of one file per grain. The layout of the `Flow` structure itself is identical to FLOW_DATA_VERSION.
+    constexpr auto FLOW_DATA_VERSION_SINGLE_SEGMENT = 2U;
+
+    /// The version of the flow data structs of continuous flows that store the samples of all channels interleaved frame by frame
+    /// instead of one ring buffer per channel. The layout of the `Flow` structure itself is identical to FLOW_DATA_VERSION.
+    constexpr auto FLOW_DATA_VERSION_INTERLEAVED = 3U;
+
+    /// The version of the flow data structs of flows that store their grains or samples like FLOW_DATA_VERSION, but come with a
+    /// waiters segment that all of their readers and writers use. Flows of any version other than FLOW_DATA_VERSION do. Flows are
+    /// only created with this version if their writer opts in, so that flows are accessible to older SDK versions by default.
+    constexpr auto FLOW_DATA_VERSION_WAITERS = 4U;
+
     /// The version of the grain header structs in shared memory that we expect an support.
     constexpr auto GRAIN_HEADER_VERSION = 1U;
 
@@ -33,11 +51,25 @@ namespace mxl::lib
     /// between the header and the payload.  Payload is page aligned AND AVX512 (64 bytes) aligned.
     constexpr auto const MXL_GRAIN_PAYLOAD_OFFSET = std::size_t{8192};
 
+    /// The number of leading bytes of mxlGrainInfo that carry meaning. The remainder of the structure is reserved padding and is
+    /// neither published by writers nor copied by readers.
+    constexpr auto const MXL_GRAIN_INFO_PREFIX_SIZE = offsetof(mxlGrainInfo, reserved);
+
+    /// The number of times loadGrainInfo() spins on a grain info that is being updated before it starts yielding to the writer.
+    constexpr auto const GRAIN_INFO_SPIN_COUNT = 64;
+
+    /// The maximum amount of time loadGrainInfo() waits for a writer to finish an update, before assuming that it crashed.
+    constexpr auto const GRAIN_INFO_MAX_STALL = Duration{10'000'000};
+
     struct GrainHeader
     {
         mxlGrainInfo info;
 
-        std::uint8_t pad[MXL_GRAIN_PAYLOAD_OFFSET - sizeof info];
+        /// Sequence counter protecting the meaningful prefix of 'info'. Odd while a writer is updating it. Lives in what used to be
+        /// padding, so headers written by older writers simply read as never updated.
+        std::uint32_t seq;
+
+        std::uint8_t pad[MXL_GRAIN_PAYLOAD_OFFSET - sizeof info - sizeof seq];
     };
 
     ///
@@ -53,6 +85,171 @@ namespace mxl::lib
         GrainHeader header;
     };
 
+    /// Alignment of every grain within a single segment grain storage. Keeps both headers and payloads page aligned.
+    constexpr auto const MXL_GRAIN_SEGMENT_STRIDE_ALIGNMENT = std::size_t{4096};
+
+    /// The total size of a single segment grain storage that spans at least one huge page is rounded up to this value, so that the
+    /// segment can be backed by huge pages entirely if the underlying file system supports it.
+    constexpr auto const MXL_GRAIN_SEGMENT_SIZE_ALIGNMENT = std::size_t{2U * 1024U * 1024U};
+
+    ///
+    /// Distinguishes the readers and writers of discrete flows from the ones of continuous flows without RTTI.
+    ///
+    enum class FlowKind : std::uint8_t
+    {
+        Discrete,
+        Continuous,
+    };
+
+    ///
+    /// Describes how the grains of a discrete flow are stored.
+    ///
+    enum class DiscreteFlowLayout
+    {
+        /// Every grain is stored in its own file below the grains directory (FLOW_DATA_VERSION or FLOW_DATA_VERSION_WAITERS).
+        PerGrainFiles,
+        /// All grains are stored back to back in a single file (FLOW_DATA_VERSION_SINGLE_SEGMENT).
+        SingleSegment,
+    };
+
+    ///
+    /// Describes how the samples of a continuous flow are stored.
+    ///
+    enum class ContinuousFlowLayout
+    {
+        /// Every channel is stored in its own ring buffer (FLOW_DATA_VERSION or FLOW_DATA_VERSION_WAITERS).
+        Planar,
+        /// The channels are stored interleaved frame by frame in a single ring buffer (FLOW_DATA_VERSION_INTERLEAVED).
+        Interleaved,
+    };
+
+    ///
+    /// Describes when the grain files of a discrete flow using the DiscreteFlowLayout::PerGrainFiles layout are mapped.
+    ///
+    enum class GrainMapping
+    {
+        /// All grains are mapped when the flow is opened.
+        Eager,
+        /// Every grain is mapped when it is first accessed.
+        Lazy,
+    };
+
+    ///
+    /// Describes how the channel buffers of a continuous flow are mapped into the address space of a reader or writer.
+    ///
+    enum class ChannelMapping
+    {
+        /// The channel buffers are mapped back to back, windows that wrap around the end of a buffer are split in two fragments.
+        Linear,
+        /// Every channel buffer is followed by a second mapping of itself, so that every window is a single fragment.
+        Mirrored,
+    };
+
+    /// Return whether the specified flow data version is one that we can open.
+    constexpr bool isSupportedFlowDataVersion(std::uint32_t version) noexcept;
+
+    /// Return whether flows of the specified flow data version come with a waiters segment.
+    constexpr bool hasFlowWaiters(std::uint32_t version) noexcept;
+
+    /// Return the distance in bytes between two consecutive grains with the specified payload size in a single segment grain storage.
+    constexpr std::size_t grainSegmentStride(std::size_t grainPayloadSize) noexcept;
+
+    /// Return the size in bytes of a single segment grain storage holding the specified number of grains.
+    constexpr std::size_t grainSegmentSize(std::size_t grainCount, std::size_t grainPayloadSize) noexcept;
+
+    /// Copy the meaningful prefix of the grain info stored in the specified header into 'out_info', without tearing if a writer
+    /// updates it concurrently. The reserved bytes of 'out_info' are left untouched.
+    void loadGrainInfo(GrainHeader const& header, mxlGrainInfo& out_info) noexcept;
+
+    /// Publish the meaningful prefix of 'info' in the specified header, so that concurrent calls to loadGrainInfo() observe either
+    /// the previous or the new value, but never a mix of the two.
+    void storeGrainInfo(GrainHeader& header, mxlGrainInfo const& info) noexcept;
+
     std::ostream& operator<<(std::ostream& os, Grain const& obj);
 
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    constexpr bool isSupportedFlowDataVersion(std::uint32_t version) noexcept
+    {
+        return (version == FLOW_DATA_VERSION) || (version == FLOW_DATA_VERSION_SINGLE_SEGMENT) || (version == FLOW_DATA_VERSION_INTERLEAVED) ||
+               (version == FLOW_DATA_VERSION_WAITERS);
+    }
+
+    constexpr bool hasFlowWaiters(std::uint32_t version) noexcept
+    {
+        return isSupportedFlowDataVersion(version) && (version != FLOW_DATA_VERSION);
+    }
+
+    constexpr std::size_t grainSegmentStride(std::size_t grainPayloadSize) noexcept
+    {
+        auto const size = sizeof(Grain) + grainPayloadSize;
+        return ((size + MXL_GRAIN_SEGMENT_STRIDE_ALIGNMENT - 1U) / MXL_GRAIN_SEGMENT_STRIDE_ALIGNMENT) * MXL_GRAIN_SEGMENT_STRIDE_ALIGNMENT;
+    }
+
+    constexpr std::size_t grainSegmentSize(std::size_t grainCount, std::size_t grainPayloadSize) noexcept
+    {
+        auto const size = grainCount * grainSegmentStride(grainPayloadSize);
+        if (size < MXL_GRAIN_SEGMENT_SIZE_ALIGNMENT)
+        {
+            return size;
+        }
+        return ((size + MXL_GRAIN_SEGMENT_SIZE_ALIGNMENT - 1U) / MXL_GRAIN_SEGMENT_SIZE_ALIGNMENT) * MXL_GRAIN_SEGMENT_SIZE_ALIGNMENT;
+    }
+
+    inline void loadGrainInfo(GrainHeader const& header, mxlGrainInfo& out_info) noexcept
+    {
+        // NOTE: atomic_ref<T const> is only available from C++26 on.
+        auto const seq = std::atomic_ref{const_cast<std::uint32_t&>(header.seq)};
+
+        // A writer that is preempted in the middle of an update keeps the sequence counter odd until it gets to run again, so
+        // after spinning for a little while we yield to it. A writer that crashed in the middle of an update leaves the counter
+        // odd forever though, so we eventually settle for whatever we read.
+        auto stuckSeq = std::uint32_t{1};
+        auto stuckCount = 0;
+        auto giveUpTime = Timepoint{};
+        while (true)
+        {
+            auto const before = seq.load(std::memory_order_acquire);
+            std::memcpy(&out_info, &header.info, MXL_GRAIN_INFO_PREFIX_SIZE);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((before & 1U) == 0U)
+            {
+                if (seq.load(std::memory_order_relaxed) == before)
+                {
+                    return;
+                }
+            }
+            else if (before != stuckSeq)
+            {
+                stuckSeq = before;
+                stuckCount = 0;
+            }
+            else if (++stuckCount >= GRAIN_INFO_SPIN_COUNT)
+            {
+                auto const now = currentTime(Clock::Monotonic);
+                if (stuckCount == GRAIN_INFO_SPIN_COUNT)
+                {
+                    giveUpTime = now + GRAIN_INFO_MAX_STALL;
+                }
+                else if (now >= giveUpTime)
+                {
+                    return;
+                }
+                this_thread::yield();
+            }
+        }
+    }
+
+    inline void storeGrainInfo(GrainHeader& header, mxlGrainInfo const& info) noexcept
+    {
+        auto const seq = std::atomic_ref{header.seq};
+
+        seq.fetch_add(1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&header.info, &info, MXL_GRAIN_INFO_PREFIX_SIZE);
+        seq.fetch_add(1U, std::memory_order_release);
+    }
+
 } // namespace mxl::lib
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <mxl/platform.h>
 #include "Flow.hpp"
+#include "FlowWaiters.hpp"
 #include "SharedMemory.hpp"
 
 namespace mxl::lib
@@ -36,6 +37,45 @@ namespace mxl::lib
         bool isExclusive() const;
         bool makeExclusive();
 
+        /**
+         * Create or open the waiter registration segment of this flow. The segment is always mapped writable, even if the flow itself
+         * was opened read-only, because readers register their waits in it.
+         *
+         * \param[in] waitersFilePath The path of the waiters file.
+         * \throws std::system_error If the segment could not be created or opened for writing.
+         * \throws std::invalid_argument If the segment has an unsupported version.
+         */
+        void openFlowWaiters(char const* waitersFilePath);
+
+        /**
+         * Take an UnannouncedReaderLock on the waiter registration segment of this flow. Used by readers that could not map the
+         * segment writable.
+         *
+         * \param[in] waitersFilePath The path of the waiters file.
+         * \throws std::system_error If the lock could not be taken.
+         */
+        void lockFlowWaiters(char const* waitersFilePath);
+
+        /** Return the waiter registrations of this flow, or the null pointer if they are not available. */
+        constexpr FlowWaiters* flowWaiters() noexcept;
+        constexpr FlowWaiters const* flowWaiters() const noexcept;
+
+        /**
+         * Return the waiter registrations of this flow that writers may consult to skip waking up readers sleeping on the sync
+         * counter. This is the null pointer while readers that can not announce themselves may be present, which is only checked
+         * every UNANNOUNCED_READER_CHECK_INTERVAL.
+         *
+         * \param[in] now The current time, as seen by the writer.
+         */
+        FlowWaiters const* announcedFlowWaiters(Timepoint now) noexcept;
+
+        /**
+         * Return until when (Clock::Realtime) readers of this flow that sleep on the sync counter must check it every
+         * UNANNOUNCED_WAIT_INTERVAL, because writers may not wake them up until then.
+         */
+        [[nodiscard]]
+        Timepoint unannouncedUntil() const noexcept;
+
         virtual ~FlowData();
 
     protected:
@@ -44,6 +84,11 @@ namespace mxl::lib
 
     private:
         SharedMemoryInstance<Flow> _flow;
+        SharedMemoryInstance<FlowWaiters> _waiters;
+        /** Held by readers that could not map the waiters segment writable. */
+        UnannouncedReaderLock _unannouncedLock;
+        /** Used by writers to find out about readers holding an UnannouncedReaderLock. */
+        UnannouncedReaderProbe _unannouncedProbe;
     };
 
     /**************************************************************************/
@@ -52,6 +97,9 @@ namespace mxl::lib
 
     constexpr FlowData::FlowData(SharedMemoryInstance<Flow>&& flowSegement) noexcept
         : _flow{std::move(flowSegement)}
+        , _waiters{}
+        , _unannouncedLock{}
+        , _unannouncedProbe{}
     {}
 
     constexpr bool FlowData::isValid() const noexcept
@@ -107,6 +155,16 @@ namespace mxl::lib
         return nullptr;
     }
 
+    constexpr FlowWaiters* FlowData::flowWaiters() noexcept
+    {
+        return _waiters.get();
+    }
+
+    constexpr FlowWaiters const* FlowData::flowWaiters() const noexcept
+    {
+        return _waiters.get();
+    }
+
     constexpr FlowState* FlowData::flowState() noexcept
     {
         if (auto const flow = _flow.get(); flow != nullptr)
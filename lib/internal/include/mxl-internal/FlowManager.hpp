@@ -5,9 +5,17 @@
 
 #include <cstddef>
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <uuid.h>
 #include <mxl/platform.h>
@@ -24,11 +32,18 @@ namespace mxl::lib
     ///  - <mxl_domain>/<flow_id>.mxl-flow               : The toplevel for all files belonging to MXLs representation of a the flow
     ///  - <mxl_domain>/<flow_id>.mxl-flow/flow_def.json : A file containing the flow definition (NMOS Flow resource json)
     ///  - <mxl_domain>/<flow_id>.mxl-flow/access        : A file used for access notifications by consumers of the flow
+    ///  - <mxl_domain>/<flow_id>.mxl-flow/heartbeats    : An optional shared memory segment in which consumers of the flow store their
+    ///                                                    last read time, used instead of the access file if present.
     ///  - <mxl_domain>/<flow_id>.mxl-flow/data          : The shared memory segment containing the `Flow`
-    ///  - <mxl_domain>/<flow_id>.mxl-flow/grains/       : A directory containing the per grain shared memory segments.
+    ///  - <mxl_domain>/<flow_id>.mxl-flow/grains/       : A directory containing the per grain shared memory segments, or a single
+    ///                                                    'segment' file holding all grains if the flow uses the single segment layout.
     ///
     /// After creation, the FlowData associated with the new flow is stored in an internal cache.
     ///
+    /// If the flow pool is enabled, spare flow skeletons (flows without id and definition, but with all of their files allocated) are
+    /// kept below <mxl_domain>/.mxl-pool/, keyed by the geometry of the flow. Creating a flow of a geometry that has a spare skeleton
+    /// only stamps its id, writes its definition and publishes it.
+    ///
     /// GET
     /// Return a cached FlowData for a flowId.  The flow must opened first.
     ///
@@ -49,6 +64,14 @@ namespace mxl::lib
         ///
         FlowManager(std::filesystem::path const& in_mxlDomain);
 
+        /// Dtor. Waits for a pending refill of the flow pool to complete.
+        ~FlowManager();
+
+        FlowManager(FlowManager&&) = delete;
+        FlowManager(FlowManager const&) = delete;
+        FlowManager& operator=(FlowManager&&) = delete;
+        FlowManager& operator=(FlowManager const&) = delete;
+
         ///
         /// Create a new discrete flow together with its associated grains and open it in read-write mode.
         ///
@@ -62,13 +85,24 @@ namespace mxl::lib
         /// \param[in] grainSliceLengths Length of each slice in bytes.
         /// \param[in] maxSyncBatchSizeHintOpt Optional max sync batch size hint.
         /// \param[in] maxCommitBatchSizeHintOpt Optional max commit batch size hint
+        /// \param[in] layout How the grains of the flow should be stored. Only relevant if the flow is created.
+        /// \param[in] readerHeartbeats Whether readers should report their accesses through a shared memory heartbeat segment instead of
+        ///     touching the access file. Only relevant if the flow is created.
+        /// \param[in] hugePages Whether the grains should be sized and advised to be backed by huge pages. Only relevant if the flow is
+        ///     created.
+        /// \param[in] prefault Whether all pages of the grains should be mapped into the address space of this process while creating the
+        ///     flow, instead of on first access. Only relevant if the flow is created.
+        /// \param[in] flowWaiters Whether a flow using the per grain files layout should come with a waiters segment, which makes it
+        ///     inaccessible to SDK versions that only support FLOW_DATA_VERSION. Only relevant if the flow is created.
         /// \return (created, flowData) If the flow was created, the first returnd value is true. If the flow was opened instead, false will be
         /// returned. The second returned value is the flow data of the opened or created flow.
         ///
         std::pair<bool, std::unique_ptr<DiscreteFlowData>> createOrOpenDiscreteFlow(uuids::uuid const& flowId, std::string const& flowDef,
             mxlDataFormat flowFormat, std::size_t grainCount, mxlRational const& grainRate, std::size_t grainPayloadSize,
             std::size_t grainNumOfSlices, std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN> grainSliceLengths,
-            std::uint32_t maxSyncBatchSizeHintOpt = 1, std::uint32_t maxCommitBatchSizeHintOpt = 1);
+            std::uint32_t maxSyncBatchSizeHintOpt = 1, std::uint32_t maxCommitBatchSizeHintOpt = 1,
+            DiscreteFlowLayout layout = DiscreteFlowLayout::PerGrainFiles, bool readerHeartbeats = false, bool hugePages = false,
+            bool prefault = false, bool flowWaiters = false);
 
         ///
         /// Create a new continuous flow together with its associated channel store and open it in read-write mode.
@@ -82,19 +116,29 @@ namespace mxl::lib
         /// \param[in] bufferLength The length of each channel buffer in samples.
         /// \param[in] maxSyncBatchSizeHintOpt Optional max sync batch size hint.
         /// \param[in] maxCommitBatchSizeHintOpt Optional max commit batch size hint
+        /// \param[in] layout How to store the samples of the flow.
+        /// \param[in] channelMapping How to map the channel buffers of the flow.
+        /// \param[in] flowWaiters Whether a flow using the planar layout should come with a waiters segment, which makes it inaccessible
+        ///     to SDK versions that only support FLOW_DATA_VERSION. Only relevant if the flow is created.
         /// \return (created, flowData) If the flow was created, the first returnd value is true. If the flow was opened instead, false will be
         /// returned. The second returned value is the flow data of the opened or created flow.
         ///
         std::pair<bool, std::unique_ptr<ContinuousFlowData>> createOrOpenContinuousFlow(uuids::uuid const& flowId, std::string const& flowDef,
             mxlDataFormat flowFormat, mxlRational const& sampleRate, std::size_t channelCount, std::size_t sampleWordSize, std::size_t bufferLength,
-            std::uint32_t maxSyncBatchSizeHintOpt = 1, std::uint32_t maxCommitBatchSizeHintOpt = 1);
+            std::uint32_t maxSyncBatchSizeHintOpt = 1, std::uint32_t maxCommitBatchSizeHintOpt = 1,
+            ContinuousFlowLayout layout = ContinuousFlowLayout::Planar, ChannelMapping channelMapping = ChannelMapping::Linear,
+            bool flowWaiters = false);
 
         /// Open an existing flow by id.
         ///
         /// \param[in] flowId The flow to open
         /// \param[in] mode The flow access mode
+        /// \param[in] grainMapping When to map the grain files of a discrete flow. Only relevant for discrete flows that store every
+        ///     grain in its own file.
+        /// \param[in] channelMapping How to map the channel buffers of a continuous flow.
         ///
-        std::unique_ptr<FlowData> openFlow(uuids::uuid const& flowId, AccessMode mode);
+        std::unique_ptr<FlowData> openFlow(uuids::uuid const& flowId, AccessMode mode, GrainMapping grainMapping = GrainMapping::Eager,
+            ChannelMapping channelMapping = ChannelMapping::Linear);
 
         ///
         /// Delete all resources associated to a flow
@@ -110,6 +154,14 @@ namespace mxl::lib
         ///
         bool deleteFlow(uuids::uuid const& flowId);
 
+        ///
+        /// Mark a flow as retired, so that readers still attached to it learn that it is stale without having to
+        /// inspect the file system. This is done implicitly when deleting a flow and is best effort: failures, for
+        /// example on read-only domains, are logged and otherwise ignored.
+        /// \param flowId The ID of the flow to retire.
+        ///
+        void retireFlow(uuids::uuid const& flowId) const noexcept;
+
         ///
         /// \return List all flows on disk.
         ///
@@ -128,11 +180,54 @@ namespace mxl::lib
         /// \return The base path
         std::filesystem::path const& getDomain() const;
 
+        ///
+        /// Keep up to the specified number of spare flow skeletons per flow geometry in the flow pool of the domain. The pool of a geometry
+        /// is refilled in the background whenever a flow of that geometry is created. A size of 0 disables the pool.
+        /// \param size The number of spare skeletons to keep per geometry.
+        ///
+        void setFlowPoolSize(std::size_t size) noexcept;
+
+        ///
+        /// Remove the skeletons in excess of the configured pool size from the flow pool of the domain, or all of them if the pool is
+        /// disabled.
+        /// \return The number of skeletons that were removed.
+        ///
+        std::size_t trimFlowPool() const;
+
     private:
-        std::unique_ptr<DiscreteFlowData> openDiscreteFlow(std::filesystem::path const& flowDir, SharedMemoryInstance<Flow>&& sharedFlowInstance);
-        std::unique_ptr<ContinuousFlowData> openContinuousFlow(std::filesystem::path const& flowDir, SharedMemoryInstance<Flow>&& sharedFlowInstance);
+        /// Prepares the files of a flow skeleton in the directory passed to it.
+        using FlowPreparation = std::function<void(std::filesystem::path const&)>;
+
+        std::unique_ptr<DiscreteFlowData> openDiscreteFlow(std::filesystem::path const& flowDir, SharedMemoryInstance<Flow>&& sharedFlowInstance,
+            GrainMapping grainMapping = GrainMapping::Eager);
+        std::unique_ptr<ContinuousFlowData> openContinuousFlow(std::filesystem::path const& flowDir, SharedMemoryInstance<Flow>&& sharedFlowInstance,
+            ChannelMapping channelMapping = ChannelMapping::Linear);
+
+        /// Take a skeleton of the specified geometry out of the flow pool.
+        /// \return The temporary directory now holding the skeleton, or std::nullopt if the pool holds none.
+        std::optional<std::filesystem::path> claimPooledFlow(std::string const& geometry) const;
+
+        /// Schedule topping up the flow pool of the specified geometry on the refill thread, starting it if necessary. Never throws, as
+        /// failing to refill the pool only makes subsequent flow creations slower.
+        void refillFlowPool(std::string const& geometry, FlowPreparation prepare) noexcept;
+
+        /// Body of the refill thread.
+        void runFlowPoolRefills();
 
     private:
         std::filesystem::path _mxlDomain;
+
+        /// The number of spare skeletons to keep per geometry.
+        std::atomic<std::size_t> _flowPoolSize;
+        /// Protects the pending refills and the refill thread.
+        std::mutex _flowPoolMutex;
+        /// Signals pending refills to the refill thread.
+        std::condition_variable _flowPoolCondition;
+        /// The geometries whose pool needs to be refilled, along with how to prepare their skeletons.
+        std::deque<std::pair<std::string, FlowPreparation>> _flowPoolRefills;
+        /// Set to stop the refill thread.
+        std::atomic_bool _flowPoolStopping;
+        /// Prepares pooled skeletons in the background. Only started once the first refill is scheduled.
+        std::thread _flowPoolThread;
     };
 } // namespace mxl::lib
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <mxl/mxl.h>
+#include <mxl/platform.h>
+#include "Timing.hpp"
+
+namespace mxl::lib
+{
+    class ContinuousFlowReader;
+    class DiscreteFlowReader;
+    class FlowReader;
+
+    /**
+     * Fans out the sync counter notifications of flows to file descriptors,
+     * which allows applications to wait for data on flows from within their
+     * own event loops. Each reader has a single wait handle that is armed for
+     * a specific grain or sample index and becomes readable once the reader
+     * can make progress. A single thread monitors all armed wait handles.
+     */
+    class MXL_EXPORT FlowNotifier
+    {
+    public:
+        /**
+         * Start the notifier thread.
+         * \throws std::system_error If the thread could not be started.
+         */
+        FlowNotifier();
+
+        /** Stop the notifier thread and close all wait handles. */
+        ~FlowNotifier();
+
+        FlowNotifier(FlowNotifier&&) = delete;
+        FlowNotifier(FlowNotifier const&) = delete;
+        FlowNotifier& operator=(FlowNotifier&&) = delete;
+        FlowNotifier& operator=(FlowNotifier const&) = delete;
+
+        /**
+         * Arm the wait handle of a reader, creating it if the reader doesn't
+         * have one yet. The handle is reset to not readable, and becomes
+         * readable once waiting for the specified index on the reader would
+         * no longer return MXL_ERR_OUT_OF_RANGE_TOO_EARLY. A handle that was
+         * armed previously is re-armed for the new index.
+         *
+         * \param[in] reader The reader to create or re-arm the wait handle for.
+         * \param[in] index The index of the grain or sample to wait for.
+         * \param[in] minValidSlices The number of valid slices to wait for
+         *      within the grain. Ignored for continuous flows.
+         * \return The file descriptor of the wait handle, which is the same
+         *      for all calls with the same reader.
+         * \throws std::system_error If the wait handle could not be created.
+         */
+        int arm(FlowReader const& reader, std::uint64_t index, std::uint16_t minValidSlices);
+
+        /**
+         * Close the wait handle of a reader, if it has one. Must be called
+         * before the reader is destroyed.
+         */
+        void remove(FlowReader const& reader);
+
+    private:
+        struct Registration
+        {
+            /** The end of the wait handle that is handed out to the application. */
+            int readFd;
+            /** The end of the wait handle that is signalled, the same as readFd where eventfd is available. */
+            int writeFd;
+
+            DiscreteFlowReader const* discreteReader;
+            ContinuousFlowReader const* continuousReader;
+            std::uint32_t const* syncCounter;
+            std::uint32_t* syncWaiters;
+            /** Until when writers may skip waking us up, see FlowReader::getUnannouncedUntil(). */
+            Timepoint unannouncedUntil;
+
+            std::uint64_t index;
+            std::uint16_t minValidSlices;
+            bool armed;
+        };
+
+    private:
+        /** Body of the notifier thread. */
+        void run();
+
+        /** Check whether the reader of an armed registration can make progress. */
+        [[nodiscard]]
+        static mxlStatus poll(Registration const& registration);
+
+        /** Stop monitoring a registration and withdraw our announcement as a sleeping reader. */
+        static void disarm(Registration& registration) noexcept;
+
+        /** Make the notifier thread re-evaluate the registrations. Must be called with _mutex held. */
+        void wakeThread() noexcept;
+
+    private:
+        std::mutex _mutex;
+        /** Signalled whenever the notifier thread has collected the registrations to monitor. */
+        std::condition_variable _iterationDone;
+        std::map<FlowReader const*, Registration> _registrations;
+        /** Futex word the notifier thread monitors along with the sync counters to learn about changed registrations. */
+        std::uint32_t _control;
+        /** The number of times the notifier thread has collected the registrations to monitor. */
+        std::uint64_t _iterations;
+        bool _stopping;
+        std::thread _thread;
+    };
+}
@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
 #include <picojson/wrapper.h>
 #include <mxl/platform.h>
+#include "Flow.hpp"
+#include "Sync.hpp"
+#include "Timing.hpp"
 
 namespace mxl::lib
 {
@@ -29,8 +33,8 @@ namespace mxl::lib
 
         /**
          * Accessor for the 'maxCommitBatchSizeHint' field, which expresses the largest expected batch size in samples (for continuous flows) or
-         * slices (for discrete flows), in which new data is written to this this flow by its producer. For continuous flows, this value must be less
-         * than half of the buffer length. For discrete flows, this must be greater or equal to 1.
+         * slices (for discrete flows), in which new data is written to this this flow by its producer. For continuous flows, this many samples are
+         * added to the buffer length and reserved for the batch that is being written. For discrete flows, this must be greater or equal to 1.
          */
         [[nodiscard]]
         std::optional<std::uint32_t> getMaxCommitBatchSizeHint() const;
@@ -43,6 +47,71 @@ namespace mxl::lib
         [[nodiscard]]
         std::optional<std::uint32_t> getMaxSyncBatchSizeHint() const;
 
+        /**
+         * Accessor for the 'discreteFlowLayout' field, which selects how the grains of a newly created discrete flow are stored. Supported
+         * values are "perGrainFiles" (the default, one file per grain) and "singleSegment" (all grains in one contiguous shared memory segment,
+         * which makes opening the flow considerably cheaper). Ignored for continuous flows and for flows that already exist.
+         */
+        [[nodiscard]]
+        std::optional<DiscreteFlowLayout> getDiscreteFlowLayout() const;
+
+        /**
+         * Accessor for the 'continuousFlowLayout' field, which selects how the samples of a newly created continuous flow are stored.
+         * Supported values are "planar" (the default, one ring buffer per channel) and "interleaved" (the samples of all channels
+         * interleaved frame by frame in a single ring buffer). Ignored for discrete flows and for flows that already exist.
+         */
+        [[nodiscard]]
+        std::optional<ContinuousFlowLayout> getContinuousFlowLayout() const;
+
+        /**
+         * Accessor for the 'prefault' field, which selects whether all grains of a newly created discrete flow are mapped into the
+         * address space of the writer while the flow is created, so that the first write to each grain doesn't fault. Ignored for
+         * continuous flows and for flows that already exist.
+         */
+        [[nodiscard]]
+        std::optional<bool> getPrefault() const;
+
+        /**
+         * Accessor for the 'flowWaiters' field, which selects whether a newly created flow comes with a waiters segment, in which
+         * blocked readers register what they wait for. Such flows are marked with a flow data version that SDK versions only
+         * supporting version 1 refuse to open. Flows using the "singleSegment" or "interleaved" layouts always come with the segment.
+         * Ignored for flows that already exist.
+         */
+        [[nodiscard]]
+        std::optional<bool> getFlowWaiters() const;
+
+        /**
+         * Accessor for the 'waitPolicy' field of flow reader options, which selects how the blocking accessors of the reader wait for new
+         * data. Supported values are "futex" (the default, sleep in the kernel right away), "spin" (spin for up to 'maxSpinNs' first) and
+         * "adaptive" (spin for a duration derived from previous waits, bounded by 'maxSpinNs').
+         */
+        [[nodiscard]]
+        std::optional<WaitPolicy> getWaitPolicy() const;
+
+        /**
+         * Accessor for the 'maxSpinNs' field of flow reader options, which bounds the time in nanoseconds that the "spin" and "adaptive"
+         * wait policies spin before going to sleep in the kernel.
+         */
+        [[nodiscard]]
+        std::optional<Duration> getMaxSpinDuration() const;
+
+        /**
+         * Accessor for the 'grainMapping' field of flow reader options, which selects when the grains of a discrete flow are mapped.
+         * Supported values are "eager" (the default, all grains are mapped when the reader is created) and "lazy" (every grain is
+         * mapped when it is first read, which makes creating readers that only read a few grains considerably cheaper). Ignored for
+         * continuous flows and for discrete flows using the single segment layout.
+         */
+        [[nodiscard]]
+        std::optional<GrainMapping> getGrainMapping() const;
+
+        /**
+         * Accessor for the 'channelMapping' field of flow reader and writer options, which selects how the channel buffers of a
+         * continuous flow are mapped. Supported values are "linear" (the default) and "mirrored" (every channel buffer is mapped twice
+         * back to back, so that sample windows never wrap around). Ignored for discrete flows.
+         */
+        [[nodiscard]]
+        std::optional<ChannelMapping> getChannelMapping() const;
+
         /**
          * Generic accessor for json fields.
          *
@@ -59,6 +128,22 @@ namespace mxl::lib
         std::optional<std::uint32_t> _maxSyncBatchSizeHint;
         /// \see mxlCommonFlowInfo::maxCommitBatchSizeHint
         std::optional<std::uint32_t> _maxCommitBatchSizeHint;
+        /// How the grains of a discrete flow should be stored.
+        std::optional<DiscreteFlowLayout> _discreteFlowLayout;
+        /// How the samples of a continuous flow should be stored.
+        std::optional<ContinuousFlowLayout> _continuousFlowLayout;
+        /// Whether the grains of a discrete flow should be prefaulted when it is created.
+        std::optional<bool> _prefault;
+        /// Whether a newly created flow should come with a waiters segment.
+        std::optional<bool> _flowWaiters;
+        /// How a flow reader waits for new data.
+        std::optional<WaitPolicy> _waitPolicy;
+        /// The longest a flow reader spins before going to sleep.
+        std::optional<Duration> _maxSpinDuration;
+        /// When a flow reader maps the grains of a discrete flow.
+        std::optional<GrainMapping> _grainMapping;
+        /// How a flow reader or writer maps the channel buffers of a continuous flow.
+        std::optional<ChannelMapping> _channelMapping;
         /** The parsed flow object. */
         picojson::object _root;
     };
@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
 #include <uuid.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include "mxl-internal/FlowData.hpp"
+#include "mxl-internal/Sync.hpp"
 
 namespace mxl::lib
 {
@@ -29,6 +31,14 @@ namespace mxl::lib
         [[nodiscard]]
         std::filesystem::path const& getDomain() const;
 
+        /**
+         * Accessor for the kind of flow read by this reader, which allows
+         * the C API to dispatch to the discrete or continuous interface with
+         * a static_cast instead of a dynamic_cast.
+         */
+        [[nodiscard]]
+        FlowKind getKind() const noexcept;
+
         /**
          * Accessor for the underlying flow data.
          * The flow reader must first open the flow before invoking this method.
@@ -61,6 +71,47 @@ namespace mxl::lib
         [[nodiscard]]
         virtual mxlFlowRuntimeInfo getFlowRuntimeInfo() const = 0;
 
+        /**
+         * Accessor for the futex word that writers of the flow increment and
+         * wake sleeping readers on whenever they commit new data. The reader
+         * must be properly attached to the flow before invoking this method.
+         */
+        [[nodiscard]]
+        std::uint32_t const* getSyncCounter() const;
+
+        /**
+         * Accessor for the number of readers sleeping on the sync counter.
+         * Writers skip waking up readers if it is zero, so callers must
+         * increment it for as long as they sleep on the sync counter
+         * themselves.
+         * \return The counter, or the null pointer if this reader can not
+         *      announce itself, see getUnannouncedUntil().
+         */
+        [[nodiscard]]
+        std::uint32_t* getSyncWaiters() const;
+
+        /**
+         * Accessor for the point in time (Clock::Realtime) until which
+         * writers may skip waking up this reader, because it can not announce
+         * itself. Callers sleeping on the sync counter must check it every
+         * UNANNOUNCED_WAIT_INTERVAL until then.
+         */
+        [[nodiscard]]
+        Timepoint getUnannouncedUntil() const;
+
+        /**
+         * Select how this reader waits for new data in its blocking accessors.
+         * Must not be called while another thread uses the reader.
+         */
+        void setWaitPolicy(WaitPolicy policy, Duration maxSpin = WaitStrategy::DEFAULT_MAX_SPIN) noexcept;
+
+        /**
+         * Accessor for the statistics about the waits performed by the
+         * blocking accessors of this reader, including wake-up latencies.
+         */
+        [[nodiscard]]
+        WaitStatistics getWaitStatistics() const noexcept;
+
         /** Destructor. */
         virtual ~FlowReader();
 
@@ -80,13 +131,48 @@ namespace mxl::lib
         [[nodiscard]]
         bool checkPermissions() const;
 
+        /**
+         * Shared implementation of isFlowValid() for flows in shared memory.
+         * Checks whether the flow has been retired, which is a single atomic
+         * load. Flows whose writer crashed never get retired, so every
+         * FLOW_VALIDITY_CHECK_INTERVAL the check also verifies that the flow
+         * data file still has the inode recorded in the flow state.
+         * \param[in] state The state of the flow this reader is attached to.
+         * \return true if the flow is valid, false otherwise.
+         */
+        [[nodiscard]]
+        bool isFlowStateValid(FlowState const& state) const;
+
+        /**
+         * Accessor for the strategy the blocking accessors should use to
+         * wait for new data.
+         */
+        [[nodiscard]]
+        WaitStrategy& waitStrategy() const noexcept;
+
     protected:
-        explicit FlowReader(uuids::uuid&& flowId, std::filesystem::path const& domain);
-        explicit FlowReader(uuids::uuid const& flowId, std::filesystem::path const& domain);
+        explicit FlowReader(FlowKind kind, uuids::uuid&& flowId, std::filesystem::path const& domain);
+        explicit FlowReader(FlowKind kind, uuids::uuid const& flowId, std::filesystem::path const& domain);
 
     private:
+        FlowKind _kind;
         uuids::uuid _flowId;
         std::filesystem::path _domain;
+        /** Path to the flow data file, used by the stat() fallback of isFlowStateValid(). */
+        std::filesystem::path _flowDataPath;
+        /** Monotonic time in nanoseconds at which the stat() fallback of isFlowStateValid() is due again. */
+        mutable std::atomic<std::int64_t> _nextStatCheck;
+        /** How the blocking accessors wait for new data. Mutable, because waiting updates its statistics. */
+        mutable WaitStrategy _waitStrategy;
     };
 
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline FlowKind FlowReader::getKind() const noexcept
+    {
+        return _kind;
+    }
+
 } // namespace mxl::lib
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <sys/types.h>
 
@@ -30,12 +31,28 @@ namespace mxl::lib
          */
         std::uint32_t syncCounter;
 
+        /**
+         * Non-zero once the flow has been retired, i.e. its files are about
+         * to be removed from the domain. Set by the last writer or the
+         * garbage collector before unlinking the flow, which allows readers
+         * to detect stale flows with a single atomic load instead of
+         * calling stat() on the flow data file. Occupies what used to be
+         * tail padding, so the layout of older flows remains compatible.
+         */
+        std::uint32_t retired;
+
         /**
          * Default constructor that value initializes all members.
          */
         constexpr FlowState() noexcept;
     };
 
+    /**
+     * Check whether a flow has been retired by its writer or the garbage
+     * collector.
+     */
+    bool isFlowRetired(FlowState const& state) noexcept;
+
     /**************************************************************************/
     /* Inline implementatiom.                                                 */
     /**************************************************************************/
@@ -43,5 +60,12 @@ namespace mxl::lib
     constexpr FlowState::FlowState() noexcept
         : inode{}
         , syncCounter{}
+        , retired{}
     {}
+
+    inline bool isFlowRetired(FlowState const& state) noexcept
+    {
+        // NOTE: atomic_ref<T const> is only available from C++26 on.
+        return std::atomic_ref{const_cast<std::uint32_t&>(state.retired)}.load(std::memory_order_acquire) != 0U;
+    }
 }
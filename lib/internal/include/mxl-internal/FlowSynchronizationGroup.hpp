@@ -7,6 +7,7 @@
 #include <forward_list>
 #include <mxl/mxl.h>
 #include <mxl/rational.h>
+#include "IndexConversion.hpp"
 #include "Timing.hpp"
 
 namespace mxl::lib
@@ -18,6 +19,12 @@ namespace mxl::lib
     /**
      * A set of weak references to a flow readers that can be used to check for
      * data availability on all flows of the group at once.
+     *
+     * Where the kernel supports it, the group sleeps on the sync counters of
+     * all flows that are still missing data at once, and only re-evaluates
+     * the flows whose counter changed when it wakes up. Otherwise it blocks
+     * on each of these flows in turn, using the wait policy of the respective
+     * reader.
      */
     class MXL_EXPORT FlowSynchronizationGroup
     {
@@ -28,6 +35,19 @@ namespace mxl::lib
 
         mxlStatus waitForDataAt(Timepoint originTime, Timepoint deadline) const;
 
+    private:
+        /**
+         * Implementation of waitForDataAt() that blocks on one flow after the
+         * other.
+         */
+        mxlStatus waitInSequence(Timepoint originTime, Timepoint deadline) const;
+
+        /**
+         * Implementation of waitForDataAt() that blocks on all flows that are
+         * still missing data at once. Requires isWaitOnMultipleSupported().
+         */
+        mxlStatus waitOnAll(Timepoint originTime, Timepoint deadline) const;
+
     private:
         enum class Variant : std::uint8_t
         {
@@ -55,9 +75,10 @@ namespace mxl::lib
             Variant variant;
 
             /**
-             * Cached copy of the flows grain rate for localized access.
+             * Converter for the flows grain rate, cached for localized access
+             * and to avoid 128-bit divisions on every wait.
              */
-            mxlRational grainRate;
+            RateConverter rateConverter;
 
             /**
              * The maximum source delay opportunistically observed by this
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/flow.h>
+#include <mxl/platform.h>
+#include "FlowState.hpp"
+#include "Timing.hpp"
+
+namespace mxl::lib
+{
+    /// The version of the flow waiter structs in shared memory that we expect and support.
+    constexpr auto FLOW_WAITERS_VERSION = 1U;
+
+    /// The number of readers that can be registered as waiting on a flow at the same time. Readers beyond this number fall back to
+    /// waiting on FlowState::syncCounter.
+    constexpr auto FLOW_WAITER_SLOT_COUNT = std::size_t{64};
+
+    /// The value of FlowWaiterSlot::condition while the slot is not claimed by any waiter.
+    constexpr auto FLOW_WAITER_SLOT_FREE = ~std::uint64_t{0};
+
+    /// The largest grain index that can be encoded in a FlowWaiterSlot::condition.
+    constexpr auto FLOW_WAITER_MAX_INDEX = (std::uint64_t{1} << 48U) - 2U;
+
+    /// The longest time a reader that can not announce itself in FlowWaiters::syncWaiters sleeps on FlowState::syncCounter before
+    /// checking it again, for as long as writers may not know about it yet.
+    constexpr auto UNANNOUNCED_WAIT_INTERVAL = Duration{1'000'000};
+
+    /// How often writers check whether readers holding an UnannouncedReaderLock are present.
+    constexpr auto UNANNOUNCED_READER_CHECK_INTERVAL = Duration{100'000'000};
+
+    /// How long after taking an UnannouncedReaderLock a reader has to check FlowState::syncCounter on its own. Writers are bound to
+    /// have noticed the lock by then, and wake up readers on every commit from that point on.
+    constexpr auto UNANNOUNCED_READER_GRACE_PERIOD = 2 * UNANNOUNCED_READER_CHECK_INTERVAL;
+
+    ///
+    /// A single waiter slot. Each slot occupies its own cache line, so that waiters registering themselves don't contend with each
+    /// other.
+    ///
+    struct alignas(64) FlowWaiterSlot
+    {
+        /// The grain index the waiter is waiting for in the upper 48 bits and the minimum number of valid slices it needs in the
+        /// lower 16 bits, or FLOW_WAITER_SLOT_FREE. A single word, so that writers always observe a consistent condition.
+        std::uint64_t condition;
+        /// Futex word the waiter sleeps on. Incremented by writers whenever they satisfy the condition.
+        std::uint32_t wakeCounter;
+    };
+
+    ///
+    /// Shared memory structure stored in the 'waiters' file of a flow. It is mapped writable by all readers of the flow, which
+    /// register the grain and slice they are waiting for before going to sleep. Writers only wake the waiters whose condition was
+    /// satisfied by a commit, instead of all readers blocked on FlowState::syncCounter. Readers that do sleep on the sync counter
+    /// announce themselves in 'syncWaiters', which allows writers to skip the wake-up system call if nobody is listening.
+    ///
+    struct FlowWaiters
+    {
+        std::uint32_t version;
+        /// One past the highest slot index that was ever claimed. Bounds the number of slots writers have to scan.
+        std::uint32_t slotsInUse;
+        /// The number of readers currently sleeping on FlowState::syncCounter.
+        std::uint32_t syncWaiters;
+
+        FlowWaiterSlot slots[FLOW_WAITER_SLOT_COUNT];
+    };
+
+    ///
+    /// The registration of a single blocking wait for a grain. Claims a slot on construction and releases it on destruction.
+    ///
+    class MXL_EXPORT GrainWaiter
+    {
+    public:
+        /**
+         * Register a wait for the grain at the specified index to have at least the specified number of valid slices. The
+         * registration is published before the constructor returns, so a commit that happens afterwards is guaranteed to wake
+         * the waiter. Registration fails if all slots are taken, or the index can not be represented.
+         */
+        GrainWaiter(FlowWaiters& waiters, std::uint64_t index, std::uint16_t minValidSlices) noexcept;
+        ~GrainWaiter();
+
+        GrainWaiter(GrainWaiter const&) = delete;
+        GrainWaiter& operator=(GrainWaiter const&) = delete;
+
+        /** Return whether the wait was registered successfully. */
+        [[nodiscard]]
+        bool isRegistered() const noexcept;
+
+        /** Return the futex word to sleep on, which is only valid if the wait was registered. */
+        [[nodiscard]]
+        std::uint32_t const* wakeCounter() const noexcept;
+
+    private:
+        FlowWaiterSlot* _slot;
+    };
+
+    ///
+    /// A shared advisory lock on the 'waiters' file of a flow, held by readers that can not map the waiters segment writable. These
+    /// readers can not announce themselves in FlowWaiters::syncWaiters, so the lock tells writers not to skip waking up readers
+    /// sleeping on FlowState::syncCounter. Taking the lock only requires read access to the file.
+    ///
+    class MXL_EXPORT UnannouncedReaderLock
+    {
+    public:
+        /** Create an instance that doesn't hold a lock. */
+        constexpr UnannouncedReaderLock() noexcept;
+
+        /**
+         * Open the waiters file and take a shared lock on it.
+         *
+         * \param[in] waitersFilePath The path of the waiters file.
+         * \throws std::system_error If the file could not be opened or locked.
+         */
+        explicit UnannouncedReaderLock(char const* waitersFilePath);
+
+        UnannouncedReaderLock(UnannouncedReaderLock&& other) noexcept;
+        UnannouncedReaderLock& operator=(UnannouncedReaderLock&& other) noexcept;
+        ~UnannouncedReaderLock();
+
+        UnannouncedReaderLock(UnannouncedReaderLock const&) = delete;
+        UnannouncedReaderLock& operator=(UnannouncedReaderLock const&) = delete;
+
+        /** Return whether the lock is held. */
+        [[nodiscard]]
+        constexpr bool isLocked() const noexcept;
+
+        /** Return the point in time (Clock::Realtime) by which all writers of the flow have noticed the lock. */
+        [[nodiscard]]
+        constexpr Timepoint noticedBy() const noexcept;
+
+    private:
+        int _fd;
+        Timepoint _noticedBy;
+    };
+
+    ///
+    /// Used by writers to find out whether readers holding an UnannouncedReaderLock on a flow are present.
+    ///
+    class MXL_EXPORT UnannouncedReaderProbe
+    {
+    public:
+        /** Create an instance that assumes that such readers are always present. */
+        constexpr UnannouncedReaderProbe() noexcept;
+
+        /**
+         * Open the waiters file to probe its lock. If the file can not be opened, the probe assumes that such readers are always
+         * present.
+         *
+         * \param[in] waitersFilePath The path of the waiters file.
+         */
+        explicit UnannouncedReaderProbe(char const* waitersFilePath) noexcept;
+
+        UnannouncedReaderProbe(UnannouncedReaderProbe&& other) noexcept;
+        UnannouncedReaderProbe& operator=(UnannouncedReaderProbe&& other) noexcept;
+        ~UnannouncedReaderProbe();
+
+        UnannouncedReaderProbe(UnannouncedReaderProbe const&) = delete;
+        UnannouncedReaderProbe& operator=(UnannouncedReaderProbe const&) = delete;
+
+        /**
+         * Return whether readers holding an UnannouncedReaderLock may be present. The lock is probed at most once per
+         * UNANNOUNCED_READER_CHECK_INTERVAL, the result of the last probe is returned in between.
+         *
+         * \param[in] now The current time, from any clock as long as it is always the same.
+         */
+        [[nodiscard]]
+        bool arePresent(Timepoint now) noexcept;
+
+    private:
+        int _fd;
+        Timepoint _nextCheck;
+        bool _present;
+    };
+
+    /**
+     * Wake the registered waiters whose conditions are satisfied by the commit of the specified grain. Must be called after the
+     * grain info and the head index of the flow have been published.
+     *
+     * \return The number of waiters that were woken.
+     */
+    MXL_EXPORT
+    std::size_t wakeGrainWaiters(FlowWaiters& waiters, std::uint64_t index, mxlGrainInfo const& info) noexcept;
+
+    /**
+     * Wake all registered waiters, regardless of what they are waiting for.
+     */
+    MXL_EXPORT
+    void wakeAllGrainWaiters(FlowWaiters& waiters) noexcept;
+
+    /**
+     * Wake the readers sleeping on the sync counter of a flow. Must be called after the sync counter has been incremented.
+     *
+     * \param[in] state The state of the flow.
+     * \param[in] waiters The waiters segment of the flow, or the null pointer if the flow doesn't provide one or readers that can not
+     *      announce themselves in it may be present.
+     * \return false if the wake-up was skipped, because no reader announced that it is sleeping.
+     */
+    MXL_EXPORT
+    bool wakeSyncWaiters(FlowState const& state, FlowWaiters const* waiters) noexcept;
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    constexpr UnannouncedReaderLock::UnannouncedReaderLock() noexcept
+        : _fd{-1}
+        , _noticedBy{}
+    {}
+
+    constexpr bool UnannouncedReaderLock::isLocked() const noexcept
+    {
+        return _fd != -1;
+    }
+
+    constexpr Timepoint UnannouncedReaderLock::noticedBy() const noexcept
+    {
+        return _noticedBy;
+    }
+
+    constexpr UnannouncedReaderProbe::UnannouncedReaderProbe() noexcept
+        : _fd{-1}
+        , _nextCheck{}
+        , _present{true}
+    {}
+}
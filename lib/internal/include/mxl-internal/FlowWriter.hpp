@@ -9,6 +9,7 @@
 #include <mxl/mxl.h>
 #include "mxl-internal/DomainWatcher.hpp"
 #include "mxl-internal/FlowData.hpp"
+#include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
@@ -22,6 +23,14 @@ namespace mxl::lib
         [[nodiscard]]
         uuids::uuid const& getId() const;
 
+        /**
+         * Accessor for the kind of flow written by this writer, which allows
+         * the C API to dispatch to the discrete or continuous interface with
+         * a static_cast instead of a dynamic_cast.
+         */
+        [[nodiscard]]
+        FlowKind getKind() const noexcept;
+
         /**
          * Accessor for the underlying flow data.
          * The flow writer must first open the flow before invoking this method.
@@ -84,11 +93,37 @@ namespace mxl::lib
         [[nodiscard]]
         bool checkPermissions() const;
 
-        FlowWriter(uuids::uuid&& flowId, std::filesystem::path const& domain);
-        FlowWriter(uuids::uuid const& flowId, std::filesystem::path const& domain);
+        /**
+         * Record a commit that readers are notified about and publish the
+         * resulting readiness hints (nextCommitTime and commitInterval) in
+         * the runtime info of the flow.
+         *
+         * \param runtime The runtime info of the flow to update.
+         * \param now The TAI time of the commit.
+         */
+        void publishCommitCadence(mxlFlowRuntimeInfo& runtime, Timepoint now) noexcept;
+
+        FlowWriter(FlowKind kind, uuids::uuid&& flowId, std::filesystem::path const& domain);
+        FlowWriter(FlowKind kind, uuids::uuid const& flowId, std::filesystem::path const& domain);
 
     private:
+        FlowKind _kind;
         uuids::uuid _flowId;
         std::filesystem::path _domain;
+        /** TAI time of the previous commit recorded by publishCommitCadence(). */
+        Timepoint _lastCommitTime;
+        /** Exponentially weighted moving average of the time between commits in nanoseconds, 0 if unknown. */
+        std::int64_t _commitInterval;
+        /** The number of consecutive commit intervals that were discarded as outliers. */
+        std::uint32_t _cadenceOutliers;
     };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    inline FlowKind FlowWriter::getKind() const noexcept
+    {
+        return _kind;
+    }
 }
@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
 #include <mxl/rational.h>
 #include "Timing.hpp"
 
@@ -32,4 +37,272 @@ namespace mxl::lib
         }
         return {};
     }
+
+    /**
+     * Divides 64-bit unsigned dividends by a fixed divisor using a precomputed
+     * 128-bit reciprocal instead of a hardware division.
+     *
+     * With c = ceil(2^128 / d), floor(n * c / 2^128) == floor(n / d) for all
+     * 64-bit n and d (Lemire, Kaser and Kurz, "Faster Remainder by Direct
+     * Computation"). The reciprocal is stored as c - 1, so that a divisor of
+     * one does not need special treatment.
+     */
+    class ConstantDivisor
+    {
+    public:
+        constexpr ConstantDivisor() noexcept;
+        constexpr explicit ConstantDivisor(std::uint64_t divisor) noexcept;
+
+        [[nodiscard]]
+        constexpr std::uint64_t divisor() const noexcept;
+
+        [[nodiscard]]
+        constexpr std::uint64_t divide(std::uint64_t dividend) const noexcept;
+
+    private:
+        std::uint64_t _divisor;
+        std::uint64_t _reciprocalLow;
+        std::uint64_t _reciprocalHigh;
+    };
+
+    /**
+     * Converts between timestamps and indices of a fixed edit rate.
+     *
+     * All constants that do not depend on the converted value are computed
+     * once on construction. For positive rates whose reduced terms are small
+     * enough (which includes all broadcast video and audio rates) the
+     * conversions only use multiplications and shifts, and yield exactly the
+     * same results as timestampToIndex() and indexToTimestamp(). All other
+     * rates and negative timestamps fall back to these functions.
+     */
+    class RateConverter
+    {
+    public:
+        /** Construct a converter for an invalid edit rate. */
+        constexpr RateConverter() noexcept;
+        constexpr explicit RateConverter(mxlRational const& editRate) noexcept;
+
+        [[nodiscard]]
+        constexpr mxlRational const& editRate() const noexcept;
+
+        /**
+         * \return true if the conversions of this converter avoid 128-bit
+         *      divisions for the edit rate it was constructed for.
+         */
+        [[nodiscard]]
+        constexpr bool isAccelerated() const noexcept;
+
+        /** \see mxl::lib::timestampToIndex() */
+        [[nodiscard]]
+        constexpr std::uint64_t timestampToIndex(Timepoint timestamp) const noexcept;
+
+        /** \see mxl::lib::indexToTimestamp() */
+        [[nodiscard]]
+        constexpr Timepoint indexToTimestamp(std::uint64_t index) const noexcept;
+
+        /**
+         * Convert timestamps in nanoseconds since the epoch to indices.
+         * Converts min(timestamps.size(), indices.size()) values.
+         */
+        constexpr void timestampsToIndices(std::span<std::uint64_t const> timestamps, std::span<std::uint64_t> indices) const noexcept;
+
+        /**
+         * Convert indices to timestamps in nanoseconds since the epoch.
+         * Converts min(indices.size(), timestamps.size()) values.
+         */
+        constexpr void indicesToTimestamps(std::span<std::uint64_t const> indices, std::span<std::uint64_t> timestamps) const noexcept;
+
+    private:
+        [[nodiscard]]
+        constexpr std::uint64_t fastTimestampToIndex(std::uint64_t timestamp) const noexcept;
+
+        [[nodiscard]]
+        constexpr std::uint64_t fastIndexToTimestamp(std::uint64_t index) const noexcept;
+
+    private:
+        mxlRational _editRate;
+
+        // With g = gcd(N, 10^9 * D), A = N / g and B = 10^9 * D / g the index
+        // of a timestamp t is floor((2 * t * A + B) / (2 * B)). Splitting t
+        // into q * B + r turns this into q * A + floor((2 * r * A + B) / (2 * B)).
+        std::uint64_t _indicesPerPeriod;
+        ConstantDivisor _timestampPeriod;
+        ConstantDivisor _roundedTimestampPeriod;
+
+        // With g = gcd(N, 10^9 * D), P = 10^9 * D / g and Q = N / g the
+        // timestamp of an index i is floor((i * 10^9 * D + floor(N / 2)) / N).
+        // Splitting i into q * Q + r turns this into
+        // q * P + floor((r * P * g + floor(N / 2)) / N).
+        std::uint64_t _nanosecondsPerPeriod;
+        std::uint64_t _remainderScale;
+        std::uint64_t _roundingOffset;
+        ConstantDivisor _indexPeriod;
+        ConstantDivisor _numerator;
+
+        bool _fastTimestampToIndex;
+        bool _fastIndexToTimestamp;
+    };
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    constexpr ConstantDivisor::ConstantDivisor() noexcept
+        : ConstantDivisor{1U}
+    {}
+
+    constexpr ConstantDivisor::ConstantDivisor(std::uint64_t divisor) noexcept
+        : _divisor{divisor}
+        , _reciprocalLow{}
+        , _reciprocalHigh{}
+    {
+        auto const reciprocal = ~__uint128_t{0} / divisor;
+        _reciprocalLow = static_cast<std::uint64_t>(reciprocal);
+        _reciprocalHigh = static_cast<std::uint64_t>(reciprocal >> 64);
+    }
+
+    constexpr std::uint64_t ConstantDivisor::divisor() const noexcept
+    {
+        return _divisor;
+    }
+
+    constexpr std::uint64_t ConstantDivisor::divide(std::uint64_t dividend) const noexcept
+    {
+        // Upper 64 bits of dividend * (reciprocal + 1) >> 64, without overflowing any of the intermediates.
+        auto const low = (__uint128_t{_reciprocalLow} * dividend + dividend) >> 64;
+        return static_cast<std::uint64_t>((__uint128_t{_reciprocalHigh} * dividend + low) >> 64);
+    }
+
+    constexpr RateConverter::RateConverter() noexcept
+        : RateConverter{mxlRational{0, 0}}
+    {}
+
+    constexpr RateConverter::RateConverter(mxlRational const& editRate) noexcept
+        : _editRate{editRate}
+        , _indicesPerPeriod{}
+        , _timestampPeriod{}
+        , _roundedTimestampPeriod{}
+        , _nanosecondsPerPeriod{}
+        , _remainderScale{}
+        , _roundingOffset{}
+        , _indexPeriod{}
+        , _numerator{}
+        , _fastTimestampToIndex{false}
+        , _fastIndexToTimestamp{false}
+    {
+        constexpr auto maxValue = __uint128_t{std::numeric_limits<std::uint64_t>::max()};
+
+        if ((editRate.numerator <= 0) || (editRate.denominator <= 0) ||
+            (__uint128_t{static_cast<std::uint64_t>(editRate.denominator)} * 1'000'000'000U > maxValue))
+        {
+            return;
+        }
+
+        auto const numerator = static_cast<std::uint64_t>(editRate.numerator);
+        auto const nanoseconds = static_cast<std::uint64_t>(editRate.denominator) * 1'000'000'000U;
+        auto const gcd = std::gcd(numerator, nanoseconds);
+        auto const reducedNumerator = numerator / gcd;
+        auto const reducedNanoseconds = nanoseconds / gcd;
+
+        // 2 * r * A + B < (2 * A + 1) * B must not overflow.
+        if ((2 * __uint128_t{reducedNumerator} + 1) * reducedNanoseconds <= maxValue)
+        {
+            _indicesPerPeriod = reducedNumerator;
+            _timestampPeriod = ConstantDivisor{reducedNanoseconds};
+            _roundedTimestampPeriod = ConstantDivisor{2 * reducedNanoseconds};
+            _fastTimestampToIndex = true;
+        }
+
+        // r * P * g + floor(N / 2) < (P + 1) * N must not overflow.
+        if ((__uint128_t{reducedNanoseconds} + 1) * numerator <= maxValue)
+        {
+            _nanosecondsPerPeriod = reducedNanoseconds;
+            _remainderScale = reducedNanoseconds * gcd;
+            _roundingOffset = numerator / 2;
+            _indexPeriod = ConstantDivisor{reducedNumerator};
+            _numerator = ConstantDivisor{numerator};
+            _fastIndexToTimestamp = true;
+        }
+    }
+
+    constexpr mxlRational const& RateConverter::editRate() const noexcept
+    {
+        return _editRate;
+    }
+
+    constexpr bool RateConverter::isAccelerated() const noexcept
+    {
+        return _fastTimestampToIndex && _fastIndexToTimestamp;
+    }
+
+    constexpr std::uint64_t RateConverter::fastTimestampToIndex(std::uint64_t timestamp) const noexcept
+    {
+        auto const periods = _timestampPeriod.divide(timestamp);
+        auto const remainder = timestamp - periods * _timestampPeriod.divisor();
+        return periods * _indicesPerPeriod + _roundedTimestampPeriod.divide(2 * remainder * _indicesPerPeriod + _timestampPeriod.divisor());
+    }
+
+    constexpr std::uint64_t RateConverter::fastIndexToTimestamp(std::uint64_t index) const noexcept
+    {
+        auto const periods = _indexPeriod.divide(index);
+        auto const remainder = index - periods * _indexPeriod.divisor();
+        return periods * _nanosecondsPerPeriod + _numerator.divide(remainder * _remainderScale + _roundingOffset);
+    }
+
+    constexpr std::uint64_t RateConverter::timestampToIndex(Timepoint timestamp) const noexcept
+    {
+        if (_fastTimestampToIndex && (timestamp.value >= 0))
+        {
+            return fastTimestampToIndex(static_cast<std::uint64_t>(timestamp.value));
+        }
+        return mxl::lib::timestampToIndex(_editRate, timestamp);
+    }
+
+    constexpr Timepoint RateConverter::indexToTimestamp(std::uint64_t index) const noexcept
+    {
+        if (_fastIndexToTimestamp)
+        {
+            return Timepoint{static_cast<Timepoint::value_type>(fastIndexToTimestamp(index))};
+        }
+        return mxl::lib::indexToTimestamp(_editRate, index);
+    }
+
+    constexpr void RateConverter::timestampsToIndices(std::span<std::uint64_t const> timestamps, std::span<std::uint64_t> indices) const noexcept
+    {
+        auto const count = std::min(timestamps.size(), indices.size());
+        if (_fastTimestampToIndex)
+        {
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                auto const timestamp = Timepoint{static_cast<Timepoint::value_type>(timestamps[i])};
+                indices[i] = (timestamp.value >= 0) ? fastTimestampToIndex(timestamps[i]) : mxl::lib::timestampToIndex(_editRate, timestamp);
+            }
+        }
+        else
+        {
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                indices[i] = mxl::lib::timestampToIndex(_editRate, Timepoint{static_cast<Timepoint::value_type>(timestamps[i])});
+            }
+        }
+    }
+
+    constexpr void RateConverter::indicesToTimestamps(std::span<std::uint64_t const> indices, std::span<std::uint64_t> timestamps) const noexcept
+    {
+        auto const count = std::min(indices.size(), timestamps.size());
+        if (_fastIndexToTimestamp)
+        {
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                timestamps[i] = fastIndexToTimestamp(indices[i]);
+            }
+        }
+        else
+        {
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                timestamps[i] = static_cast<std::uint64_t>(mxl::lib::indexToTimestamp(_editRate, indices[i]).value);
+            }
+        }
+    }
 }
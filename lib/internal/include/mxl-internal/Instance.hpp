@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <array>
 #include <atomic>
 #include <filesystem>
 #include <forward_list>
@@ -21,6 +23,7 @@
 #include "DomainWatcher.hpp"
 #include "FlowIoFactory.hpp"
 #include "FlowManager.hpp"
+#include "FlowNotifier.hpp"
 #include "FlowSynchronizationGroup.hpp"
 
 namespace mxl::lib
@@ -52,6 +55,9 @@ namespace mxl::lib
         ///
         /// \param[in] flowDef The json flow definition according to the NMOS Flow Resource json schema
         /// \param[in] options Additional options for flow creation
+        /// \throws std::invalid_argument If the options ask for a different
+        ///     channel mapping than the existing writer of a continuous flow
+        ///     was created with.
         std::tuple<mxlFlowConfigInfo, FlowWriter*, bool> createFlowWriter(std::string const& flowDef, std::optional<std::string> options = {});
 
     public:
@@ -64,11 +70,17 @@ namespace mxl::lib
         /// Create a FlowReader or obtain an additional reference to a
         /// previously created FlowReader.
         /// \param[in] flowId The id of the flow to obtain a reader for
+        /// \param[in] options Optional reader options as a JSON object. Only
+        ///     applied if a new reader is created, additional references to an
+        ///     existing reader keep its configuration.
         /// \return A pointer to the created flow reader.
+        /// \throws std::invalid_argument If the options ask for a different
+        ///     channel mapping than the existing reader of a continuous flow
+        ///     was created with.
         /// \note Please note that each successful call to this method must be
         ///     paired with a corresponding call to releaseReader().
         ///
-        FlowReader* getFlowReader(std::string const& flowId);
+        FlowReader* getFlowReader(std::string const& flowId, std::optional<std::string> const& options = std::nullopt);
 
         ///
         /// Release a reference to a FlowReader in order to ultimately free all
@@ -79,6 +91,19 @@ namespace mxl::lib
         ///
         void releaseReader(FlowReader* reader);
 
+        ///
+        /// Arm the wait handle of a reader, starting the notifier thread of
+        /// this instance if necessary. See FlowNotifier::arm() for details.
+        ///
+        /// \param[in] reader A reader previously obtained by a call to
+        ///     getFlowReader().
+        /// \param[in] index The index of the grain or sample to wait for.
+        /// \param[in] minValidSlices The number of valid slices to wait for.
+        /// \return The file descriptor of the wait handle of the reader, which
+        ///     is closed once the last reference to the reader is released.
+        ///
+        int getWaitHandle(FlowReader const& reader, std::uint64_t index, std::uint16_t minValidSlices);
+
     public:
         ///
         /// Release a reference to a FlowWriter in order to ultimately free all
@@ -148,7 +173,39 @@ namespace mxl::lib
             std::uint64_t mutable _refCount;
         };
 
+        /// The number of shards the registry of readers and writers is split into.
+        static constexpr auto REGISTRY_SHARD_COUNT = std::size_t{16};
+
+        ///
+        /// The part of the registry of readers and writers that holds the
+        /// flows whose ids hash to it. Each shard has its own lock, so that
+        /// opening and releasing flows only contends with operations on the
+        /// few other flows that share the shard.
+        ///
+        struct RegistryShard
+        {
+            /// Serializes creating and deleting the flows of writers in this
+            /// shard. Held while doing file system work, so must never be
+            /// acquired while holding the lock of the maps.
+            std::mutex writerMutex;
+            /// Protects the maps
+            std::mutex mutex;
+            /// Maps flow uuids to flow readers.
+            std::map<uuids::uuid, RefCounted<FlowReader>> readers;
+            /// Maps the uuids of continuous flows to the channel mapping their
+            /// readers were created with.
+            std::map<uuids::uuid, ChannelMapping> readerChannelMappings;
+            /// Maps flow uuids to flow writers.
+            std::map<uuids::uuid, RefCounted<FlowWriter>> writers;
+            /// Maps the uuids of continuous flows to the channel mapping their
+            /// writers were created with.
+            std::map<uuids::uuid, ChannelMapping> writerChannelMappings;
+        };
+
     private:
+        /// Get the shard of the registry that is responsible for the specified flow.
+        RegistryShard& shardFor(uuids::uuid const& id) noexcept;
+
         std::pair<std::unique_ptr<FlowData>, bool> createOrOpenDiscreteFlowData(std::string const& flowDef, FlowParser const&,
             FlowOptionsParser const&);
         std::pair<std::unique_ptr<FlowData>, bool> createOrOpenContinuousFlowData(std::string const& flowDef, FlowParser const&,
@@ -168,23 +225,31 @@ namespace mxl::lib
         /// The I/O factor used to delegate the creation of readers and writers
         std::unique_ptr<FlowIoFactory> _flowIoFactory;
 
-        /// Maps flow uuids to flow readers.
-        std::map<uuids::uuid, RefCounted<FlowReader>> _readers;
-        /// Maps flow uuids to flow writers.
-        std::map<uuids::uuid, RefCounted<FlowWriter>> _writers;
-
-        /// Protects the maps
-        std::mutex _mutex;
+        /// The readers and writers of this instance, sharded by flow id.
+        std::array<RegistryShard, REGISTRY_SHARD_COUNT> _registry;
 
+        /// Protects the set of synchronization groups
+        std::mutex _syncGroupsMutex;
         /// The set of active flow synchronization groups
         std::forward_list<FlowSynchronizationGroup> _syncGroups;
 
+        /// Protects the creation of the notifier
+        std::mutex _notifierMutex;
+        /// Signals the wait handles of readers. Only created once the first wait handle is requested.
+        std::unique_ptr<FlowNotifier> _notifier;
+
         /// For future use.
         std::string _options;
 
         /// Ring buffer history duration in nanoseconds
         std::uint64_t _historyDuration;
 
+        /// Whether discrete flows created by this instance provide a reader heartbeat segment
+        bool _readerHeartbeats;
+
+        /// Whether the grains of discrete flows created by this instance should be backed by huge pages
+        bool _hugePages;
+
         DomainWatcher::ptr _watcher;
 
         std::atomic_bool _stopping;
@@ -199,6 +264,22 @@ namespace mxl::lib
     /// Utility function to convert from a C mxlFlowWriter handle to a C++ FlowWriter instance.
     FlowWriter* to_FlowWriter(mxlFlowWriter writer) noexcept;
 
+    /// Utility function to convert from a C mxlFlowReader handle to a C++ DiscreteFlowReader instance.
+    /// Returns nullptr if the handle is null or refers to a reader of a continuous flow.
+    DiscreteFlowReader* to_DiscreteFlowReader(mxlFlowReader reader) noexcept;
+
+    /// Utility function to convert from a C mxlFlowReader handle to a C++ ContinuousFlowReader instance.
+    /// Returns nullptr if the handle is null or refers to a reader of a discrete flow.
+    ContinuousFlowReader* to_ContinuousFlowReader(mxlFlowReader reader) noexcept;
+
+    /// Utility function to convert from a C mxlFlowWriter handle to a C++ DiscreteFlowWriter instance.
+    /// Returns nullptr if the handle is null or refers to a writer of a continuous flow.
+    DiscreteFlowWriter* to_DiscreteFlowWriter(mxlFlowWriter writer) noexcept;
+
+    /// Utility function to convert from a C mxlFlowWriter handle to a C++ ContinuousFlowWriter instance.
+    /// Returns nullptr if the handle is null or refers to a writer of a discrete flow.
+    ContinuousFlowWriter* to_ContinuousFlowWriter(mxlFlowWriter writer) noexcept;
+
     /// Utility function to convert from a C mxlFlowSynchronizationGroup handle to a C++ FlowSynchronizationGroup instance.
     FlowSynchronizationGroup* to_FlowSynchronizationGroup(mxlFlowSynchronizationGroup group) noexcept;
 
@@ -258,6 +339,30 @@ namespace mxl::lib
         return reinterpret_cast<FlowWriter*>(writer);
     }
 
+    inline DiscreteFlowReader* to_DiscreteFlowReader(mxlFlowReader reader) noexcept
+    {
+        auto const cppReader = to_FlowReader(reader);
+        return ((cppReader != nullptr) && (cppReader->getKind() == FlowKind::Discrete)) ? static_cast<DiscreteFlowReader*>(cppReader) : nullptr;
+    }
+
+    inline ContinuousFlowReader* to_ContinuousFlowReader(mxlFlowReader reader) noexcept
+    {
+        auto const cppReader = to_FlowReader(reader);
+        return ((cppReader != nullptr) && (cppReader->getKind() == FlowKind::Continuous)) ? static_cast<ContinuousFlowReader*>(cppReader) : nullptr;
+    }
+
+    inline DiscreteFlowWriter* to_DiscreteFlowWriter(mxlFlowWriter writer) noexcept
+    {
+        auto const cppWriter = to_FlowWriter(writer);
+        return ((cppWriter != nullptr) && (cppWriter->getKind() == FlowKind::Discrete)) ? static_cast<DiscreteFlowWriter*>(cppWriter) : nullptr;
+    }
+
+    inline ContinuousFlowWriter* to_ContinuousFlowWriter(mxlFlowWriter writer) noexcept
+    {
+        auto const cppWriter = to_FlowWriter(writer);
+        return ((cppWriter != nullptr) && (cppWriter->getKind() == FlowKind::Continuous)) ? static_cast<ContinuousFlowWriter*>(cppWriter) : nullptr;
+    }
+
     inline FlowSynchronizationGroup* to_FlowSynchronizationGroup(mxlFlowSynchronizationGroup group) noexcept
     {
         return reinterpret_cast<FlowSynchronizationGroup*>(group);
@@ -11,10 +11,14 @@ namespace mxl::lib
     constexpr auto const FLOW_DESCRIPTOR_FILE_NAME = "flow_def.json";
     constexpr auto const FLOW_DATA_FILE_NAME = "data";
     constexpr auto const FLOW_ACCESS_FILE_NAME = "access";
+    constexpr auto const FLOW_HEARTBEATS_FILE_NAME = "heartbeats";
+    constexpr auto const FLOW_WAITERS_FILE_NAME = "waiters";
     constexpr auto const GRAIN_DIRECTORY_NAME = "grains";
     constexpr auto const GRAIN_DATA_FILE_NAME_STEM = "data";
+    constexpr auto const GRAIN_SEGMENT_FILE_NAME = "segment";
     constexpr auto const CHANNEL_DATA_FILE_NAME = "channels";
     constexpr auto const DOMAIN_OPTIONS_FILE_NAME = "options.json";
+    constexpr auto const FLOW_POOL_DIRECTORY_NAME = ".mxl-pool";
 
     std::filesystem::path makeFlowDirectoryName(std::filesystem::path const& domain, std::string const& uuid);
 
@@ -27,17 +31,28 @@ namespace mxl::lib
     std::filesystem::path makeFlowAccessFilePath(std::filesystem::path const& flowDirectory);
     std::filesystem::path makelowAccessFilePath(std::filesystem::path const& domain, std::string const& uuid);
 
+    std::filesystem::path makeFlowHeartbeatsFilePath(std::filesystem::path const& flowDirectory);
+    std::filesystem::path makeFlowHeartbeatsFilePath(std::filesystem::path const& domain, std::string const& uuid);
+
+    std::filesystem::path makeFlowWaitersFilePath(std::filesystem::path const& flowDirectory);
+    std::filesystem::path makeFlowWaitersFilePath(std::filesystem::path const& domain, std::string const& uuid);
+
     std::filesystem::path makeGrainDirectoryName(std::filesystem::path const& flowDirectory);
     std::filesystem::path makeGrainDirectoryName(std::filesystem::path const& domain, std::string const& uuid);
 
     std::filesystem::path makeGrainDataFilePath(std::filesystem::path const& grainDirectory, unsigned int index);
     std::filesystem::path makeGrainDataFilePath(std::filesystem::path const& domain, std::string const& uuid, unsigned int index);
 
+    std::filesystem::path makeGrainSegmentFilePath(std::filesystem::path const& grainDirectory);
+    std::filesystem::path makeGrainSegmentFilePath(std::filesystem::path const& domain, std::string const& uuid);
+
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& flowDirectory);
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& domain, std::string const& uuid);
 
     std::filesystem::path makeDomainOptionsFilePath(std::filesystem::path const& domain);
 
+    std::filesystem::path makeFlowPoolDirectoryName(std::filesystem::path const& domain);
+
     /**************************************************************************/
     /* Inline implementation.                                                 */
     /**************************************************************************/
@@ -57,6 +72,16 @@ namespace mxl::lib
         return makeFlowAccessFilePath(makeFlowDirectoryName(domain, uuid));
     }
 
+    inline std::filesystem::path makeFlowHeartbeatsFilePath(std::filesystem::path const& domain, std::string const& uuid)
+    {
+        return makeFlowHeartbeatsFilePath(makeFlowDirectoryName(domain, uuid));
+    }
+
+    inline std::filesystem::path makeFlowWaitersFilePath(std::filesystem::path const& domain, std::string const& uuid)
+    {
+        return makeFlowWaitersFilePath(makeFlowDirectoryName(domain, uuid));
+    }
+
     inline std::filesystem::path makeGrainDirectoryName(std::filesystem::path const& domain, std::string const& uuid)
     {
         return makeGrainDirectoryName(makeFlowDirectoryName(domain, uuid));
@@ -67,6 +92,11 @@ namespace mxl::lib
         return makeGrainDataFilePath(makeGrainDirectoryName(domain, uuid), index);
     }
 
+    inline std::filesystem::path makeGrainSegmentFilePath(std::filesystem::path const& domain, std::string const& uuid)
+    {
+        return makeGrainSegmentFilePath(makeGrainDirectoryName(domain, uuid));
+    }
+
     inline std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& domain, std::string const& uuid)
     {
         return makeChannelDataFilePath(makeFlowDirectoryName(domain, uuid));
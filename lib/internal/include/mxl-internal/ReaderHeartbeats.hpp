@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/platform.h>
+#include "Timing.hpp"
+
+namespace mxl::lib
+{
+    /// The version of the reader heartbeat structs in shared memory that we expect and support.
+    constexpr auto READER_HEARTBEATS_VERSION = 1U;
+
+    /// The number of individual reader slots in the heartbeat segment of a flow. Readers beyond this number share slots.
+    constexpr auto READER_HEARTBEAT_SLOT_COUNT = std::size_t{64};
+
+    /// The minimum interval between two heartbeats stored by the same reader, and between two aggregations by the writer.
+    constexpr auto READER_HEARTBEAT_INTERVAL = Duration{10'000'000};
+
+    ///
+    /// A single reader heartbeat slot. Each slot occupies its own cache line, so that readers storing their heartbeats don't
+    /// contend with each other.
+    ///
+    struct alignas(64) ReaderHeartbeatSlot
+    {
+        /// Token identifying the reader that claimed this slot, or 0 if the slot is free.
+        std::uint64_t owner;
+        /// The TAI time in nanoseconds at which the reader last read from the flow.
+        std::uint64_t lastReadTime;
+    };
+
+    ///
+    /// Shared memory structure stored in the 'heartbeats' file of a flow. It is mapped writable by all readers of the flow,
+    /// which store their last read time in their own slot. The writer periodically aggregates the slots into
+    /// mxlFlowRuntimeInfo::lastReadTime when it commits, and readers and writers fold them into the flow info they return, which
+    /// removes the need for readers to touch the access file on every read.
+    ///
+    struct ReaderHeartbeats
+    {
+        std::uint32_t version;
+        /// One past the highest slot index that was ever claimed. Bounds the number of slots the writer has to scan.
+        std::uint32_t slotsInUse;
+
+        ReaderHeartbeatSlot slots[READER_HEARTBEAT_SLOT_COUNT];
+    };
+
+    ///
+    /// The heartbeat of a single reader. Claims a slot on construction and releases it on destruction.
+    ///
+    class MXL_EXPORT ReaderHeartbeat
+    {
+    public:
+        explicit ReaderHeartbeat(ReaderHeartbeats& heartbeats) noexcept;
+        ~ReaderHeartbeat();
+
+        ReaderHeartbeat(ReaderHeartbeat const&) = delete;
+        ReaderHeartbeat& operator=(ReaderHeartbeat const&) = delete;
+
+        /**
+         * Record that the reader just read from the flow. Consecutive calls within READER_HEARTBEAT_INTERVAL are
+         * coalesced, so this is cheap enough to be called on every read.
+         */
+        void beat() noexcept;
+
+    private:
+        ReaderHeartbeatSlot* _slot;
+        std::uint64_t _owner;
+        Timepoint _lastBeat;
+    };
+
+    /**
+     * Return the most recent heartbeat stored by any reader of the flow, in TAI nanoseconds, or 0 if no reader has ever read
+     * from the flow.
+     */
+    MXL_EXPORT
+    std::uint64_t aggregateReaderHeartbeats(ReaderHeartbeats const& heartbeats) noexcept;
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/flow.h>
+
+namespace mxl::lib
+{
+    /**
+     * Size in bytes of a sample in the specified format.
+     * @param format The format of interest.
+     * @param nativeWordSize The size in bytes of the samples stored in the flow.
+     * @return The size of a sample in bytes, or 0 if the samples of a flow with
+     *      the specified word size can not be converted to or from \p format.
+     */
+    std::size_t getSampleFormatSize(mxlSampleFormat format, std::size_t nativeWordSize) noexcept;
+
+    /**
+     * Transpose a matrix of equally sized words, so that word j of row i in the
+     * source ends up as word i of row j in the destination. Rows of the source and
+     * the destination are separated by the specified strides in bytes.
+     *
+     * Interleaving the planar channel buffers of a continuous flow is a transpose
+     * with one row per channel, deinterleaving is one with one row per frame.
+     */
+    void transposeWords(void const* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t rows, std::size_t cols,
+        std::size_t wordSize) noexcept;
+
+    /**
+     * Copy the samples described by a strided wrapped multi buffer slice into a
+     * buffer, interleaving the channels frame by frame and converting them to the
+     * specified format. The samples may be stored planar or interleaved.
+     * @param slices The samples to copy.
+     * @param wordSize The size in bytes of the samples stored in the flow.
+     * @param format The format to convert the samples to. Must be supported
+     *      according to getSampleFormatSize().
+     * @param flags A bitwise combination of MXL_SAMPLE_CONVERSION_FLAG_* values.
+     * @param ditherSeed Seed of the dither noise, so that consecutive reads of a
+     *      flow don't repeat the same noise.
+     * @param out The buffer to copy the samples to, large enough to hold all samples.
+     */
+    void interleaveSamples(mxlStridedWrappedMultiBufferSlice const& slices, std::size_t wordSize, mxlSampleFormat format, std::uint32_t flags,
+        std::uint64_t ditherSeed, void* out) noexcept;
+
+    /**
+     * Copy samples from a buffer, in which the channels are interleaved frame by
+     * frame, to the samples described by a mutable strided wrapped multi buffer
+     * slice, converting them from the specified format.
+     * @param in The buffer to copy the samples from, holding all samples.
+     * @param format The format of the samples in \p in. Must be supported
+     *      according to getSampleFormatSize().
+     * @param wordSize The size in bytes of the samples stored in the flow.
+     * @param slices The samples to copy to.
+     */
+    void deinterleaveSamples(void const* in, mxlSampleFormat format, std::size_t wordSize,
+        mxlMutableStridedWrappedMultiBufferSlice const& slices) noexcept;
+}
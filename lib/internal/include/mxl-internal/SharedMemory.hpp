@@ -26,6 +26,73 @@ namespace mxl::lib
         CREATE_READ_WRITE
     };
 
+    enum class PageMode
+    {
+        /// Map the segment with whatever page size the file system uses by default.
+        Default,
+        /// Ask the kernel to back the segment with transparent huge pages. Only effective on file systems that support them, such
+        /// as a tmpfs mounted with 'huge=within_size' or 'huge=advise'. Silently falls back to regular pages otherwise.
+        Huge,
+    };
+
+    /** Return the size in bytes of the regular pages of this system. */
+    MXL_EXPORT
+    std::size_t pageSize() noexcept;
+
+    /** Return the size in bytes of the huge pages that transparent huge pages are backed with. */
+    MXL_EXPORT
+    std::size_t hugePageSize() noexcept;
+
+    /** Round the specified size up to the next multiple of hugePageSize(). */
+    MXL_EXPORT
+    std::size_t roundUpToHugePageSize(std::size_t size) noexcept;
+
+    /**
+     * A mapping of consecutive, equally sized rings of a shared memory file, in which every ring is immediately followed by a second
+     * mapping of itself. Any window of up to the ring size, starting anywhere within a ring, is therefore contiguous in memory.
+     */
+    class MXL_EXPORT MirroredMapping
+    {
+    public:
+        constexpr MirroredMapping() noexcept;
+        constexpr MirroredMapping(MirroredMapping&& other) noexcept;
+        MirroredMapping(MirroredMapping const& other) = delete;
+
+        /**
+         * Map the specified number of consecutive rings at the beginning of a file twice each.
+         * \param fd The descriptor of the file to map.
+         * \param writable Whether to map the rings for writing.
+         * \param ringSize The size of a ring in bytes. Must be a multiple of the page size.
+         * \param ringCount The number of rings.
+         * \throw If the ring size is not a multiple of the page size or mapping the rings fails.
+         */
+        MirroredMapping(int fd, bool writable, std::size_t ringSize, std::size_t ringCount);
+
+        ~MirroredMapping();
+
+        MirroredMapping& operator=(MirroredMapping other) noexcept;
+
+        /** Return whether or not this instance currently represents a valid mapping. */
+        constexpr bool isValid() const noexcept;
+
+        /** Return the address of the first mapping of the first ring. */
+        constexpr void* data() noexcept;
+        constexpr void const* data() const noexcept;
+
+        /** Return the distance in bytes between the beginnings of two consecutive rings, which is twice the ring size. */
+        constexpr std::size_t ringStride() const noexcept;
+
+        constexpr void swap(MirroredMapping& other) noexcept;
+
+    private:
+        /** Pointer to the reserved address range holding all rings. */
+        void* _data;
+        /** The size of a ring in bytes. */
+        std::size_t _ringSize;
+        /** The number of rings. */
+        std::size_t _ringCount;
+    };
+
     class MXL_EXPORT SharedMemoryBase
     {
     public:
@@ -62,6 +129,26 @@ namespace mxl::lib
          */
         void touch();
 
+        /**
+         * Return whether the beginning of the mapping is actually backed by huge pages in the address space of this process.
+         * Faults in the first page of the mapping if necessary.
+         */
+        [[nodiscard]]
+        bool isHugePageBacked() const;
+
+        /**
+         * Map the pages in the specified range of the mapping into the address space of this process up front, so that accessing
+         * them later doesn't fault. Pages of writable mappings are allocated if necessary. The range is clamped to the mapping.
+         */
+        void prefault(std::size_t offset, std::size_t length) noexcept;
+
+        /**
+         * Map the rings of the underlying file a second time, such that every ring is followed by a mirror of itself.
+         * \see MirroredMapping
+         */
+        [[nodiscard]]
+        MirroredMapping mapMirrored(std::size_t ringSize, std::size_t ringCount) const;
+
         constexpr void swap(SharedMemoryBase& other) noexcept;
 
     protected:
@@ -76,9 +163,10 @@ namespace mxl::lib
          * \param path The memory mapping path
          * \param mode The memory mapping access mode
          * \param payloadSize The minimum expected size of the shared memory
+         * \param pageMode The kind of pages the mapping should preferably be backed with
          * \throw If opening or creating the shared memory segment fails.
          */
-        SharedMemoryBase(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode);
+        SharedMemoryBase(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode, PageMode pageMode = PageMode::Default);
 
         /** Destructor. */
         ~SharedMemoryBase();
@@ -151,7 +239,7 @@ namespace mxl::lib
         constexpr SharedMemorySegment() noexcept;
         constexpr SharedMemorySegment(SharedMemorySegment&& other) noexcept;
 
-        SharedMemorySegment(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode);
+        SharedMemorySegment(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode, PageMode pageMode = PageMode::Default);
 
         using SharedMemoryBase::cdata;
         using SharedMemoryBase::data;
@@ -180,9 +268,10 @@ namespace mxl::lib
          * \param path The memory mapping path
          * \param mode The memory mapping access mode
          * \param extraSize Add this size to the shared memory in addition to sizeof(T)
+         * \param pageMode The kind of pages the mapping should preferably be backed with
          * \return true on success. false on conflicts or failure to create resources on disk.
          */
-        SharedMemoryInstance(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode);
+        SharedMemoryInstance(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode, PageMode pageMode = PageMode::Default);
 
         SharedMemoryInstance& operator=(SharedMemoryInstance other) noexcept;
 
@@ -214,6 +303,59 @@ namespace mxl::lib
     /* Inline implementation.                                                 */
     /**************************************************************************/
 
+    constexpr MirroredMapping::MirroredMapping() noexcept
+        : _data{nullptr}
+        , _ringSize{0}
+        , _ringCount{0}
+    {}
+
+    constexpr MirroredMapping::MirroredMapping(MirroredMapping&& other) noexcept
+        : MirroredMapping{}
+    {
+        swap(other);
+    }
+
+    inline MirroredMapping& MirroredMapping::operator=(MirroredMapping other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    constexpr bool MirroredMapping::isValid() const noexcept
+    {
+        return (_data != nullptr);
+    }
+
+    constexpr void* MirroredMapping::data() noexcept
+    {
+        return _data;
+    }
+
+    constexpr void const* MirroredMapping::data() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr std::size_t MirroredMapping::ringStride() const noexcept
+    {
+        return 2U * _ringSize;
+    }
+
+    constexpr void MirroredMapping::swap(MirroredMapping& other) noexcept
+    {
+        // Workaround for std::swap not being declared constexpr in libstdc++ v10
+        constexpr auto const cx_swap = [](auto& lhs, auto& rhs) constexpr noexcept
+        {
+            auto temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        };
+
+        cx_swap(_data, other._data);
+        cx_swap(_ringSize, other._ringSize);
+        cx_swap(_ringCount, other._ringCount);
+    }
+
     constexpr SharedMemoryBase::SharedMemoryBase() noexcept
         : _fd{-1}
         , _mode{AccessMode::READ_ONLY}
@@ -298,8 +440,9 @@ namespace mxl::lib
         : SharedMemoryBase{std::move(other)}
     {}
 
-    inline SharedMemorySegment::SharedMemorySegment(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode)
-        : SharedMemoryBase{path, mode, payloadSize, lockMode}
+    inline SharedMemorySegment::SharedMemorySegment(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode,
+        PageMode pageMode)
+        : SharedMemoryBase{path, mode, payloadSize, lockMode, pageMode}
     {}
 
     inline SharedMemorySegment& SharedMemorySegment::operator=(SharedMemorySegment other) noexcept
@@ -329,8 +472,9 @@ namespace mxl::lib
     {}
 
     template<typename T>
-    inline SharedMemoryInstance<T>::SharedMemoryInstance(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode)
-        : SharedMemoryBase{path, mode, payloadSize + sizeof(T), lockMode}
+    inline SharedMemoryInstance<T>::SharedMemoryInstance(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode,
+        PageMode pageMode)
+        : SharedMemoryBase{path, mode, payloadSize + sizeof(T), lockMode, pageMode}
     {
         if (created())
         {
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <mxl/platform.h>
 #include "Timing.hpp"
 
 namespace mxl::lib
@@ -45,4 +49,187 @@ namespace mxl::lib
      */
     template<typename T>
     void wakeAll(T const* in_addr);
+
+    /**
+     * A memory address monitored by waitUntilAnyChanged(), along with the
+     * value it is expected to hold.
+     */
+    struct WaitTarget
+    {
+        /** The memory address to monitor. */
+        std::uint32_t const* address;
+        /** The initial value expected at address. */
+        std::uint32_t expected;
+    };
+
+    /** The largest number of addresses waitUntilAnyChanged() can monitor at once. */
+    constexpr auto MAX_WAIT_TARGETS = std::size_t{128};
+
+    /**
+     * Return whether the running kernel allows waitUntilAnyChanged() to wait
+     * on multiple addresses at once. This requires FUTEX_WAITV, which is
+     * available on Linux 5.16 and later.
+     */
+    MXL_EXPORT
+    bool isWaitOnMultipleSupported() noexcept;
+
+    /**
+     * Wait until the value at any of the specified addresses changes or the
+     * deadline expires. Must only be used if isWaitOnMultipleSupported()
+     * returns true.
+     *
+     * \param in_targets The addresses to monitor. At most MAX_WAIT_TARGETS.
+     * \param in_deadline Until when to wait. Timepoint is expected to come from Clock::Realtime.
+     * \return true if any value changed, false if timeout expired
+     */
+    MXL_EXPORT
+    bool waitUntilAnyChanged(std::span<WaitTarget const> in_targets, Timepoint in_deadline);
+
+    /**
+     * Describes how a waiter waits for a monitored value to change.
+     */
+    enum class WaitPolicy
+    {
+        /** Go to sleep in the kernel right away. */
+        Futex,
+        /** Spin for up to a fixed amount of time before going to sleep in the kernel. */
+        Spin,
+        /** Spin for an amount of time derived from how long previous waits took, before going to sleep in the kernel. */
+        Adaptive,
+    };
+
+    /**
+     * Statistics about the waits performed through a WaitStrategy.
+     */
+    struct WaitStatistics
+    {
+        /** The number of waits that found the value unchanged when they started. */
+        std::uint64_t waits;
+        /** The number of waits that observed a change while spinning. */
+        std::uint64_t spinWakeups;
+        /** The number of waits that observed a change after sleeping in the kernel. */
+        std::uint64_t futexWakeups;
+        /** The number of waits that reached their deadline without observing a change. */
+        std::uint64_t timeouts;
+        /** The number of wake-ups for which a wake-up latency could be measured. */
+        std::uint64_t latencySamples;
+        /** The sum of all measured wake-up latencies in nanoseconds. */
+        std::uint64_t totalWakeupLatency;
+        /** The largest measured wake-up latency in nanoseconds. */
+        std::uint64_t maxWakeupLatency;
+        /** The number of wake-ups after which the waiter still could not make progress and had to wait again. */
+        std::uint64_t wastedWakeups;
+    };
+
+    /**
+     * Implements a WaitPolicy on top of waitUntilChanged(), and keeps
+     * statistics about the waits it performed. Instances may be used by
+     * multiple threads concurrently, but must be configured before that.
+     */
+    class MXL_EXPORT WaitStrategy
+    {
+    public:
+        /** The spin duration used if none is specified explicitly. */
+        static constexpr auto DEFAULT_MAX_SPIN = Duration{20'000};
+
+        /**
+         * Create a strategy following WaitPolicy::Futex.
+         */
+        WaitStrategy() noexcept;
+
+        /**
+         * (Re-)configure the strategy.
+         *
+         * \param in_policy The policy to follow.
+         * \param in_maxSpin The longest amount of time to spin before going
+         *      to sleep. Ignored for WaitPolicy::Futex.
+         */
+        void configure(WaitPolicy in_policy, Duration in_maxSpin = DEFAULT_MAX_SPIN) noexcept;
+
+        [[nodiscard]]
+        WaitPolicy policy() const noexcept;
+
+        /**
+         * Limit how long a single sleep in the kernel may last, after which
+         * the monitored value is checked again. Needed by waiters that can
+         * not announce themselves to the modifying party, which may skip
+         * waking them up as a result.
+         *
+         * \param in_maxSleep The longest amount of time to sleep at once, or
+         *      a zero duration to sleep until the deadline.
+         * \param in_until Until when the limit applies. Timepoint is expected
+         *      to come from Clock::Realtime.
+         */
+        void limitSleep(Duration in_maxSleep, Timepoint in_until) noexcept;
+
+        /**
+         * Wait until *in_addr changes or the deadline expires.
+         *
+         * \param in_addr The memory address to monitor.
+         * \param in_expected The initial value expected at in_addr
+         * \param in_deadline Until when to wait. Timepoint is expected to come from Clock::Realtime.
+         * \param in_changeTime Optional pointer to a TAI timestamp in nanoseconds that the
+         *      modifying party updates before changing *in_addr. Used to measure the
+         *      latency between the change and this waiter noticing it.
+         * \param in_sleepers Optional pointer to a counter of sleeping waiters, which is
+         *      incremented for as long as this waiter sleeps in the kernel. Allows the
+         *      modifying party to skip waking up waiters if there are none.
+         * \param in_nextChangeTime Optional pointer to a TAI timestamp in nanoseconds at
+         *      which the modifying party expects to change *in_addr next, or 0 if unknown.
+         *      Policies that spin sleep in the kernel until shortly before that time
+         *      instead of spinning all the way, or going to sleep after spinning in vain.
+         * \return true if value changed, false if timeout expired
+         */
+        bool waitUntilChanged(std::uint32_t const* in_addr, std::uint32_t in_expected, Timepoint in_deadline,
+            std::uint64_t const* in_changeTime = nullptr, std::uint32_t* in_sleepers = nullptr, std::uint64_t const* in_nextChangeTime = nullptr);
+
+        /**
+         * Record that the waiter was woken up by a change, but found that the
+         * change did not allow it to make progress.
+         */
+        void recordWastedWakeup() noexcept;
+
+        /**
+         * Return a snapshot of the statistics gathered so far.
+         */
+        [[nodiscard]]
+        WaitStatistics statistics() const noexcept;
+
+    private:
+        /** Sleep in the kernel until *in_addr changes or the deadline expires, honouring the sleep limit. */
+        bool sleepUntilChanged(std::uint32_t const* in_addr, std::uint32_t in_expected, Timepoint in_deadline, std::uint32_t* in_sleepers) const;
+
+        /** Determine how long to spin before going to sleep, according to the policy. */
+        [[nodiscard]]
+        Duration spinBudget() const noexcept;
+
+        /**
+         * Determine until when to sleep before starting to spin, so that
+         * spinning starts the spin budget ahead of the next expected change.
+         * \return The time to sleep until, or in_now if there is no point in
+         *      sleeping first.
+         */
+        [[nodiscard]]
+        static Timepoint spinStart(Timepoint in_now, Duration in_budget, std::uint64_t const* in_nextChangeTime) noexcept;
+
+        /** Update the statistics after a wait that observed a change. */
+        void recordWakeup(Timepoint in_start, Timepoint in_end, bool in_spun, std::uint64_t const* in_changeTime) noexcept;
+
+    private:
+        WaitPolicy _policy;
+        Duration _maxSpin;
+        Duration _maxSleep;
+        Timepoint _maxSleepUntil;
+        /** Exponentially weighted moving average of the duration of successful waits in nanoseconds. */
+        std::atomic<std::int64_t> _averageWait;
+
+        std::atomic<std::uint64_t> _waits;
+        std::atomic<std::uint64_t> _spinWakeups;
+        std::atomic<std::uint64_t> _futexWakeups;
+        std::atomic<std::uint64_t> _timeouts;
+        std::atomic<std::uint64_t> _latencySamples;
+        std::atomic<std::uint64_t> _totalWakeupLatency;
+        std::atomic<std::uint64_t> _maxWakeupLatency;
+        std::atomic<std::uint64_t> _wastedWakeups;
+    };
 }
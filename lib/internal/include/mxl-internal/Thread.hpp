@@ -3,6 +3,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "Timing.hpp"
 
 namespace mxl::lib
@@ -45,4 +53,81 @@ namespace mxl::lib
          */
         int sleepUntil(Timepoint timepoint, Clock clock = Clock::Realtime) noexcept;
     }
+
+    /**
+     * Invoke the specified function once for every index in [0, count),
+     * spreading the invocations across up to maxThreads threads, one of which
+     * is the calling thread. Returns once all invocations have completed.
+     *
+     * \param[in] count The number of indices to invoke the function for.
+     * \param[in] maxThreads The maximum number of threads to use.
+     * \param[in] f The function to invoke with each index.
+     * \throws Rethrows the first exception thrown by any invocation, in which
+     *      case the indices that have not been started yet are skipped.
+     * \note Should starting additional threads fail, the threads that were
+     *      started, including the calling one, process all indices.
+     */
+    template<typename F>
+    void parallelFor(std::size_t count, std::size_t maxThreads, F&& f);
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    template<typename F>
+    void parallelFor(std::size_t count, std::size_t maxThreads, F&& f)
+    {
+        auto next = std::atomic<std::size_t>{0U};
+        auto errorMutex = std::mutex{};
+        auto error = std::exception_ptr{};
+
+        auto const work = [&]() noexcept
+        {
+            for (auto i = next.fetch_add(1U, std::memory_order_relaxed); i < count; i = next.fetch_add(1U, std::memory_order_relaxed))
+            {
+                try
+                {
+                    f(i);
+                }
+                catch (...)
+                {
+                    auto const lock = std::lock_guard{errorMutex};
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    next.store(count, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        auto threads = std::vector<std::thread>{};
+        auto const threadCount = std::min(count, maxThreads);
+        if (threadCount > 1U)
+        {
+            threads.reserve(threadCount - 1U);
+            try
+            {
+                while (threads.size() < threadCount - 1U)
+                {
+                    threads.emplace_back(work);
+                }
+            }
+            catch (std::system_error const&)
+            {
+                // Make do with the threads we got.
+            }
+        }
+
+        work();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
 }
@@ -45,6 +45,67 @@ namespace mxl::lib
     [[nodiscard]]
     Timepoint currentTime(Clock clock) noexcept;
 
+    /**
+     * The time source from which currentTime(Clock::TAI) is derived.
+     */
+    enum class TaiClockSource
+    {
+        /**
+         * Read the kernel TAI clock on every call. Depending on the kernel
+         * and the virtualization environment this may be a system call.
+         */
+        Kernel,
+
+        /**
+         * Read the realtime clock, which is vDSO accelerated on all common
+         * platforms, and add a periodically refreshed TAI offset.
+         */
+        Realtime,
+
+        /**
+         * Read the monotonic clock and add a periodically refreshed TAI
+         * offset. Unaffected by steps of the realtime clock until the next
+         * refresh of the offset.
+         */
+        Monotonic
+    };
+
+    /**
+     * The outcome of selecting a TAI clock source.
+     */
+    enum class TaiClockSourceStatus
+    {
+        /** The requested source is in effect. */
+        Selected,
+
+        /** The requested source does not track the kernel TAI clock closely enough and was not put into effect. */
+        Inaccurate,
+
+        /** A different source has already been selected for this process, which remains in effect. */
+        Conflicting
+    };
+
+    /**
+     * Select the source of currentTime(Clock::TAI) for the whole process.
+     * The source can only be selected once. Later requests for the same
+     * source succeed, while requests for a different one are rejected.
+     * It is safe to call this while other threads read the time.
+     *
+     * Derived sources are validated against the kernel TAI clock before they
+     * are put into effect. A source that fails validation is not considered
+     * selected. The offset of a derived source to the kernel TAI clock is
+     * refreshed about once per second by the first caller that observes the
+     * refresh to be due, which picks up leap second and clock step
+     * adjustments.
+     */
+    TaiClockSourceStatus setTaiClockSource(TaiClockSource source) noexcept;
+
+    /**
+     * \return The source of currentTime(Clock::TAI) currently in effect.
+     */
+    [[nodiscard]]
+    TaiClockSource getTaiClockSource() noexcept;
+
     /**
      * Return the current time in UTC.
      * \return The current time as a Timepoint in UTC.
@@ -2,11 +2,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl-internal/FlowData.hpp"
+#include <limits>
+#include <stdexcept>
+#include <fmt/format.h>
 
 namespace mxl::lib
 {
     FlowData::FlowData(char const* flowFilePath, AccessMode mode, LockMode lockMode)
         : _flow{flowFilePath, mode, 0U, lockMode}
+        , _waiters{}
+        , _unannouncedLock{}
+        , _unannouncedProbe{}
     {
         // see: https://en.cppreference.com/w/cpp/types/has_unique_object_representations.html
         static_assert(std::has_unique_object_representations_v<::mxlFlowInfo>,
@@ -56,4 +62,61 @@ namespace mxl::lib
     {
         return _flow.makeExclusive();
     }
+
+    void FlowData::openFlowWaiters(char const* waitersFilePath)
+    {
+        auto const mode = created() ? AccessMode::CREATE_READ_WRITE : AccessMode::READ_WRITE;
+        auto waiters = SharedMemoryInstance<FlowWaiters>{waitersFilePath, mode, 0U, LockMode::None};
+
+        if (waiters.created())
+        {
+            auto& shared = *waiters.get();
+            shared.version = FLOW_WAITERS_VERSION;
+            for (auto& slot : shared.slots)
+            {
+                slot.condition = FLOW_WAITER_SLOT_FREE;
+            }
+        }
+        else if (waiters.get()->version != FLOW_WAITERS_VERSION)
+        {
+            throw std::invalid_argument{
+                fmt::format("Unsupported flow waiters version: {}, supported version is: {}", waiters.get()->version, FLOW_WAITERS_VERSION)};
+        }
+
+        _waiters = std::move(waiters);
+
+        // Only writers have to know about readers that could not do the same.
+        if (accessMode() != AccessMode::READ_ONLY)
+        {
+            _unannouncedProbe = UnannouncedReaderProbe{waitersFilePath};
+        }
+    }
+
+    void FlowData::lockFlowWaiters(char const* waitersFilePath)
+    {
+        _unannouncedLock = UnannouncedReaderLock{waitersFilePath};
+    }
+
+    FlowWaiters const* FlowData::announcedFlowWaiters(Timepoint now) noexcept
+    {
+        if ((_waiters.get() == nullptr) || _unannouncedProbe.arePresent(now))
+        {
+            return nullptr;
+        }
+        return _waiters.get();
+    }
+
+    Timepoint FlowData::unannouncedUntil() const noexcept
+    {
+        if ((_waiters.get() != nullptr) || !hasFlowWaiters(flowInfo()->version))
+        {
+            // Either we announce ourselves, or writers of the flow don't skip waking us up in the first place.
+            return Timepoint{};
+        }
+        if (_unannouncedLock.isLocked())
+        {
+            return _unannouncedLock.noticedBy();
+        }
+        return Timepoint{std::numeric_limits<Timepoint::value_type>::max()};
+    }
 }
@@ -64,7 +64,10 @@ std::ostream& operator<<(std::ostream& os, mxlFlowInfo const& info)
     os << '\n'
        << '\t' << fmt::format("{: >20}: {}", "Head index", info.runtime.headIndex) << '\n'
        << '\t' << fmt::format("{: >20}: {}", "Last write time", info.runtime.lastWriteTime) << '\n'
-       << '\t' << fmt::format("{: >20}: {}", "Last read time", info.runtime.lastReadTime) << '\n';
+       << '\t' << fmt::format("{: >20}: {}", "Last read time", info.runtime.lastReadTime) << '\n'
+       << '\t' << fmt::format("{: >20}: {}", "Next commit time", info.runtime.nextCommitTime) << '\n'
+       << '\t' << fmt::format("{: >20}: {}", "Commit interval", info.runtime.commitInterval) << '\n'
+       << '\t' << fmt::format("{: >20}: {}", "Open head index", info.runtime.openHeadIndex) << '\n';
 
     return os;
 }
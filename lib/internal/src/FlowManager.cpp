@@ -2,21 +2,30 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl-internal/FlowManager.hpp"
+#include <atomic>
 #include <cstring>
+#include <algorithm>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <ios>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
 #include <system_error>
+#include <thread>
+#include <vector>
 #include <fcntl.h>
 #include <unistd.h>
+#include <fmt/format.h>
 #include <sys/stat.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
+#include "mxl-internal/FlowWaiters.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
 #include "mxl-internal/SharedMemory.hpp"
+#include "mxl-internal/Sync.hpp"
 #include "mxl-internal/Timing.hpp"
 #include "Deferred.hpp"
 #include "DynamicPointerCast.hpp"
@@ -25,6 +34,9 @@ namespace mxl::lib
 {
     namespace
     {
+        /// The prefix of the names of the directories created by createTemporaryFlowDirectory().
+        constexpr auto TEMPORARY_FLOW_DIRECTORY_PREFIX = std::string_view{".mxl-tmp-"};
+
         /**
          * Attempt to create a temporary directory to prepare a new flow.
          * The temporary name is structured in a way that prevents is from
@@ -39,7 +51,7 @@ namespace mxl::lib
          */
         std::filesystem::path createTemporaryFlowDirectory(std::filesystem::path const& base)
         {
-            auto pathBuffer = (base / ".mxl-tmp-XXXXXXXXXXXXXXXX").string();
+            auto pathBuffer = (base / fmt::format("{}XXXXXXXXXXXXXXXX", TEMPORARY_FLOW_DIRECTORY_PREFIX)).string();
             if (::mkdtemp(pathBuffer.data()) == nullptr)
             {
                 auto const error = errno;
@@ -120,6 +132,22 @@ namespace mxl::lib
             return result;
         }
 
+        /// The largest number of threads grains are allocated or prefaulted with.
+        constexpr auto MAX_ALLOCATION_THREADS = std::size_t{8};
+
+        /// Grains below this size are allocated by the calling thread alone, as starting threads would take longer than allocating them.
+        constexpr auto MIN_PARALLEL_GRAIN_SIZE = std::size_t{1024U * 1024U};
+
+        /// Return how many threads to allocate the grains of a flow with.
+        std::size_t allocationThreadCount(std::size_t grainCount, std::size_t grainPayloadSize) noexcept
+        {
+            if (grainPayloadSize < MIN_PARALLEL_GRAIN_SIZE)
+            {
+                return 1U;
+            }
+            return std::clamp<std::size_t>(std::min<std::size_t>(std::thread::hardware_concurrency(), grainCount), 1U, MAX_ALLOCATION_THREADS);
+        }
+
         mxlFlowRuntimeInfo initFlowRuntimeInfo()
         {
             auto result = mxlFlowRuntimeInfo{};
@@ -150,10 +178,283 @@ namespace mxl::lib
 
             return result;
         }
+
+        void openFlowWaiters(FlowData& flowData, std::filesystem::path const& flowDir)
+        {
+            // Flows that older SDK versions can open must be woken up the way these expect, so they don't come with the segment.
+            if (!hasFlowWaiters(flowData.flowInfo()->version))
+            {
+                return;
+            }
+
+            if (auto const waitersPath = makeFlowWaitersFilePath(flowDir); exists(waitersPath))
+            {
+                try
+                {
+                    flowData.openFlowWaiters(waitersPath.string().c_str());
+                }
+                catch (std::exception const& ex)
+                {
+                    // This is expected if the domain is on a read-only volume, or if we lack write permissions. Readers will
+                    // neither be able to register what they are waiting for, nor to announce that they are sleeping in this case.
+                    MXL_DEBUG("Could not open flow waiters '{}': {}", waitersPath.string(), ex.what());
+                }
+
+                if (flowData.flowWaiters() == nullptr)
+                {
+                    // Let writers know that they must not skip waking us up instead, which only takes read access.
+                    try
+                    {
+                        flowData.lockFlowWaiters(waitersPath.string().c_str());
+                    }
+                    catch (std::exception const& ex)
+                    {
+                        MXL_DEBUG("Could not lock flow waiters '{}': {}", waitersPath.string(), ex.what());
+                    }
+                }
+            }
+        }
+
+        /**
+         * Assign the identity of a flow to freshly prepared or pooled flow data. The flags the storage of the flow was prepared with
+         * are kept.
+         */
+        void stampFlow(FlowData& flowData, uuids::uuid const& flowId, mxlDataFormat format, mxlRational rate, std::uint32_t maxSyncBatchSizeHintOpt,
+            std::uint32_t maxCommitBatchSizeHintOpt, Timepoint creationStart)
+        {
+            auto& info = *flowData.flowInfo();
+            auto const flags = info.config.common.flags;
+            info.config.common = initCommonFlowConfigInfo(flowId, format, rate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt);
+            info.config.common.flags = flags;
+            info.config.common.creationTime = creationStart.value;
+
+            info.runtime = initFlowRuntimeInfo();
+        }
+
+        /**
+         * Create all files of a discrete flow below the specified directory, except for the flow definition. The identity of the flow is
+         * left blank, see stampFlow().
+         */
+        std::unique_ptr<DiscreteFlowData> prepareDiscreteFlow(std::filesystem::path const& flowDir, std::size_t grainCount,
+            std::size_t grainPayloadSize, std::size_t grainNumOfSlices, std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN> const& grainSliceLengths,
+            DiscreteFlowLayout layout, bool readerHeartbeats, bool hugePages, bool prefault, bool flowWaiters, std::size_t threadCount)
+        {
+            // Create the dummy file.
+            auto readAccessFile = makeFlowAccessFilePath(flowDir);
+            if (auto out = std::ofstream{readAccessFile, std::ios::out | std::ios::trunc}; !out)
+            {
+                throw std::filesystem::filesystem_error{
+                    "Failed to create flow access file.", readAccessFile, std::make_error_code(std::errc::file_exists)};
+            }
+
+            auto const flowDataPath = makeFlowDataFilePath(flowDir);
+            auto flowData = std::make_unique<DiscreteFlowData>(flowDataPath.string().c_str(), AccessMode::CREATE_READ_WRITE, LockMode::Shared);
+
+            auto& info = *flowData->flowInfo();
+            auto const defaultVersion = flowWaiters ? FLOW_DATA_VERSION_WAITERS : FLOW_DATA_VERSION;
+            info.version = (layout == DiscreteFlowLayout::SingleSegment) ? FLOW_DATA_VERSION_SINGLE_SEGMENT : defaultVersion;
+            info.size = sizeof info;
+            if (hugePages)
+            {
+                info.config.common.flags |= MXL_FLOW_CONFIG_FLAG_HUGE_PAGES;
+            }
+            info.config.discrete = {};
+            info.config.discrete.grainCount = grainCount;
+            std::copy(grainSliceLengths.begin(), grainSliceLengths.end(), info.config.discrete.sliceSizes);
+
+            auto& state = *flowData->flowState();
+            state = initFlowState(flowDataPath);
+
+            if (hasFlowWaiters(info.version))
+            {
+                flowData->openFlowWaiters(makeFlowWaitersFilePath(flowDir).string().c_str());
+            }
+
+            if (readerHeartbeats)
+            {
+                flowData->openReaderHeartbeats(makeFlowHeartbeatsFilePath(flowDir).string().c_str());
+            }
+
+            auto const grainDir = makeGrainDirectoryName(flowDir);
+            if (!create_directory(grainDir))
+            {
+                throw std::filesystem::filesystem_error{"Could not create grain directory.", grainDir, std::make_error_code(std::errc::io_error)};
+            }
+
+            auto const pageMode = hugePages ? PageMode::Huge : PageMode::Default;
+            if (layout == DiscreteFlowLayout::SingleSegment)
+            {
+                auto const grainSegmentPath = makeGrainSegmentFilePath(grainDir);
+                MXL_TRACE("Creating grain segment: {}", grainSegmentPath.string());
+
+                // \todo Handle payload stored device memory
+                flowData->openGrainSegment(grainSegmentPath.string().c_str(), grainPayloadSize, pageMode);
+            }
+            else
+            {
+                auto grainPaths = std::vector<std::string>{};
+                grainPaths.reserve(grainCount);
+                for (auto i = std::size_t{0}; i < grainCount; ++i)
+                {
+                    grainPaths.push_back(makeGrainDataFilePath(grainDir, i).string());
+                    MXL_TRACE("Creating grain: {}", grainPaths.back());
+                }
+
+                // \todo Handle payload stored device memory
+                flowData->createGrainFiles(grainPaths, grainPayloadSize, pageMode, threadCount);
+            }
+
+            if (prefault)
+            {
+                flowData->prefaultGrains(threadCount);
+            }
+
+            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            {
+                auto& gInfo = flowData->grainAt(i)->header.info;
+                gInfo.grainSize = grainPayloadSize;
+                gInfo.totalSlices = grainNumOfSlices;
+                gInfo.validSlices = 0;
+                gInfo.version = GRAIN_HEADER_VERSION;
+                gInfo.size = sizeof gInfo;
+            }
+
+            return flowData;
+        }
+
+        /**
+         * Create all files of a continuous flow below the specified directory, except for the flow definition. The identity of the flow
+         * is left blank, see stampFlow().
+         */
+        std::unique_ptr<ContinuousFlowData> prepareContinuousFlow(std::filesystem::path const& flowDir, std::size_t channelCount,
+            std::size_t sampleWordSize, std::size_t bufferLength, ContinuousFlowLayout layout, bool flowWaiters)
+        {
+            auto const flowDataPath = makeFlowDataFilePath(flowDir);
+            auto flowData = std::make_unique<ContinuousFlowData>(flowDataPath.string().c_str(), AccessMode::CREATE_READ_WRITE, LockMode::Shared);
+
+            auto& info = *flowData->flowInfo();
+            // The channel data has the same size in both layouts, only the order of the samples differs.
+            auto const defaultVersion = flowWaiters ? FLOW_DATA_VERSION_WAITERS : FLOW_DATA_VERSION;
+            info.version = (layout == ContinuousFlowLayout::Interleaved) ? FLOW_DATA_VERSION_INTERLEAVED : defaultVersion;
+            info.size = sizeof info;
+            info.config.continuous = {};
+            info.config.continuous.channelCount = channelCount;
+            info.config.continuous.bufferLength = bufferLength;
+
+            auto& state = *flowData->flowState();
+            state = initFlowState(flowDataPath);
+
+            flowData->openChannelBuffers(makeChannelDataFilePath(flowDir).string().c_str(), sampleWordSize);
+            if (hasFlowWaiters(info.version))
+            {
+                flowData->openFlowWaiters(makeFlowWaitersFilePath(flowDir).string().c_str());
+            }
+
+            return flowData;
+        }
+
+        /**
+         * Mirror the channel buffers of a continuous flow if requested. Flows whose channel buffers are not a multiple of the page
+         * size, for example because they were created on a system with larger pages, keep the linear mapping.
+         */
+        void mirrorChannelBuffers(ContinuousFlowData& flowData, ChannelMapping channelMapping)
+        {
+            if ((channelMapping == ChannelMapping::Mirrored) && !flowData.mirrorChannelBuffers())
+            {
+                MXL_DEBUG("Channel buffers of {} samples can not be mirrored, falling back to the linear mapping.", flowData.channelBufferLength());
+            }
+        }
+
+        /**
+         * Return the key under which skeletons of discrete flows with the specified properties are pooled. Everything that determines
+         * the files of the flow is part of the key, everything that is stamped by stampFlow() is not.
+         */
+        std::string discreteFlowGeometry(mxlDataFormat format, std::size_t grainCount, std::size_t grainPayloadSize, std::size_t grainNumOfSlices,
+            std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN> const& grainSliceLengths, DiscreteFlowLayout layout, bool readerHeartbeats,
+            bool hugePages, bool flowWaiters)
+        {
+            auto result = fmt::format("discrete-{}-{}-{}-{}-", static_cast<int>(format), grainCount, grainPayloadSize, grainNumOfSlices);
+            for (auto const sliceLength : grainSliceLengths)
+            {
+                result += fmt::format("{}x", sliceLength);
+            }
+            result += fmt::format("-{}-{}-{}-{}", static_cast<int>(layout), readerHeartbeats ? 1 : 0, hugePages ? 1 : 0, flowWaiters ? 1 : 0);
+            return result;
+        }
+
+        /** Return the key under which skeletons of continuous flows with the specified properties are pooled. */
+        std::string continuousFlowGeometry(mxlDataFormat format, std::size_t channelCount, std::size_t sampleWordSize, std::size_t bufferLength,
+            ContinuousFlowLayout layout, bool flowWaiters)
+        {
+            return fmt::format("continuous-{}-{}-{}-{}-{}-{}",
+                static_cast<int>(format),
+                channelCount,
+                sampleWordSize,
+                bufferLength,
+                static_cast<int>(layout),
+                flowWaiters ? 1 : 0);
+        }
+
+        /**
+         * Return the geometry a pooled skeleton belongs to. Pool entries are named '<geometry>.<unique suffix>'.
+         */
+        std::string pooledFlowGeometry(std::filesystem::path const& entry)
+        {
+            return entry.stem().string();
+        }
+
+        /**
+         * List the skeletons in the flow pool of a domain. A missing or unreadable pool is treated as an empty one.
+         */
+        std::vector<std::filesystem::path> listPooledFlows(std::filesystem::path const& domain)
+        {
+            auto result = std::vector<std::filesystem::path>{};
+            try
+            {
+                if (auto const poolDir = makeFlowPoolDirectoryName(domain); exists(poolDir))
+                {
+                    for (auto const& entry : std::filesystem::directory_iterator{poolDir})
+                    {
+                        result.push_back(entry.path());
+                    }
+                }
+            }
+            catch (std::filesystem::filesystem_error const& ex)
+            {
+                MXL_DEBUG("Could not list the flow pool: {}", ex.what());
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        /**
+         * Take a skeleton out of the flow pool by renaming it onto a new, empty temporary directory. As renaming is atomic, only one
+         * process can claim a skeleton, even if several try at once.
+         *
+         * \return The temporary directory now holding the skeleton, or std::nullopt if someone else claimed it first.
+         */
+        std::optional<std::filesystem::path> claimPooledFlowEntry(std::filesystem::path const& domain, std::filesystem::path const& entry)
+        {
+            auto const target = createTemporaryFlowDirectory(domain);
+            if (::rename(entry.c_str(), target.c_str()) == 0)
+            {
+                return target;
+            }
+
+            auto ec = std::error_code{};
+            remove(target, ec);
+            return std::nullopt;
+        }
     }
 
     FlowManager::FlowManager(std::filesystem::path const& in_mxlDomain)
         : _mxlDomain{std::filesystem::canonical(in_mxlDomain)}
+        , _flowPoolSize{0U}
+        , _flowPoolMutex{}
+        , _flowPoolCondition{}
+        , _flowPoolRefills{}
+        , _flowPoolStopping{false}
+        , _flowPoolThread{}
     {
         if (!exists(in_mxlDomain) || !is_directory(in_mxlDomain))
         {
@@ -162,11 +463,27 @@ namespace mxl::lib
         }
     }
 
+    FlowManager::~FlowManager()
+    {
+        {
+            auto const lock = std::lock_guard{_flowPoolMutex};
+            _flowPoolStopping = true;
+        }
+        _flowPoolCondition.notify_all();
+
+        if (_flowPoolThread.joinable())
+        {
+            _flowPoolThread.join();
+        }
+    }
+
     std::pair<bool, std::unique_ptr<DiscreteFlowData>> FlowManager::createOrOpenDiscreteFlow(uuids::uuid const& flowId, std::string const& flowDef,
         mxlDataFormat flowFormat, std::size_t grainCount, mxlRational const& grainRate, std::size_t grainPayloadSize, std::size_t grainNumOfSlices,
         std::array<uint32_t, MXL_MAX_PLANES_PER_GRAIN> grainSliceLengths, std::uint32_t maxSyncBatchSizeHintOpt,
-        std::uint32_t maxCommitBatchSizeHintOpt)
+        std::uint32_t maxCommitBatchSizeHintOpt, DiscreteFlowLayout layout, bool readerHeartbeats, bool hugePages, bool prefault,
+        bool flowWaiters)
     {
+        auto const creationStart = currentTime(Clock::TAI);
         auto const uuidString = uuids::to_string(flowId);
         MXL_DEBUG("Create discrete flow. id: {}, grainCount: {}, grain payload size: {}", uuidString, grainCount, grainPayloadSize);
 
@@ -176,7 +493,12 @@ namespace mxl::lib
             throw std::runtime_error{"Attempt to create discrete flow with unsupported or non matching format."};
         }
 
-        auto const tempDirectory = createTemporaryFlowDirectory(_mxlDomain);
+        auto const threadCount = allocationThreadCount(grainCount, grainPayloadSize);
+        auto const geometry = discreteFlowGeometry(
+            flowFormat, grainCount, grainPayloadSize, grainNumOfSlices, grainSliceLengths, layout, readerHeartbeats, hugePages, flowWaiters);
+        auto const pooledDirectory = (_flowPoolSize > 0U) ? claimPooledFlow(geometry) : std::nullopt;
+
+        auto const tempDirectory = pooledDirectory ? *pooledDirectory : createTemporaryFlowDirectory(_mxlDomain);
         auto _ = defer(
             [&]() noexcept
             {
@@ -188,56 +510,64 @@ namespace mxl::lib
                 }
             });
 
-        // Write the json file to disk.
-        writeFlowDescriptor(tempDirectory, flowDef);
+        auto flowData = std::unique_ptr<DiscreteFlowData>{};
+        if (pooledDirectory)
+        {
+            MXL_DEBUG("Creating discrete flow {} from pooled skeleton.", uuidString);
 
-        // Create the dummy file.
-        auto readAccessFile = makeFlowAccessFilePath(tempDirectory);
-        if (auto out = std::ofstream{readAccessFile, std::ios::out | std::ios::trunc}; !out)
+            // The grains are already allocated, prefaulting only has to set up the page tables of this process.
+            auto flowSegment =
+                SharedMemoryInstance<Flow>{makeFlowDataFilePath(tempDirectory).string().c_str(), AccessMode::READ_WRITE, 0U, LockMode::Shared};
+            flowData = openDiscreteFlow(tempDirectory, std::move(flowSegment));
+            if (prefault)
+            {
+                flowData->prefaultGrains(threadCount);
+            }
+        }
+        else
         {
-            throw std::filesystem::filesystem_error{
-                "Failed to create flow access file.", readAccessFile, std::make_error_code(std::errc::file_exists)};
+            flowData = prepareDiscreteFlow(tempDirectory,
+                grainCount,
+                grainPayloadSize,
+                grainNumOfSlices,
+                grainSliceLengths,
+                layout,
+                readerHeartbeats,
+                hugePages,
+                prefault,
+                flowWaiters,
+                threadCount);
         }
 
-        auto const flowDataPath = makeFlowDataFilePath(tempDirectory);
-        auto flowData = std::make_unique<DiscreteFlowData>(flowDataPath.string().c_str(), AccessMode::CREATE_READ_WRITE, LockMode::Shared);
-
-        auto& info = *flowData->flowInfo();
-        info.version = FLOW_DATA_VERSION;
-        info.size = sizeof info;
-        info.config.common = initCommonFlowConfigInfo(flowId, flowFormat, grainRate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt);
-        info.config.discrete = {};
-        info.config.discrete.grainCount = grainCount;
-        std::copy(grainSliceLengths.begin(), grainSliceLengths.end(), info.config.discrete.sliceSizes);
-
-        info.runtime = initFlowRuntimeInfo();
+        // Write the json file to disk.
+        writeFlowDescriptor(tempDirectory, flowDef);
 
-        auto& state = *flowData->flowState();
-        state = initFlowState(flowDataPath);
+        stampFlow(*flowData, flowId, flowFormat, grainRate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt, creationStart);
+        flowData->flowInfo()->config.common.creationDuration = (currentTime(Clock::TAI) - creationStart).value;
 
-        auto const grainDir = makeGrainDirectoryName(tempDirectory);
-        if (!create_directory(grainDir))
-        {
-            throw std::filesystem::filesystem_error{"Could not create grain directory.", grainDir, std::make_error_code(std::errc::io_error)};
-        }
+        auto const finalDir = makeFlowDirectoryName(_mxlDomain, uuidString);
+        auto const published = publishFlowDirectory(tempDirectory, finalDir);
 
-        for (auto i = std::size_t{0}; i < grainCount; ++i)
+        if (_flowPoolSize > 0U)
         {
-            auto const grainPath = makeGrainDataFilePath(grainDir, i);
-            MXL_TRACE("Creating grain: {}", grainPath.string());
-
-            // \todo Handle payload stored device memory
-            auto const grain = flowData->emplaceGrain(grainPath.string().c_str(), grainPayloadSize);
-            auto& gInfo = grain->header.info;
-            gInfo.grainSize = grainPayloadSize;
-            gInfo.totalSlices = grainNumOfSlices;
-            gInfo.validSlices = 0;
-            gInfo.version = GRAIN_HEADER_VERSION;
-            gInfo.size = sizeof gInfo;
+            refillFlowPool(geometry,
+                [=](std::filesystem::path const& flowDir)
+                {
+                    prepareDiscreteFlow(flowDir,
+                        grainCount,
+                        grainPayloadSize,
+                        grainNumOfSlices,
+                        grainSliceLengths,
+                        layout,
+                        readerHeartbeats,
+                        hugePages,
+                        false,
+                        flowWaiters,
+                        threadCount);
+                });
         }
 
-        auto const finalDir = makeFlowDirectoryName(_mxlDomain, uuidString);
-        if (publishFlowDirectory(tempDirectory, finalDir))
+        if (published)
         {
             return {true, std::move(flowData)};
         }
@@ -255,8 +585,10 @@ namespace mxl::lib
 
     std::pair<bool, std::unique_ptr<ContinuousFlowData>> FlowManager::createOrOpenContinuousFlow(uuids::uuid const& flowId,
         std::string const& flowDef, mxlDataFormat flowFormat, mxlRational const& sampleRate, std::size_t channelCount, std::size_t sampleWordSize,
-        std::size_t bufferLength, std::uint32_t maxSyncBatchSizeHintOpt, std::uint32_t maxCommitBatchSizeHintOpt)
+        std::size_t bufferLength, std::uint32_t maxSyncBatchSizeHintOpt, std::uint32_t maxCommitBatchSizeHintOpt, ContinuousFlowLayout layout,
+        ChannelMapping channelMapping, bool flowWaiters)
     {
+        auto const creationStart = currentTime(Clock::TAI);
         auto const uuidString = uuids::to_string(flowId);
         MXL_DEBUG("Create continuous flow. id: {}, channel count: {}, word size: {}, buffer length: {}",
             uuidString,
@@ -270,38 +602,57 @@ namespace mxl::lib
             throw std::runtime_error{"Attempt to create continuous flow with unsupported or non matching format."};
         }
 
-        auto const tempDirectory = createTemporaryFlowDirectory(_mxlDomain);
+        auto const geometry = continuousFlowGeometry(flowFormat, channelCount, sampleWordSize, bufferLength, layout, flowWaiters);
+        auto const pooledDirectory = (_flowPoolSize > 0U) ? claimPooledFlow(geometry) : std::nullopt;
+
+        auto const tempDirectory = pooledDirectory ? *pooledDirectory : createTemporaryFlowDirectory(_mxlDomain);
         try
         {
-            // Write the json file to disk.
-            writeFlowDescriptor(tempDirectory, flowDef);
+            auto flowData = std::unique_ptr<ContinuousFlowData>{};
+            if (pooledDirectory)
+            {
+                MXL_DEBUG("Creating continuous flow {} from pooled skeleton.", uuidString);
 
-            auto const flowDataPath = makeFlowDataFilePath(tempDirectory);
-            auto flowData = std::make_unique<ContinuousFlowData>(flowDataPath.string().c_str(), AccessMode::CREATE_READ_WRITE, LockMode::Shared);
+                auto flowSegment =
+                    SharedMemoryInstance<Flow>{makeFlowDataFilePath(tempDirectory).string().c_str(), AccessMode::READ_WRITE, 0U, LockMode::Shared};
+                flowData = openContinuousFlow(tempDirectory, std::move(flowSegment));
+            }
+            else
+            {
+                flowData = prepareContinuousFlow(tempDirectory, channelCount, sampleWordSize, bufferLength, layout, flowWaiters);
+            }
 
-            auto& info = *flowData->flowInfo();
-            info.version = FLOW_DATA_VERSION;
-            info.size = sizeof info;
-            info.config.common = initCommonFlowConfigInfo(flowId, flowFormat, sampleRate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt);
-            info.config.continuous = {};
-            info.config.continuous.channelCount = channelCount;
-            info.config.continuous.bufferLength = bufferLength;
+            // Write the json file to disk.
+            writeFlowDescriptor(tempDirectory, flowDef);
 
-            info.runtime = initFlowRuntimeInfo();
+            stampFlow(*flowData, flowId, flowFormat, sampleRate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt, creationStart);
+            flowData->flowInfo()->config.common.creationDuration = (currentTime(Clock::TAI) - creationStart).value;
 
-            auto& state = *flowData->flowState();
-            state = initFlowState(flowDataPath);
+            auto const finalDir = makeFlowDirectoryName(_mxlDomain, uuidString);
+            auto const published = publishFlowDirectory(tempDirectory, finalDir);
 
-            flowData->openChannelBuffers(makeChannelDataFilePath(tempDirectory).string().c_str(), sampleWordSize);
+            if (_flowPoolSize > 0U)
+            {
+                refillFlowPool(geometry,
+                    [=](std::filesystem::path const& flowDir)
+                    {
+                        prepareContinuousFlow(flowDir, channelCount, sampleWordSize, bufferLength, layout, flowWaiters);
+                    });
+            }
 
-            auto const finalDir = makeFlowDirectoryName(_mxlDomain, uuidString);
-            if (publishFlowDirectory(tempDirectory, finalDir))
+            if (published)
             {
+                mirrorChannelBuffers(*flowData, channelMapping);
                 return {true, std::move(flowData)};
             }
             else
             {
-                auto existingFlowData = dynamic_pointer_cast<ContinuousFlowData>(openFlow(flowId, AccessMode::READ_WRITE));
+                // Remove the flow we prepared in vain.
+                auto ec = std::error_code{};
+                remove_all(tempDirectory, ec);
+
+                auto existingFlowData =
+                    dynamic_pointer_cast<ContinuousFlowData>(openFlow(flowId, AccessMode::READ_WRITE, GrainMapping::Eager, channelMapping));
                 if (!existingFlowData)
                 {
                     throw std::runtime_error("Could not open existing flow because it is of a different format");
@@ -318,7 +669,8 @@ namespace mxl::lib
         }
     }
 
-    std::unique_ptr<FlowData> FlowManager::openFlow(uuids::uuid const& in_flowId, AccessMode in_mode)
+    std::unique_ptr<FlowData> FlowManager::openFlow(uuids::uuid const& in_flowId, AccessMode in_mode, GrainMapping in_grainMapping,
+        ChannelMapping in_channelMapping)
     {
         if (in_mode == AccessMode::CREATE_READ_WRITE)
         {
@@ -332,19 +684,23 @@ namespace mxl::lib
         if (auto const flowFile = makeFlowDataFilePath(base); exists(flowFile))
         {
             auto flowSegment = SharedMemoryInstance<Flow>{flowFile.string().c_str(), in_mode, 0U, LockMode::Shared};
-            if (flowSegment.get()->info.version != FLOW_DATA_VERSION)
+            if (!isSupportedFlowDataVersion(flowSegment.get()->info.version))
             {
-                throw std::invalid_argument{
-                    fmt::format("Unsupported flow data version: {}, supported is: {}", flowSegment.get()->info.version, FLOW_DATA_VERSION)};
+                throw std::invalid_argument{fmt::format("Unsupported flow data version: {}, supported are: {}, {}, {} and {}",
+                    flowSegment.get()->info.version,
+                    FLOW_DATA_VERSION,
+                    FLOW_DATA_VERSION_SINGLE_SEGMENT,
+                    FLOW_DATA_VERSION_INTERLEAVED,
+                    FLOW_DATA_VERSION_WAITERS)};
             }
 
             if (auto const flowFormat = flowSegment.get()->info.config.common.format; mxlIsDiscreteDataFormat(flowFormat))
             {
-                return openDiscreteFlow(base, std::move(flowSegment));
+                return openDiscreteFlow(base, std::move(flowSegment), in_grainMapping);
             }
             else if (mxlIsContinuousDataFormat(flowFormat))
             {
-                return openContinuousFlow(base, std::move(flowSegment));
+                return openContinuousFlow(base, std::move(flowSegment), in_channelMapping);
             }
             else
             {
@@ -359,15 +715,33 @@ namespace mxl::lib
     }
 
     std::unique_ptr<DiscreteFlowData> FlowManager::openDiscreteFlow(std::filesystem::path const& flowDir,
-        SharedMemoryInstance<Flow>&& sharedFlowInstance)
+        SharedMemoryInstance<Flow>&& sharedFlowInstance, GrainMapping grainMapping)
     {
         auto flowData = std::make_unique<DiscreteFlowData>(std::move(sharedFlowInstance));
 
         auto const grainCount = flowData->flowInfo()->config.discrete.grainCount;
         if (grainCount > 0U)
         {
+            // Readers need to advise their own mappings, otherwise they may map huge pages as regular ones.
+            auto const pageMode = ((flowData->flowInfo()->config.common.flags & MXL_FLOW_CONFIG_FLAG_HUGE_PAGES) != 0U) ? PageMode::Huge
+                                                                                                                       : PageMode::Default;
             auto const grainDir = makeGrainDirectoryName(flowDir);
-            if (exists(grainDir) && is_directory(grainDir))
+            if (flowData->flowInfo()->version == FLOW_DATA_VERSION_SINGLE_SEGMENT)
+            {
+                // All grains are mapped at once, which keeps the cost of opening the flow independent of the grain count.
+                auto const grainSegmentPath = makeGrainSegmentFilePath(grainDir).string();
+                MXL_TRACE("Opening grain segment: {}", grainSegmentPath);
+
+                flowData->openGrainSegment(grainSegmentPath.c_str(), /*grainPayloadSize=*/0U, pageMode);
+            }
+            else if (exists(grainDir) && is_directory(grainDir) && (grainMapping == GrainMapping::Lazy))
+            {
+                // Readers that only ever look at a few grains don't pay for mapping all of them.
+                MXL_TRACE("Opening grains lazily: {}", grainDir.string());
+
+                flowData->openGrainsLazily(grainDir, pageMode);
+            }
+            else if (exists(grainDir) && is_directory(grainDir))
             {
                 // Open each grain with per-item error handling
                 for (auto i = 0U; i < grainCount; ++i)
@@ -375,7 +749,7 @@ namespace mxl::lib
                     auto const grainPath = makeGrainDataFilePath(grainDir, i).string();
                     MXL_TRACE("Opening grain: {}", grainPath);
 
-                    flowData->emplaceGrain(grainPath.c_str(), /*payloadSize=*/0U);
+                    flowData->emplaceGrain(grainPath.c_str(), /*payloadSize=*/0U, pageMode);
                 }
             }
             else
@@ -385,15 +759,34 @@ namespace mxl::lib
             }
         }
 
+        if (auto const heartbeatsPath = makeFlowHeartbeatsFilePath(flowDir); exists(heartbeatsPath))
+        {
+            try
+            {
+                flowData->openReaderHeartbeats(heartbeatsPath.string().c_str());
+            }
+            catch (std::exception const& ex)
+            {
+                // This is expected if the domain is on a read-only volume, or if we lack write permissions. Readers will fall back
+                // to touching the access file in this case.
+                MXL_DEBUG("Could not open reader heartbeats '{}': {}", heartbeatsPath.string(), ex.what());
+            }
+        }
+
+        openFlowWaiters(*flowData, flowDir);
+
         return flowData;
     }
 
     std::unique_ptr<ContinuousFlowData> FlowManager::openContinuousFlow(std::filesystem::path const& flowDir,
-        SharedMemoryInstance<Flow>&& sharedFlowInstance)
+        SharedMemoryInstance<Flow>&& sharedFlowInstance, ChannelMapping channelMapping)
     {
         auto flowData = std::make_unique<ContinuousFlowData>(std::move(sharedFlowInstance));
 
         flowData->openChannelBuffers(makeChannelDataFilePath(flowDir).string().c_str(), /*payloadSize=*/0U);
+        mirrorChannelBuffers(*flowData, channelMapping);
+
+        openFlowWaiters(*flowData, flowDir);
 
         return flowData;
     }
@@ -421,6 +814,9 @@ namespace mxl::lib
         auto uuid = uuids::to_string(flowId);
         MXL_TRACE("Delete flow: {}", uuid);
 
+        // Let readers that are still attached know that the flow is going away before we unlink it.
+        retireFlow(flowId);
+
         try
         {
             // Compute the flow directory path
@@ -441,6 +837,34 @@ namespace mxl::lib
         }
     }
 
+    void FlowManager::retireFlow(uuids::uuid const& flowId) const noexcept
+    {
+        try
+        {
+            auto const flowDataPath = makeFlowDataFilePath(_mxlDomain, uuids::to_string(flowId));
+            if (exists(flowDataPath))
+            {
+                auto flow = SharedMemoryInstance<Flow>{flowDataPath.string().c_str(), AccessMode::READ_WRITE, 0U, LockMode::None};
+                auto& state = flow.get()->state;
+                std::atomic_ref{state.retired}.store(1U, std::memory_order_release);
+
+                // Wake up readers blocked on the flow, so that they notice right away.
+                std::atomic_ref{state.syncCounter}.fetch_add(1U, std::memory_order_release);
+                wakeAll(&state.syncCounter);
+
+                if (auto const waitersPath = makeFlowWaitersFilePath(_mxlDomain, uuids::to_string(flowId)); exists(waitersPath))
+                {
+                    auto waiters = SharedMemoryInstance<FlowWaiters>{waitersPath.string().c_str(), AccessMode::READ_WRITE, 0U, LockMode::None};
+                    wakeAllGrainWaiters(*waiters.get());
+                }
+            }
+        }
+        catch (std::exception const& ex)
+        {
+            MXL_DEBUG("Could not retire flow {}: {}", uuids::to_string(flowId), ex.what());
+        }
+    }
+
     std::vector<uuids::uuid> FlowManager::listFlows() const
     {
         auto base = std::filesystem::path{_mxlDomain};
@@ -498,4 +922,137 @@ namespace mxl::lib
     {
         return _mxlDomain;
     }
+
+    void FlowManager::setFlowPoolSize(std::size_t size) noexcept
+    {
+        _flowPoolSize = size;
+    }
+
+    std::size_t FlowManager::trimFlowPool() const
+    {
+        auto const poolSize = _flowPoolSize.load();
+
+        auto count = std::size_t{0};
+        auto pooled = std::size_t{0};
+        auto geometry = std::string{};
+        // The entries are sorted, so the skeletons of each geometry are adjacent.
+        for (auto const& entry : listPooledFlows(_mxlDomain))
+        {
+            if (auto const entryGeometry = pooledFlowGeometry(entry); entryGeometry != geometry)
+            {
+                geometry = entryGeometry;
+                pooled = 0U;
+            }
+
+            if (++pooled > poolSize)
+            {
+                // Claim the skeleton first, so that it can't be taken by a flow that is created while it is being removed.
+                if (auto const claimed = claimPooledFlowEntry(_mxlDomain, entry); claimed)
+                {
+                    auto ec = std::error_code{};
+                    remove_all(*claimed, ec);
+                    if (ec)
+                    {
+                        MXL_DEBUG("Failed to remove pooled flow skeleton '{}': {}", entry.string(), ec.message());
+                    }
+                    else
+                    {
+                        ++count;
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    std::optional<std::filesystem::path> FlowManager::claimPooledFlow(std::string const& geometry) const
+    {
+        for (auto const& entry : listPooledFlows(_mxlDomain))
+        {
+            if (pooledFlowGeometry(entry) == geometry)
+            {
+                if (auto claimed = claimPooledFlowEntry(_mxlDomain, entry); claimed)
+                {
+                    return claimed;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    void FlowManager::refillFlowPool(std::string const& geometry, FlowPreparation prepare) noexcept
+    {
+        try
+        {
+            auto const lock = std::lock_guard{_flowPoolMutex};
+            auto const pending = std::any_of(
+                _flowPoolRefills.begin(), _flowPoolRefills.end(), [&](auto const& refill) { return refill.first == geometry; });
+            if (!pending)
+            {
+                _flowPoolRefills.emplace_back(geometry, std::move(prepare));
+                if (!_flowPoolThread.joinable())
+                {
+                    _flowPoolThread = std::thread{&FlowManager::runFlowPoolRefills, this};
+                }
+                _flowPoolCondition.notify_one();
+            }
+        }
+        catch (std::exception const& ex)
+        {
+            MXL_WARN("Failed to schedule refilling the flow pool: {}", ex.what());
+        }
+    }
+
+    void FlowManager::runFlowPoolRefills()
+    {
+        auto lock = std::unique_lock{_flowPoolMutex};
+        while (true)
+        {
+            _flowPoolCondition.wait(lock, [this]() { return _flowPoolStopping || !_flowPoolRefills.empty(); });
+            if (_flowPoolStopping)
+            {
+                return;
+            }
+
+            auto [geometry, prepare] = std::move(_flowPoolRefills.front());
+            _flowPoolRefills.pop_front();
+            lock.unlock();
+
+            try
+            {
+                auto const poolDir = makeFlowPoolDirectoryName(_mxlDomain);
+                create_directories(poolDir);
+
+                auto const entries = listPooledFlows(_mxlDomain);
+                auto pooled = static_cast<std::size_t>(
+                    std::count_if(entries.begin(), entries.end(), [&](auto const& entry) { return pooledFlowGeometry(entry) == geometry; }));
+
+                // Other processes may be refilling the same pool at the same time, which at worst leaves a few skeletons too many that
+                // the next garbage collection removes.
+                for (; (pooled < _flowPoolSize) && !_flowPoolStopping; ++pooled)
+                {
+                    auto const tempDirectory = createTemporaryFlowDirectory(_mxlDomain);
+                    auto _ = defer(
+                        [&]() noexcept
+                        {
+                            std::error_code ec;
+                            std::filesystem::remove_all(tempDirectory, ec);
+                        });
+
+                    prepare(tempDirectory);
+
+                    auto const suffix = tempDirectory.filename().string().substr(TEMPORARY_FLOW_DIRECTORY_PREFIX.size());
+                    auto const entry = poolDir / fmt::format("{}.{}", geometry, suffix);
+                    MXL_TRACE("Adding flow skeleton to the pool: {}", entry.string());
+                    std::filesystem::rename(tempDirectory, entry);
+                }
+            }
+            catch (std::exception const& ex)
+            {
+                MXL_WARN("Failed to refill the flow pool: {}", ex.what());
+            }
+
+            lock.lock();
+        }
+    }
 }
@@ -0,0 +1,278 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/FlowNotifier.hpp"
+#include <cerrno>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#   include <sys/eventfd.h>
+#endif
+#include "mxl-internal/ContinuousFlowReader.hpp"
+#include "mxl-internal/DiscreteFlowReader.hpp"
+#include "mxl-internal/FlowWaiters.hpp"
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/Sync.hpp"
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /// How long the notifier thread sleeps at once while it has nothing to poll for.
+        constexpr auto IDLE_INTERVAL = Duration{1'000'000'000};
+
+        /// Create the pair of file descriptors backing a wait handle. Both are the same eventfd where available.
+        std::pair<int, int> createEvent()
+        {
+#if defined(__linux__)
+            if (auto const fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK); fd != -1)
+            {
+                return {fd, fd};
+            }
+#else
+            if (auto fds = std::array<int, 2>{}; ::pipe(fds.data()) == 0)
+            {
+                for (auto const fd : fds)
+                {
+                    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+                }
+                return {fds[0], fds[1]};
+            }
+#endif
+            throw std::system_error{errno, std::generic_category(), "Could not create wait handle."};
+        }
+
+        void signalEvent(int fd) noexcept
+        {
+#if defined(__linux__)
+            auto const value = ::eventfd_t{1};
+            if (::write(fd, &value, sizeof(value)) < 0)
+#else
+            auto const value = std::uint8_t{1};
+            // A full pipe is readable already, so EAGAIN is not an error.
+            if ((::write(fd, &value, sizeof(value)) < 0) && (errno != EAGAIN))
+#endif
+            {
+                auto const error = errno;
+                MXL_ERROR("Failed to signal wait handle: {}", ::strerror(error));
+            }
+        }
+
+        void clearEvent(int fd) noexcept
+        {
+#if defined(__linux__)
+            auto value = ::eventfd_t{};
+            (void)::read(fd, &value, sizeof(value));
+#else
+            auto buffer = std::array<std::uint8_t, 64>{};
+            while (::read(fd, buffer.data(), buffer.size()) > 0)
+            {}
+#endif
+        }
+
+        void closeEvent(int readFd, int writeFd) noexcept
+        {
+            ::close(readFd);
+            if (writeFd != readFd)
+            {
+                ::close(writeFd);
+            }
+        }
+    }
+
+    FlowNotifier::FlowNotifier()
+        : _mutex{}
+        , _iterationDone{}
+        , _registrations{}
+        , _control{0U}
+        , _iterations{0U}
+        , _stopping{false}
+        , _thread{&FlowNotifier::run, this}
+    {}
+
+    FlowNotifier::~FlowNotifier()
+    {
+        {
+            auto const lock = std::lock_guard{_mutex};
+            _stopping = true;
+            wakeThread();
+        }
+        _thread.join();
+
+        for (auto& [reader, registration] : _registrations)
+        {
+            disarm(registration);
+            closeEvent(registration.readFd, registration.writeFd);
+        }
+    }
+
+    int FlowNotifier::arm(FlowReader const& reader, std::uint64_t index, std::uint16_t minValidSlices)
+    {
+        auto const lock = std::lock_guard{_mutex};
+
+        auto pos = _registrations.find(&reader);
+        if (pos == _registrations.end())
+        {
+            auto const [readFd, writeFd] = createEvent();
+            pos = _registrations
+                      .emplace(&reader,
+                          Registration{
+                              readFd,
+                              writeFd,
+                              dynamic_cast<DiscreteFlowReader const*>(&reader),
+                              dynamic_cast<ContinuousFlowReader const*>(&reader),
+                              reader.getSyncCounter(),
+                              reader.getSyncWaiters(),
+                              reader.getUnannouncedUntil(),
+                              0U,
+                              0U,
+                              false,
+                          })
+                      .first;
+        }
+
+        auto& registration = pos->second;
+        clearEvent(registration.readFd);
+        registration.index = index;
+        registration.minValidSlices = minValidSlices;
+
+        // Spare the application a round trip through the notifier thread if it can make progress already.
+        if (poll(registration) != MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
+        {
+            disarm(registration);
+            signalEvent(registration.writeFd);
+        }
+        else
+        {
+            if (!registration.armed && (registration.syncWaiters != nullptr))
+            {
+                // Announce ourselves as sleeping on the sync counter for as long as the handle is armed, so that writers don't skip
+                // waking up the notifier thread.
+                std::atomic_ref{*registration.syncWaiters}.fetch_add(1U, std::memory_order_relaxed);
+            }
+            registration.armed = true;
+            wakeThread();
+        }
+
+        return registration.readFd;
+    }
+
+    void FlowNotifier::remove(FlowReader const& reader)
+    {
+        auto lock = std::unique_lock{_mutex};
+        if (auto const pos = _registrations.find(&reader); pos != _registrations.end())
+        {
+            auto registration = pos->second;
+            _registrations.erase(pos);
+
+            // The notifier thread may currently sleep on the sync counter of the reader, which lives in memory that is unmapped
+            // once the reader is destroyed. Wait for it to collect the remaining registrations before returning.
+            if (registration.armed)
+            {
+                auto const iterations = _iterations;
+                wakeThread();
+                _iterationDone.wait(lock, [&] { return (_iterations != iterations) || _stopping; });
+            }
+
+            disarm(registration);
+            closeEvent(registration.readFd, registration.writeFd);
+        }
+    }
+
+    void FlowNotifier::run()
+    {
+        auto targets = std::vector<WaitTarget>{};
+        targets.reserve(MAX_WAIT_TARGETS);
+
+        auto lock = std::unique_lock{_mutex};
+        while (!_stopping)
+        {
+            auto const control = std::atomic_ref{_control}.load(std::memory_order_acquire);
+
+            // As in the blocking accessors of the readers, the counters must be sampled before checking for data, otherwise a
+            // commit in between would go unnoticed until the next one.
+            targets.clear();
+            auto mustPoll = false;
+            auto const checkTime = currentTime(Clock::Realtime);
+            for (auto& [reader, registration] : _registrations)
+            {
+                if (registration.armed)
+                {
+                    auto const counter = std::atomic_ref{*const_cast<std::uint32_t*>(registration.syncCounter)}.load(std::memory_order_acquire);
+                    if (poll(registration) != MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
+                    {
+                        disarm(registration);
+                        signalEvent(registration.writeFd);
+                    }
+                    else if ((targets.size() + 1U < MAX_WAIT_TARGETS) && (checkTime >= registration.unannouncedUntil))
+                    {
+                        targets.push_back({registration.syncCounter, counter});
+                    }
+                    else
+                    {
+                        // Too many flows to wait on at once, or a writer that may not wake us up.
+                        mustPoll = true;
+                    }
+                }
+            }
+
+            ++_iterations;
+            _iterationDone.notify_all();
+            lock.unlock();
+
+            // Pairs with the fence in wakeSyncWaiters(): Either the writer observes the announcement made when the handle was armed,
+            // or we observe the incremented sync counter.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto const now = currentTime(Clock::Realtime);
+            if (isWaitOnMultipleSupported())
+            {
+                targets.push_back({&_control, control});
+                (void)waitUntilAnyChanged(targets, now + (mustPoll ? UNANNOUNCED_WAIT_INTERVAL : IDLE_INTERVAL));
+            }
+            else
+            {
+                // Without a way to sleep on all sync counters at once, we can only poll them.
+                mustPoll = mustPoll || !targets.empty();
+                (void)waitUntilChanged(&_control, control, now + (mustPoll ? UNANNOUNCED_WAIT_INTERVAL : IDLE_INTERVAL));
+            }
+
+            lock.lock();
+        }
+    }
+
+    mxlStatus FlowNotifier::poll(Registration const& registration)
+    {
+        if (registration.discreteReader != nullptr)
+        {
+            return registration.discreteReader->pollGrain(registration.index, registration.minValidSlices);
+        }
+        if (registration.continuousReader != nullptr)
+        {
+            return registration.continuousReader->pollSamples(registration.index);
+        }
+        return MXL_ERR_INVALID_FLOW_READER;
+    }
+
+    void FlowNotifier::disarm(Registration& registration) noexcept
+    {
+        if (registration.armed && (registration.syncWaiters != nullptr))
+        {
+            std::atomic_ref{*registration.syncWaiters}.fetch_sub(1U, std::memory_order_relaxed);
+        }
+        registration.armed = false;
+    }
+
+    void FlowNotifier::wakeThread() noexcept
+    {
+        std::atomic_ref{_control}.fetch_add(1U, std::memory_order_release);
+        wakeAll(&_control);
+    }
+}
@@ -67,6 +67,161 @@ namespace mxl::lib
                 throw std::invalid_argument{"maxSyncBatchSizeHint must be a multiple of maxCommitBatchSizeHint."};
             }
         }
+
+        auto discreteFlowLayoutIt = _root.find("discreteFlowLayout");
+        if (discreteFlowLayoutIt != _root.end())
+        {
+            if (!discreteFlowLayoutIt->second.is<std::string>())
+            {
+                throw std::invalid_argument{"discreteFlowLayout must be a string."};
+            }
+
+            auto const& v = discreteFlowLayoutIt->second.get<std::string>();
+            if (v == "perGrainFiles")
+            {
+                _discreteFlowLayout = DiscreteFlowLayout::PerGrainFiles;
+            }
+            else if (v == "singleSegment")
+            {
+                _discreteFlowLayout = DiscreteFlowLayout::SingleSegment;
+            }
+            else
+            {
+                throw std::invalid_argument{"discreteFlowLayout must be either 'perGrainFiles' or 'singleSegment'."};
+            }
+        }
+
+        auto continuousFlowLayoutIt = _root.find("continuousFlowLayout");
+        if (continuousFlowLayoutIt != _root.end())
+        {
+            if (!continuousFlowLayoutIt->second.is<std::string>())
+            {
+                throw std::invalid_argument{"continuousFlowLayout must be a string."};
+            }
+
+            auto const& v = continuousFlowLayoutIt->second.get<std::string>();
+            if (v == "planar")
+            {
+                _continuousFlowLayout = ContinuousFlowLayout::Planar;
+            }
+            else if (v == "interleaved")
+            {
+                _continuousFlowLayout = ContinuousFlowLayout::Interleaved;
+            }
+            else
+            {
+                throw std::invalid_argument{"continuousFlowLayout must be either 'planar' or 'interleaved'."};
+            }
+        }
+
+        auto prefaultIt = _root.find("prefault");
+        if (prefaultIt != _root.end())
+        {
+            if (!prefaultIt->second.is<bool>())
+            {
+                throw std::invalid_argument{"prefault must be a boolean."};
+            }
+            _prefault = prefaultIt->second.get<bool>();
+        }
+
+        auto flowWaitersIt = _root.find("flowWaiters");
+        if (flowWaitersIt != _root.end())
+        {
+            if (!flowWaitersIt->second.is<bool>())
+            {
+                throw std::invalid_argument{"flowWaiters must be a boolean."};
+            }
+            _flowWaiters = flowWaitersIt->second.get<bool>();
+        }
+
+        auto waitPolicyIt = _root.find("waitPolicy");
+        if (waitPolicyIt != _root.end())
+        {
+            if (!waitPolicyIt->second.is<std::string>())
+            {
+                throw std::invalid_argument{"waitPolicy must be a string."};
+            }
+
+            auto const& v = waitPolicyIt->second.get<std::string>();
+            if (v == "futex")
+            {
+                _waitPolicy = WaitPolicy::Futex;
+            }
+            else if (v == "spin")
+            {
+                _waitPolicy = WaitPolicy::Spin;
+            }
+            else if (v == "adaptive")
+            {
+                _waitPolicy = WaitPolicy::Adaptive;
+            }
+            else
+            {
+                throw std::invalid_argument{"waitPolicy must be one of 'futex', 'spin' or 'adaptive'."};
+            }
+        }
+
+        auto maxSpinNsIt = _root.find("maxSpinNs");
+        if (maxSpinNsIt != _root.end())
+        {
+            if (!maxSpinNsIt->second.is<double>())
+            {
+                throw std::invalid_argument{"maxSpinNs must be a number."};
+            }
+
+            auto const v = maxSpinNsIt->second.get<double>();
+            if (v < 0)
+            {
+                throw std::invalid_argument{"maxSpinNs must not be negative."};
+            }
+            _maxSpinDuration = Duration{static_cast<std::int64_t>(v)};
+        }
+
+        auto grainMappingIt = _root.find("grainMapping");
+        if (grainMappingIt != _root.end())
+        {
+            if (!grainMappingIt->second.is<std::string>())
+            {
+                throw std::invalid_argument{"grainMapping must be a string."};
+            }
+
+            auto const& v = grainMappingIt->second.get<std::string>();
+            if (v == "eager")
+            {
+                _grainMapping = GrainMapping::Eager;
+            }
+            else if (v == "lazy")
+            {
+                _grainMapping = GrainMapping::Lazy;
+            }
+            else
+            {
+                throw std::invalid_argument{"grainMapping must be either 'eager' or 'lazy'."};
+            }
+        }
+
+        auto channelMappingIt = _root.find("channelMapping");
+        if (channelMappingIt != _root.end())
+        {
+            if (!channelMappingIt->second.is<std::string>())
+            {
+                throw std::invalid_argument{"channelMapping must be a string."};
+            }
+
+            auto const& v = channelMappingIt->second.get<std::string>();
+            if (v == "linear")
+            {
+                _channelMapping = ChannelMapping::Linear;
+            }
+            else if (v == "mirrored")
+            {
+                _channelMapping = ChannelMapping::Mirrored;
+            }
+            else
+            {
+                throw std::invalid_argument{"channelMapping must be either 'linear' or 'mirrored'."};
+            }
+        }
     }
 
     std::optional<std::uint32_t> FlowOptionsParser::getMaxCommitBatchSizeHint() const
@@ -78,4 +233,44 @@ namespace mxl::lib
     {
         return _maxSyncBatchSizeHint;
     }
+
+    std::optional<DiscreteFlowLayout> FlowOptionsParser::getDiscreteFlowLayout() const
+    {
+        return _discreteFlowLayout;
+    }
+
+    std::optional<ContinuousFlowLayout> FlowOptionsParser::getContinuousFlowLayout() const
+    {
+        return _continuousFlowLayout;
+    }
+
+    std::optional<bool> FlowOptionsParser::getPrefault() const
+    {
+        return _prefault;
+    }
+
+    std::optional<bool> FlowOptionsParser::getFlowWaiters() const
+    {
+        return _flowWaiters;
+    }
+
+    std::optional<WaitPolicy> FlowOptionsParser::getWaitPolicy() const
+    {
+        return _waitPolicy;
+    }
+
+    std::optional<Duration> FlowOptionsParser::getMaxSpinDuration() const
+    {
+        return _maxSpinDuration;
+    }
+
+    std::optional<GrainMapping> FlowOptionsParser::getGrainMapping() const
+    {
+        return _grainMapping;
+    }
+
+    std::optional<ChannelMapping> FlowOptionsParser::getChannelMapping() const
+    {
+        return _channelMapping;
+    }
 } // namespace mxl::lib
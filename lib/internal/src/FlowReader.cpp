@@ -4,18 +4,34 @@
 #include "mxl-internal/FlowReader.hpp"
 #include <utility>
 #include <unistd.h>
+#include <sys/stat.h>
 #include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
-    FlowReader::FlowReader(uuids::uuid&& flowId, std::filesystem::path const& domain)
-        : _flowId{std::move(flowId)}
+    namespace
+    {
+        /// The minimum interval between two stat() calls performed to detect flows that were not retired properly.
+        constexpr auto FLOW_VALIDITY_CHECK_INTERVAL = Duration{100'000'000};
+    }
+
+    FlowReader::FlowReader(FlowKind kind, uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : _kind{kind}
+        , _flowId{std::move(flowId)}
         , _domain{domain}
+        , _flowDataPath{makeFlowDataFilePath(_domain, uuids::to_string(_flowId))}
+        , _nextStatCheck{0}
+        , _waitStrategy{}
     {}
 
-    FlowReader::FlowReader(uuids::uuid const& flowId, std::filesystem::path const& domain)
-        : _flowId{flowId}
+    FlowReader::FlowReader(FlowKind kind, uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : _kind{kind}
+        , _flowId{flowId}
         , _domain{domain}
+        , _flowDataPath{makeFlowDataFilePath(_domain, uuids::to_string(_flowId))}
+        , _nextStatCheck{0}
+        , _waitStrategy{}
     {}
 
     FlowReader::FlowReader::~FlowReader() = default;
@@ -30,9 +46,64 @@ namespace mxl::lib
         return _domain;
     }
 
+    std::uint32_t const* FlowReader::getSyncCounter() const
+    {
+        return &getFlowData().flowState()->syncCounter;
+    }
+
+    std::uint32_t* FlowReader::getSyncWaiters() const
+    {
+        // The waiters segment is always mapped writable, announcing ourselves doesn't modify the flow we only read from.
+        auto const waiters = getFlowData().flowWaiters();
+        return (waiters != nullptr) ? &const_cast<FlowWaiters*>(waiters)->syncWaiters : nullptr;
+    }
+
+    Timepoint FlowReader::getUnannouncedUntil() const
+    {
+        return getFlowData().unannouncedUntil();
+    }
+
+    void FlowReader::setWaitPolicy(WaitPolicy policy, Duration maxSpin) noexcept
+    {
+        _waitStrategy.configure(policy, maxSpin);
+    }
+
+    WaitStatistics FlowReader::getWaitStatistics() const noexcept
+    {
+        return _waitStrategy.statistics();
+    }
+
+    WaitStrategy& FlowReader::waitStrategy() const noexcept
+    {
+        return _waitStrategy;
+    }
+
     bool FlowReader::checkPermissions() const
     {
         auto const flowDefPath = makeFlowDescriptorFilePath(_domain, uuids::to_string(_flowId));
         return std::filesystem::is_regular_file(flowDefPath) && (::access(flowDefPath.c_str(), R_OK) == 0);
     }
+
+    bool FlowReader::isFlowStateValid(FlowState const& state) const
+    {
+        if (isFlowRetired(state))
+        {
+            return false;
+        }
+
+        auto const now = currentTime(Clock::Monotonic);
+        if (now.value < _nextStatCheck.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        struct stat st;
+        if ((::stat(_flowDataPath.c_str(), &st) != 0) || (st.st_ino != state.inode))
+        {
+            return false;
+        }
+
+        _nextStatCheck.store((now + FLOW_VALIDITY_CHECK_INTERVAL).value, std::memory_order_relaxed);
+        return true;
+    }
 }
@@ -2,10 +2,15 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl-internal/FlowSynchronizationGroup.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <mxl/time.h>
 #include "mxl-internal/ContinuousFlowReader.hpp"
 #include "mxl-internal/DiscreteFlowReader.hpp"
+#include "mxl-internal/FlowWaiters.hpp"
 #include "mxl-internal/IndexConversion.hpp"
+#include "mxl-internal/Sync.hpp"
 
 namespace mxl::lib
 {
@@ -16,7 +21,7 @@ namespace mxl::lib
         , maxObservedSourceDelay{}
     {
         auto const configInfo = reader.getFlowConfigInfo();
-        grainRate = configInfo.common.grainRate;
+        rateConverter = RateConverter{configInfo.common.grainRate};
     }
 
     FlowSynchronizationGroup::ListEntry::ListEntry(DiscreteFlowReader const& reader, std::uint16_t minValidSlices)
@@ -75,12 +80,17 @@ namespace mxl::lib
     }
 
     mxlStatus FlowSynchronizationGroup::waitForDataAt(Timepoint originTime, Timepoint deadline) const
+    {
+        return isWaitOnMultipleSupported() ? waitOnAll(originTime, deadline) : waitInSequence(originTime, deadline);
+    }
+
+    mxlStatus FlowSynchronizationGroup::waitInSequence(Timepoint originTime, Timepoint deadline) const
     {
         for (auto it = _readers.begin(); it != _readers.end(); /* Nothing */)
         {
             auto const current = it++;
 
-            auto const expectedIndex = timestampToIndex(current->grainRate, originTime);
+            auto const expectedIndex = current->rateConverter.timestampToIndex(originTime);
             auto const runtimeInfo = current->reader->getFlowRuntimeInfo();
             if (expectedIndex > runtimeInfo.headIndex)
             {
@@ -103,7 +113,7 @@ namespace mxl::lib
                     // this flow we update the cached maximum and if this new maximum turns out to be bigger than
                     // the maximum source delay observed for the flow at the head of the list, we move this flow
                     // to the front, hoping that we can save blocking waits in the future.
-                    auto const expectedArrivalTime = indexToTimestamp(current->grainRate, expectedIndex);
+                    auto const expectedArrivalTime = current->rateConverter.indexToTimestamp(expectedIndex);
                     auto const currentTaiTime = currentTime(Clock::TAI);
                     if (currentTaiTime > expectedArrivalTime)
                     {
@@ -126,4 +136,115 @@ namespace mxl::lib
         }
         return MXL_STATUS_OK;
     }
+
+    mxlStatus FlowSynchronizationGroup::waitOnAll(Timepoint originTime, Timepoint deadline) const
+    {
+        struct PendingFlow
+        {
+            ListEntry const* entry;
+            std::uint64_t expectedIndex;
+            std::uint32_t const* syncCounter;
+            std::uint32_t* syncWaiters;
+            /** Until when writers may skip waking us up, see FlowReader::getUnannouncedUntil(). */
+            Timepoint unannouncedUntil;
+            /** The value of the sync counter when the flow was last checked for data. */
+            std::uint32_t checkedCounter;
+        };
+
+        auto pending = std::array<PendingFlow, MAX_WAIT_TARGETS>{};
+        auto pendingCount = std::size_t{0};
+        for (auto const& entry : _readers)
+        {
+            auto const expectedIndex = entry.rateConverter.timestampToIndex(originTime);
+            if (expectedIndex > entry.reader->getFlowRuntimeInfo().headIndex)
+            {
+                if (pendingCount == pending.size())
+                {
+                    // More flows than we can wait on at once.
+                    return waitInSequence(originTime, deadline);
+                }
+                pending[pendingCount++] = {
+                    &entry, expectedIndex, entry.reader->getSyncCounter(), entry.reader->getSyncWaiters(), entry.reader->getUnannouncedUntil(), 0U};
+            }
+        }
+
+        auto const poll = [](PendingFlow const& flow)
+        {
+            switch (flow.entry->variant)
+            {
+                case Variant::Discrete:
+                    return static_cast<DiscreteFlowReader const*>(flow.entry->reader)->pollGrain(flow.expectedIndex, flow.entry->minValidSlices);
+
+                case Variant::Continuous: return static_cast<ContinuousFlowReader const*>(flow.entry->reader)->pollSamples(flow.expectedIndex);
+            }
+            return MXL_ERR_UNKNOWN;
+        };
+
+        auto targets = std::array<WaitTarget, MAX_WAIT_TARGETS>{};
+        for (auto firstPass = true; pendingCount > 0U; firstPass = false)
+        {
+            auto targetCount = std::size_t{0};
+            auto unannouncedUntil = Timepoint{};
+            for (auto i = std::size_t{0}; i < pendingCount; /* Nothing */)
+            {
+                auto& flow = pending[i];
+
+                // As in the blocking accessors of the readers, the counter must be sampled before checking for data, otherwise a
+                // commit in between would go unnoticed until the next one. Flows whose counter didn't change since they were last
+                // checked can't have received any data, so we spare ourselves checking them again.
+                auto const counter = std::atomic_ref{*const_cast<std::uint32_t*>(flow.syncCounter)}.load(std::memory_order_acquire);
+                if (firstPass || (counter != flow.checkedCounter))
+                {
+                    flow.checkedCounter = counter;
+                    if (auto const result = poll(flow); result == MXL_STATUS_OK)
+                    {
+                        flow = pending[--pendingCount];
+                        continue;
+                    }
+                    else if (result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
+                    {
+                        return result;
+                    }
+                }
+
+                targets[targetCount++] = {flow.syncCounter, flow.checkedCounter};
+                unannouncedUntil = std::max(unannouncedUntil, flow.unannouncedUntil);
+                ++i;
+            }
+
+            if (pendingCount == 0U)
+            {
+                break;
+            }
+
+            auto const now = currentTime(Clock::Realtime);
+            if (now >= deadline)
+            {
+                return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+            }
+
+            for (auto i = std::size_t{0}; i < pendingCount; ++i)
+            {
+                if (pending[i].syncWaiters != nullptr)
+                {
+                    std::atomic_ref{*pending[i].syncWaiters}.fetch_add(1U, std::memory_order_relaxed);
+                }
+            }
+            // Pairs with the fence in wakeSyncWaiters(), just like for a reader sleeping on a single flow.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Writers of flows we can't announce ourselves to may not wake us up yet, so don't sleep for too long on them.
+            auto const sleepDeadline = (now < unannouncedUntil) ? std::min(now + UNANNOUNCED_WAIT_INTERVAL, deadline) : deadline;
+            (void)waitUntilAnyChanged({targets.data(), targetCount}, sleepDeadline);
+
+            for (auto i = std::size_t{0}; i < pendingCount; ++i)
+            {
+                if (pending[i].syncWaiters != nullptr)
+                {
+                    std::atomic_ref{*pending[i].syncWaiters}.fetch_sub(1U, std::memory_order_relaxed);
+                }
+            }
+        }
+        return MXL_STATUS_OK;
+    }
 }
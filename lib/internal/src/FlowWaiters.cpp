@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/FlowWaiters.hpp"
+#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include "mxl-internal/Sync.hpp"
+
+namespace mxl::lib
+{
+    namespace
+    {
+        constexpr std::uint64_t makeWaitCondition(std::uint64_t index, std::uint16_t minValidSlices) noexcept
+        {
+            return (index << 16U) | minValidSlices;
+        }
+
+        constexpr bool isWaitConditionSatisfied(std::uint64_t condition, std::uint64_t index, mxlGrainInfo const& info) noexcept
+        {
+            auto const waitIndex = condition >> 16U;
+            if (index != waitIndex)
+            {
+                // Once the head moved past the awaited grain the waiter can always make progress, even if that means finding out
+                // that it is too late.
+                return index > waitIndex;
+            }
+
+            auto const minValidSlices = static_cast<std::uint16_t>(condition & 0xFFFFU);
+            return (info.validSlices >= std::min(minValidSlices, info.totalSlices)) || ((info.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+        }
+
+        void wakeSlot(FlowWaiterSlot& slot) noexcept
+        {
+            std::atomic_ref{slot.wakeCounter}.fetch_add(1U, std::memory_order_release);
+            wakeAll(&slot.wakeCounter);
+        }
+
+        std::size_t loadSlotsInUse(FlowWaiters const& waiters) noexcept
+        {
+            // NOTE: atomic_ref<T const> is only available from C++26 on.
+            return std::min<std::size_t>(
+                std::atomic_ref{const_cast<std::uint32_t&>(waiters.slotsInUse)}.load(std::memory_order_relaxed), FLOW_WAITER_SLOT_COUNT);
+        }
+    }
+
+    GrainWaiter::GrainWaiter(FlowWaiters& waiters, std::uint64_t index, std::uint16_t minValidSlices) noexcept
+        : _slot{nullptr}
+    {
+        if (index > FLOW_WAITER_MAX_INDEX)
+        {
+            return;
+        }
+
+        auto const condition = makeWaitCondition(index, minValidSlices);
+        for (auto i = std::size_t{0}; i < FLOW_WAITER_SLOT_COUNT; ++i)
+        {
+            auto expected = FLOW_WAITER_SLOT_FREE;
+            if (std::atomic_ref{waiters.slots[i].condition}.compare_exchange_strong(expected, condition, std::memory_order_relaxed))
+            {
+                _slot = &waiters.slots[i];
+
+                auto const slotsInUse = std::atomic_ref{waiters.slotsInUse};
+                auto current = slotsInUse.load(std::memory_order_relaxed);
+                while ((current <= i) && !slotsInUse.compare_exchange_weak(current, static_cast<std::uint32_t>(i + 1U), std::memory_order_relaxed))
+                {}
+
+                // Pairs with the fence in wakeGrainWaiters(): Either the writer observes our registration, or we observe its
+                // commit when checking the grain after returning from here.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return;
+            }
+        }
+    }
+
+    GrainWaiter::~GrainWaiter()
+    {
+        if (_slot != nullptr)
+        {
+            std::atomic_ref{_slot->condition}.store(FLOW_WAITER_SLOT_FREE, std::memory_order_relaxed);
+        }
+    }
+
+    bool GrainWaiter::isRegistered() const noexcept
+    {
+        return _slot != nullptr;
+    }
+
+    std::uint32_t const* GrainWaiter::wakeCounter() const noexcept
+    {
+        return &_slot->wakeCounter;
+    }
+
+    UnannouncedReaderLock::UnannouncedReaderLock(char const* waitersFilePath)
+        : UnannouncedReaderLock{}
+    {
+        if ((_fd = ::open(waitersFilePath, O_RDONLY | O_CLOEXEC)) == -1)
+        {
+            throw std::system_error{errno, std::generic_category(), "Could not open flow waiters."};
+        }
+
+        if (::flock(_fd, LOCK_SH) == -1)
+        {
+            auto const error = errno;
+            (void)::close(_fd);
+            _fd = -1;
+            throw std::system_error{error, std::generic_category(), "Could not lock flow waiters."};
+        }
+
+        _noticedBy = currentTime(Clock::Realtime) + UNANNOUNCED_READER_GRACE_PERIOD;
+    }
+
+    UnannouncedReaderLock::UnannouncedReaderLock(UnannouncedReaderLock&& other) noexcept
+        : _fd{std::exchange(other._fd, -1)}
+        , _noticedBy{other._noticedBy}
+    {}
+
+    UnannouncedReaderLock& UnannouncedReaderLock::operator=(UnannouncedReaderLock&& other) noexcept
+    {
+        std::swap(_fd, other._fd);
+        std::swap(_noticedBy, other._noticedBy);
+        return *this;
+    }
+
+    UnannouncedReaderLock::~UnannouncedReaderLock()
+    {
+        if (_fd != -1)
+        {
+            // Closing the file releases the lock.
+            (void)::close(_fd);
+        }
+    }
+
+    UnannouncedReaderProbe::UnannouncedReaderProbe(char const* waitersFilePath) noexcept
+        : UnannouncedReaderProbe{}
+    {
+        _fd = ::open(waitersFilePath, O_RDONLY | O_CLOEXEC);
+    }
+
+    UnannouncedReaderProbe::UnannouncedReaderProbe(UnannouncedReaderProbe&& other) noexcept
+        : _fd{std::exchange(other._fd, -1)}
+        , _nextCheck{other._nextCheck}
+        , _present{other._present}
+    {}
+
+    UnannouncedReaderProbe& UnannouncedReaderProbe::operator=(UnannouncedReaderProbe&& other) noexcept
+    {
+        std::swap(_fd, other._fd);
+        std::swap(_nextCheck, other._nextCheck);
+        std::swap(_present, other._present);
+        return *this;
+    }
+
+    UnannouncedReaderProbe::~UnannouncedReaderProbe()
+    {
+        if (_fd != -1)
+        {
+            (void)::close(_fd);
+        }
+    }
+
+    bool UnannouncedReaderProbe::arePresent(Timepoint now) noexcept
+    {
+        if ((_fd != -1) && (now >= _nextCheck))
+        {
+            // Costs two system calls, which is why we only do this every once in a while. The exclusive lock is only granted if no
+            // reader holds a shared one, and released right away so that readers can take theirs.
+            if (::flock(_fd, LOCK_EX | LOCK_NB) == 0)
+            {
+                (void)::flock(_fd, LOCK_UN);
+                _present = false;
+            }
+            else
+            {
+                // Any failure other than contention leaves us in the dark, so we have to assume the worst.
+                _present = true;
+            }
+            _nextCheck = now + UNANNOUNCED_READER_CHECK_INTERVAL;
+        }
+        return _present;
+    }
+
+    std::size_t wakeGrainWaiters(FlowWaiters& waiters, std::uint64_t index, mxlGrainInfo const& info) noexcept
+    {
+        // Pairs with the fence in the constructor of GrainWaiter.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto result = std::size_t{0};
+        auto const slotsInUse = loadSlotsInUse(waiters);
+        for (auto i = std::size_t{0}; i < slotsInUse; ++i)
+        {
+            auto& slot = waiters.slots[i];
+            if (auto const condition = std::atomic_ref{slot.condition}.load(std::memory_order_relaxed);
+                (condition != FLOW_WAITER_SLOT_FREE) && isWaitConditionSatisfied(condition, index, info))
+            {
+                wakeSlot(slot);
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    void wakeAllGrainWaiters(FlowWaiters& waiters) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto const slotsInUse = loadSlotsInUse(waiters);
+        for (auto i = std::size_t{0}; i < slotsInUse; ++i)
+        {
+            if (std::atomic_ref{waiters.slots[i].condition}.load(std::memory_order_relaxed) != FLOW_WAITER_SLOT_FREE)
+            {
+                wakeSlot(waiters.slots[i]);
+            }
+        }
+    }
+
+    bool wakeSyncWaiters(FlowState const& state, FlowWaiters const* waiters) noexcept
+    {
+        if (waiters != nullptr)
+        {
+            // Pairs with the fence in WaitStrategy::waitUntilChanged(): Either we observe the announcement of a reader that is
+            // about to sleep, or the futex wait of that reader observes the incremented sync counter and returns right away.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (std::atomic_ref{const_cast<std::uint32_t&>(waiters->syncWaiters)}.load(std::memory_order_relaxed) == 0U)
+            {
+                return false;
+            }
+        }
+
+        wakeAll(&state.syncCounter);
+        return true;
+    }
+}
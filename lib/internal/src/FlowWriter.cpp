@@ -6,14 +6,36 @@
 
 namespace mxl::lib
 {
-    FlowWriter::FlowWriter(uuids::uuid&& flowId, std::filesystem::path const& domain)
-        : _flowId{std::move(flowId)}
+    namespace
+    {
+        /** The inverse of the weight of a new sample in the moving average of the commit interval. */
+        constexpr auto COMMIT_INTERVAL_WEIGHT = 8;
+
+        /**
+         * Intervals longer than this multiple of the average are treated as pauses of the writer and do not affect the
+         * average. If more than COMMIT_INTERVAL_MAX_OUTLIERS of them occur in a row, the writer has changed its cadence
+         * and the average starts over.
+         */
+        constexpr auto COMMIT_INTERVAL_OUTLIER_FACTOR = 8;
+        constexpr auto COMMIT_INTERVAL_MAX_OUTLIERS = 2U;
+    }
+
+    FlowWriter::FlowWriter(FlowKind kind, uuids::uuid&& flowId, std::filesystem::path const& domain)
+        : _kind{kind}
+        , _flowId{std::move(flowId)}
         , _domain{domain}
+        , _lastCommitTime{}
+        , _commitInterval{0}
+        , _cadenceOutliers{0U}
     {}
 
-    FlowWriter::FlowWriter(uuids::uuid const& flowId, std::filesystem::path const& domain)
-        : _flowId{flowId}
+    FlowWriter::FlowWriter(FlowKind kind, uuids::uuid const& flowId, std::filesystem::path const& domain)
+        : _kind{kind}
+        , _flowId{flowId}
         , _domain{domain}
+        , _lastCommitTime{}
+        , _commitInterval{0}
+        , _cadenceOutliers{0U}
     {}
 
     FlowWriter::FlowWriter::~FlowWriter() = default;
@@ -28,4 +50,34 @@ namespace mxl::lib
         // Verify that the domain exists, is a directory and that we can traverse and write into it.
         return std::filesystem::is_directory(_domain) && (::access(_domain.c_str(), X_OK | W_OK) == 0);
     }
+
+    void FlowWriter::publishCommitCadence(mxlFlowRuntimeInfo& runtime, Timepoint now) noexcept
+    {
+        if (_lastCommitTime && (now > _lastCommitTime))
+        {
+            auto const interval = (now - _lastCommitTime).value;
+            auto const isOutlier = (interval > COMMIT_INTERVAL_OUTLIER_FACTOR * _commitInterval);
+            if ((_commitInterval == 0) || (isOutlier && (_cadenceOutliers >= COMMIT_INTERVAL_MAX_OUTLIERS)))
+            {
+                _commitInterval = interval;
+                _cadenceOutliers = 0U;
+            }
+            else if (isOutlier)
+            {
+                ++_cadenceOutliers;
+            }
+            else
+            {
+                _commitInterval += (interval - _commitInterval) / COMMIT_INTERVAL_WEIGHT;
+                _cadenceOutliers = 0U;
+            }
+        }
+        _lastCommitTime = now;
+
+        if (_commitInterval > 0)
+        {
+            runtime.commitInterval = static_cast<std::uint64_t>(_commitInterval);
+            runtime.nextCommitTime = static_cast<std::uint64_t>((now + Duration{_commitInterval}).value);
+        }
+    }
 }
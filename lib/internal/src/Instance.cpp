@@ -30,12 +30,17 @@
 #include "mxl-internal/FlowParser.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
     namespace
     {
         constexpr auto MXL_HISTORY_DURATION_OPTION = "urn:x-mxl:option:history_duration/v1.0";
+        constexpr auto MXL_READER_HEARTBEATS_OPTION = "urn:x-mxl:option:reader_heartbeats/v1.0";
+        constexpr auto MXL_HUGE_PAGES_OPTION = "urn:x-mxl:option:huge_pages/v1.0";
+        constexpr auto MXL_FLOW_POOL_SIZE_OPTION = "urn:x-mxl:option:flow_pool_size/v1.0";
+        constexpr auto MXL_TAI_CLOCK_SOURCE_OPTION = "urn:x-mxl:option:tai_clock_source/v1.0";
 
         std::once_flag loggingFlag;
 
@@ -46,6 +51,32 @@ namespace mxl::lib
             spdlog::cfg::load_env_levels("MXL_LOG_LEVEL");
         }
 
+        /// Map the name of a TAI clock source to the corresponding source.
+        ///
+        /// \param name The name of the source as used in the options.
+        /// \param source Receives the source if the name is known.
+        /// \return true if the name is known, false otherwise.
+        bool parseTaiClockSource(std::string const& name, TaiClockSource& source)
+        {
+            if (name == "kernel")
+            {
+                source = TaiClockSource::Kernel;
+            }
+            else if (name == "realtime")
+            {
+                source = TaiClockSource::Realtime;
+            }
+            else if (name == "monotonic")
+            {
+                source = TaiClockSource::Monotonic;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
         /// Simple json string parser wrapper
         ///
         /// \param options The options json string to parse
@@ -78,12 +109,15 @@ namespace mxl::lib
         DomainWatcher::ptr watcher)
         : _flowManager{mxlDomain}
         , _flowIoFactory{std::move(flowIoFactory)}
-        , _readers{}
-        , _writers{}
-        , _mutex{}
+        , _registry{}
+        , _syncGroupsMutex{}
         , _syncGroups{}
+        , _notifierMutex{}
+        , _notifier{}
         , _options{options}
         , _historyDuration{200'000'000ULL}
+        , _readerHeartbeats{false}
+        , _hugePages{false}
         , _watcher{std::move(watcher)}
         , _stopping{false}
     {
@@ -96,47 +130,96 @@ namespace mxl::lib
     {
         _stopping = true;
         _watcher->stop();
+        // Stop the notifier thread before the readers whose flows it may be waiting on go away.
+        _notifier.reset();
         MXL_DEBUG("Instance destroyed.");
 
-        for (auto& [id, writer] : _writers)
+        for (auto& shard : _registry)
         {
-            try
+            for (auto& [id, writer] : shard.writers)
             {
-                if (writer.get()->isExclusive() || writer.get()->makeExclusive())
+                try
                 {
-                    MXL_WARN("Cleaning up flow '{}' of leaked flow writer.", uuids::to_string(id));
+                    if (writer.get()->isExclusive() || writer.get()->makeExclusive())
+                    {
+                        MXL_WARN("Cleaning up flow '{}' of leaked flow writer.", uuids::to_string(id));
 
-                    _flowManager.deleteFlow(id);
+                        _flowManager.deleteFlow(id);
+                    }
+                }
+                catch (std::exception const& ex)
+                {
+                    MXL_ERROR("Failed to clean up leaked flow writer: {}", ex.what());
                 }
-            }
-            catch (std::exception const& ex)
-            {
-                MXL_ERROR("Failed to clean up leaked flow writer: {}", ex.what());
             }
         }
 
         spdlog::default_logger()->flush();
     }
 
-    FlowReader* Instance::getFlowReader(std::string const& flowId)
+    FlowReader* Instance::getFlowReader(std::string const& flowId, std::optional<std::string> const& options)
     {
         auto const id = uuids::uuid::from_string(flowId);
         // FIXME: Check result of the from_string operation.
 
-        auto const lock = std::lock_guard{_mutex};
-        if (auto const pos = _readers.find(*id); pos != _readers.end())
+        // Parse the options first, so that we don't open the flow only to fail afterwards.
+        auto const optionsParser = (options) ? FlowOptionsParser{*options} : FlowOptionsParser{};
+
+        // All references to the reader of a flow share its mapping of the channel buffers, which is chosen by whoever creates it.
+        // Asking for a different one explicitly would hand out slices of an unexpected shape, so that is refused instead.
+        auto& shard = shardFor(*id);
+        auto const checkChannelMapping = [&]()
         {
-            auto& v = (*pos).second;
-            v.addReference();
-            return v.get();
+            if (auto const requested = optionsParser.getChannelMapping(); requested)
+            {
+                if (auto const pos = shard.readerChannelMappings.find(*id); (pos != shard.readerChannelMappings.end()) && (pos->second != *requested))
+                {
+                    throw std::invalid_argument{"The reader of the flow already exists with a different channel mapping."};
+                }
+            }
+        };
+
+        {
+            auto const lock = std::lock_guard{shard.mutex};
+            if (auto const pos = shard.readers.find(*id); pos != shard.readers.end())
+            {
+                checkChannelMapping();
+                auto& v = (*pos).second;
+                v.addReference();
+                return v.get();
+            }
         }
-        else
+
+        // Open the flow without holding the lock, so that mapping it doesn't stall other flows in the same shard.
+        auto flowData = _flowManager.openFlow(*id,
+            AccessMode::READ_ONLY,
+            optionsParser.getGrainMapping().value_or(GrainMapping::Eager),
+            optionsParser.getChannelMapping().value_or(ChannelMapping::Linear));
+        auto reader = _flowIoFactory->createFlowReader(_flowManager, *id, std::move(flowData));
+        if (auto const waitPolicy = optionsParser.getWaitPolicy(); waitPolicy)
         {
-            auto flowData = _flowManager.openFlow(*id, AccessMode::READ_ONLY);
-            auto reader = _flowIoFactory->createFlowReader(_flowManager, *id, std::move(flowData));
+            reader->setWaitPolicy(*waitPolicy, optionsParser.getMaxSpinDuration().value_or(WaitStrategy::DEFAULT_MAX_SPIN));
+        }
 
-            return (*_readers.try_emplace(pos, *id, std::move(reader))).second.get();
+        auto const channelMapping = mxlIsContinuousDataFormat(reader->getFlowConfigInfo().common.format)
+                                      ? std::make_optional(optionsParser.getChannelMapping().value_or(ChannelMapping::Linear))
+                                      : std::nullopt;
+
+        auto const lock = std::lock_guard{shard.mutex};
+        if (auto const pos = shard.readers.find(*id); pos != shard.readers.end())
+        {
+            // Another thread opened the flow in the meantime, in which case the reader we created is discarded once the
+            // lock has been released.
+            checkChannelMapping();
+            (*pos).second.addReference();
+            return (*pos).second.get();
         }
+
+        if (channelMapping)
+        {
+            shard.readerChannelMappings.insert_or_assign(*id, *channelMapping);
+        }
+        return shard.readers.try_emplace(*id, std::move(reader)).first->second.get();
     }
 
     void Instance::releaseReader(FlowReader* reader)
@@ -144,55 +227,123 @@ namespace mxl::lib
         if (reader)
         {
             auto const& id = reader->getId();
+            auto& shard = shardFor(id);
 
-            auto const lock = std::lock_guard{_mutex};
-            if (auto const pos = _readers.find(id); pos != _readers.end())
+            auto node = decltype(shard.readers)::node_type{};
             {
-                if ((*pos).second.releaseReference())
+                auto const lock = std::lock_guard{shard.mutex};
+                if (auto const pos = shard.readers.find(id); pos != shard.readers.end())
                 {
-                    // Remove from the synchronization groups
+                    if ((*pos).second.releaseReference())
+                    {
+                        node = shard.readers.extract(pos);
+                        shard.readerChannelMappings.erase(id);
+                    }
+                }
+            }
+
+            if (node)
+            {
+                // Remove from the synchronization groups
+                {
+                    auto const lock = std::lock_guard{_syncGroupsMutex};
                     for (auto& group : _syncGroups)
                     {
                         group.removeReader(*reader);
                     }
-                    _readers.erase(pos);
                 }
+                {
+                    auto const lock = std::lock_guard{_notifierMutex};
+                    if (_notifier)
+                    {
+                        _notifier->remove(*reader);
+                    }
+                }
+                // The reader is destroyed along with the node, outside of all locks.
             }
         }
     }
 
+    int Instance::getWaitHandle(FlowReader const& reader, std::uint64_t index, std::uint16_t minValidSlices)
+    {
+        // Holding the lock of the shard until the handle is armed ensures that the reader can't be released in the meantime.
+        auto& shard = shardFor(reader.getId());
+        auto const lock = std::lock_guard{shard.mutex};
+        if (auto const pos = shard.readers.find(reader.getId()); (pos == shard.readers.end()) || (pos->second.get() != &reader))
+        {
+            throw std::invalid_argument{"The reader does not belong to this instance."};
+        }
+
+        auto const notifierLock = std::lock_guard{_notifierMutex};
+        if (!_notifier)
+        {
+            _notifier = std::make_unique<FlowNotifier>();
+        }
+        return _notifier->arm(reader, index, minValidSlices);
+    }
+
     void Instance::releaseWriter(FlowWriter* writer)
     {
         if (writer)
         {
             auto const id = writer->getId();
+            auto& shard = shardFor(id);
+            auto const writerLock = std::lock_guard{shard.writerMutex};
+
+            auto node = decltype(shard.writers)::node_type{};
             {
-                auto const lock = std::lock_guard{_mutex};
-                if (auto const pos = _writers.find(id); pos != _writers.end())
+                auto const lock = std::lock_guard{shard.mutex};
+                if (auto const pos = shard.writers.find(id); pos != shard.writers.end())
                 {
                     if ((*pos).second.releaseReference())
                     {
-                        // Delete the flow if we are the last writer.
-                        if (writer->isExclusive() || writer->makeExclusive())
-                        {
-                            _flowManager.deleteFlow(id);
-                        }
-
-                        _writers.erase(pos);
+                        node = shard.writers.extract(pos);
+                        shard.writerChannelMappings.erase(id);
                     }
                 }
             }
+
+            // Delete the flow if we are the last writer.
+            if (node && (writer->isExclusive() || writer->makeExclusive()))
+            {
+                _flowManager.deleteFlow(id);
+            }
         }
     }
 
     std::tuple<mxlFlowConfigInfo, FlowWriter*, bool> Instance::createFlowWriter(std::string const& flowDef, std::optional<std::string> options)
     {
-        auto const lock = std::lock_guard{_mutex};
         auto const parser = FlowParser{flowDef};
         auto const optionsParser = (options) ? FlowOptionsParser{*options} : FlowOptionsParser{};
+
+        // Creating the flow may take a while, so only other writers of flows in the same shard wait for it, while readers
+        // can proceed.
+        auto& shard = shardFor(parser.getId());
+        auto const writerLock = std::lock_guard{shard.writerMutex};
+
+        // Look for an existing writer first, so that we don't map the flow only to discard it again. As for readers, all references
+        // to the writer of a flow share its mapping of the channel buffers, so asking for a different one explicitly is refused.
+        {
+            auto const lock = std::lock_guard{shard.mutex};
+            if (auto const pos = shard.writers.find(parser.getId()); pos != shard.writers.end())
+            {
+                if (auto const requested = optionsParser.getChannelMapping(); requested)
+                {
+                    if (auto const mapping = shard.writerChannelMappings.find(parser.getId());
+                        (mapping != shard.writerChannelMappings.end()) && (mapping->second != *requested))
+                    {
+                        throw std::invalid_argument{"The writer of the flow already exists with a different channel mapping."};
+                    }
+                }
+
+                auto& v = (*pos).second;
+                v.addReference();
+                return {v.get()->getFlowConfigInfo(), v.get(), false};
+            }
+        }
+
         auto created = false;
         auto flowData = std::unique_ptr<FlowData>{};
-        FlowWriter* flowWriter = nullptr;
 
         if (auto const format = parser.getFormat(); mxlIsDiscreteDataFormat(format))
         {
@@ -214,20 +365,15 @@ namespace mxl::lib
         auto id = uuids::uuid{flowData->flowInfo()->config.common.id};
         auto flowConfigInfo = flowData->flowInfo()->config;
 
-        if (auto const pos = _writers.find(id); pos != _writers.end())
-        {
-            auto& v = (*pos).second;
-            v.addReference();
-            flowWriter = v.get();
-        }
-        else
-        {
-            auto writer = _flowIoFactory->createFlowWriter(_flowManager, id, std::move(flowData));
+        auto writer = _flowIoFactory->createFlowWriter(_flowManager, id, std::move(flowData));
 
-            flowWriter = (*_writers.try_emplace(pos, id, std::move(writer))).second.get();
+        // Writers are only ever added while holding the writer lock, so nobody can have added one in the meantime.
+        auto const lock = std::lock_guard{shard.mutex};
+        if (mxlIsContinuousDataFormat(flowConfigInfo.common.format))
+        {
+            shard.writerChannelMappings.insert_or_assign(id, optionsParser.getChannelMapping().value_or(ChannelMapping::Linear));
         }
-
-        return {flowConfigInfo, flowWriter, created};
+        return {flowConfigInfo, (*shard.writers.try_emplace(id, std::move(writer)).first).second.get(), created};
     }
 
     std::pair<std::unique_ptr<FlowData>, bool> Instance::createOrOpenDiscreteFlowData(std::string const& flowDef, FlowParser const& parser,
@@ -249,7 +395,12 @@ namespace mxl::lib
             parser.getTotalPayloadSlices(),
             parser.getPayloadSliceLengths(),
             optionsParser.getMaxSyncBatchSizeHint().value_or(batchSizeDefault),
-            optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault));
+            optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault),
+            optionsParser.getDiscreteFlowLayout().value_or(DiscreteFlowLayout::PerGrainFiles),
+            _readerHeartbeats,
+            _hugePages,
+            optionsParser.getPrefault().value_or(false),
+            optionsParser.getFlowWaiters().value_or(false));
 
         return {std::move(flowData), created};
     }
@@ -259,21 +410,30 @@ namespace mxl::lib
     {
         // Read the mandatory grain_rate field
         auto const sampleRate = parser.getGrainRate();
+
+        // Default to 10ms worth of samples
+        auto batchSizeDefault = parser.getGrainRate().numerator / (100U * parser.getGrainRate().denominator);
+        auto const commitBatchSize = optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault);
+
+        auto const layout = optionsParser.getContinuousFlowLayout().value_or(ContinuousFlowLayout::Planar);
+        auto const flowWaiters = optionsParser.getFlowWaiters().value_or(false);
+
         // Compute the buffer length based on our configured history duration.
-        // The length is divided by 500M instead of 1B to effectively make it twice the
-        // history duration, which is necessary, because only half of the buffer is
-        // accessible for reading at any one point in time.
-        auto const bufferLength = _historyDuration * sampleRate.numerator / (500'000'000ULL * sampleRate.denominator);
+        // Flows that older SDK versions can open are made twice the history
+        // duration, because only half of the buffer is accessible for reading
+        // at any one point in time. Other flows only add one commit batch
+        // worth of samples on top, because readers can not access the samples
+        // that the writer is about to overwrite.
+        auto const historyLength = _historyDuration * sampleRate.numerator / (1'000'000'000ULL * sampleRate.denominator);
+        auto const legacyFlow = (layout == ContinuousFlowLayout::Planar) && !flowWaiters;
+        auto const bufferLength = legacyFlow ? (2U * historyLength) : (historyLength + commitBatchSize);
 
         auto const sampleWordSize = parser.getPayloadSize();
-        // FIXME: The page size is just an educated guess to round to for good measure
-        auto const lengthPerPage = 4096U / sampleWordSize;
+        // Round to whole pages, which also allows readers and writers to mirror the channel buffers.
+        auto const lengthPerPage = pageSize() / sampleWordSize;
 
         auto const pageAlignedLength = ((bufferLength + lengthPerPage - 1U) / lengthPerPage) * lengthPerPage;
 
-        // Default to 10ms worth of samples
-        auto batchSizeDefault = parser.getGrainRate().numerator / (100U * parser.getGrainRate().denominator);
-
         auto [created, flowData] = _flowManager.createOrOpenContinuousFlow(parser.getId(),
             flowDef,
             parser.getFormat(),
@@ -282,11 +442,19 @@ namespace mxl::lib
             sampleWordSize,
             pageAlignedLength,
             optionsParser.getMaxSyncBatchSizeHint().value_or(batchSizeDefault),
-            optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault));
+            commitBatchSize,
+            layout,
+            optionsParser.getChannelMapping().value_or(ChannelMapping::Linear),
+            flowWaiters);
 
         return {std::move(flowData), created};
     }
 
+    Instance::RegistryShard& Instance::shardFor(uuids::uuid const& id) noexcept
+    {
+        return _registry[std::hash<uuids::uuid>{}(id) % REGISTRY_SHARD_COUNT];
+    }
+
     std::string Instance::getDomain() const
     {
         return _flowManager.getDomain();
@@ -337,6 +505,12 @@ namespace mxl::lib
                         // The flow is not active.  remove it (the folder and everything in it)
                         if (!active)
                         {
+                            // Let readers that are still attached to the flow know that it is going away.
+                            if (auto const id = uuids::uuid::from_string(entry.path().stem().string()); id)
+                            {
+                                _flowManager.retireFlow(*id);
+                            }
+
                             std::error_code ec;
                             std::filesystem::remove_all(entry.path(), ec);
                             if (ec)
@@ -355,6 +529,12 @@ namespace mxl::lib
             {
                 MXL_DEBUG("MXL domain {} does not exist or is not a directory", base.string());
             }
+
+            // Spare flow skeletons are not flows, so they don't count towards the number of collected flows.
+            if (auto const trimmed = _flowManager.trimFlowPool(); trimmed > 0U)
+            {
+                MXL_DEBUG("Removed {} spare flow skeletons from the flow pool", trimmed);
+            }
         }
         catch (std::exception const& e)
         {
@@ -374,6 +554,9 @@ namespace mxl::lib
 
         // Start with the default history duration
         std::uint64_t historyDuration = _historyDuration;
+        bool readerHeartbeats = _readerHeartbeats;
+        bool hugePages = _hugePages;
+        std::size_t flowPoolSize = 0U;
 
         //
         // Try to parse the options.json file found in the MXL domain directory.
@@ -400,6 +583,21 @@ namespace mxl::lib
                         MXL_TRACE("Found history duration option in domain specific options: {}ns", it->second.get<double>());
                         historyDuration = static_cast<std::uint64_t>(it->second.get<double>());
                     }
+                    if (auto it = config.find(MXL_READER_HEARTBEATS_OPTION); it != config.end() && it->second.is<bool>())
+                    {
+                        MXL_TRACE("Found reader heartbeats option in domain specific options: {}", it->second.get<bool>());
+                        readerHeartbeats = it->second.get<bool>();
+                    }
+                    if (auto it = config.find(MXL_HUGE_PAGES_OPTION); it != config.end() && it->second.is<bool>())
+                    {
+                        MXL_TRACE("Found huge pages option in domain specific options: {}", it->second.get<bool>());
+                        hugePages = it->second.get<bool>();
+                    }
+                    if (auto it = config.find(MXL_FLOW_POOL_SIZE_OPTION); it != config.end() && it->second.is<double>())
+                    {
+                        MXL_TRACE("Found flow pool size option in domain specific options: {}", it->second.get<double>());
+                        flowPoolSize = static_cast<std::size_t>(it->second.get<double>());
+                    }
                 }
                 else
                 {
@@ -415,7 +613,27 @@ namespace mxl::lib
             if (parseOptionsJson(options, config))
             {
                 // We are not considering MXL_HISTORY_DURATION_TAG here. we don't want per-instance history durations.
-                // In the future we might want to use this mecanism to set other options that would be instance specific.
+                if (auto it = config.find(MXL_TAI_CLOCK_SOURCE_OPTION); it != config.end() && it->second.is<std::string>())
+                {
+                    auto const& name = it->second.get<std::string>();
+                    auto source = TaiClockSource::Kernel;
+                    if (!parseTaiClockSource(name, source))
+                    {
+                        MXL_ERROR("Unknown TAI clock source: {}", name);
+                    }
+                    else if (auto const status = setTaiClockSource(source); status == TaiClockSourceStatus::Conflicting)
+                    {
+                        MXL_ERROR("TAI clock source '{}' conflicts with the source selected earlier in this process, keeping that one.", name);
+                    }
+                    else if (status == TaiClockSourceStatus::Inaccurate)
+                    {
+                        MXL_WARN("TAI clock source '{}' does not track the kernel TAI clock, keeping the current source.", name);
+                    }
+                    else
+                    {
+                        MXL_DEBUG("TAI clock source set to {}", name);
+                    }
+                }
             }
             else
             {
@@ -426,6 +644,10 @@ namespace mxl::lib
         // Set the history duration
         _historyDuration = historyDuration;
         MXL_DEBUG("History duration set to {} ns", historyDuration);
+
+        _readerHeartbeats = readerHeartbeats;
+        _hugePages = hugePages;
+        _flowManager.setFlowPoolSize(flowPoolSize);
     }
 
     std::uint64_t Instance::getHistoryDurationNs() const
@@ -435,11 +657,13 @@ namespace mxl::lib
 
     FlowSynchronizationGroup* Instance::createFlowSynchronizationGroup()
     {
+        auto const lock = std::lock_guard{_syncGroupsMutex};
         return &_syncGroups.emplace_front();
     }
 
     void Instance::releaseFlowSynchronizationGroup(FlowSynchronizationGroup const* group)
     {
+        auto const lock = std::lock_guard{_syncGroupsMutex};
         auto prev = _syncGroups.before_begin();
         for (auto current = std::next(prev); current != _syncGroups.end(); ++current)
         {
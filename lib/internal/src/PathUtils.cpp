@@ -31,6 +31,18 @@ namespace mxl::lib
         return flowDirectory / FLOW_ACCESS_FILE_NAME;
     }
 
+    MXL_EXPORT
+    std::filesystem::path makeFlowHeartbeatsFilePath(std::filesystem::path const& flowDirectory)
+    {
+        return flowDirectory / FLOW_HEARTBEATS_FILE_NAME;
+    }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowWaitersFilePath(std::filesystem::path const& flowDirectory)
+    {
+        return flowDirectory / FLOW_WAITERS_FILE_NAME;
+    }
+
     MXL_EXPORT
     std::filesystem::path makeGrainDirectoryName(std::filesystem::path const& flowDirectory)
     {
@@ -43,6 +55,12 @@ namespace mxl::lib
         return grainDirectory / fmt::format("{}.{}", GRAIN_DATA_FILE_NAME_STEM, index);
     }
 
+    MXL_EXPORT
+    std::filesystem::path makeGrainSegmentFilePath(std::filesystem::path const& grainDirectory)
+    {
+        return grainDirectory / GRAIN_SEGMENT_FILE_NAME;
+    }
+
     MXL_EXPORT
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& flowDirectory)
     {
@@ -54,4 +72,10 @@ namespace mxl::lib
     {
         return domain / (DOMAIN_OPTIONS_FILE_NAME);
     }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowPoolDirectoryName(std::filesystem::path const& domain)
+    {
+        return domain / FLOW_POOL_DIRECTORY_NAME;
+    }
 }
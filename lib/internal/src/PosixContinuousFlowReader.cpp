@@ -3,15 +3,14 @@
 
 #include "PosixContinuousFlowReader.hpp"
 #include <atomic>
-#include <sys/stat.h>
-#include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/FlowWaiters.hpp"
 #include "mxl-internal/Sync.hpp"
 
 namespace mxl::lib
 {
     PosixContinuousFlowReader::PosixContinuousFlowReader(FlowManager const& manager, uuids::uuid const& flowId,
         std::unique_ptr<ContinuousFlowData>&& data)
-        : ContinuousFlowReader{flowId, manager.getDomain()}
+        : ContinuousFlowReader{data->layout(), flowId, manager.getDomain()}
         , _flowData{std::move(data)}
         , _channelCount{_flowData->channelCount()}
         , _bufferLength{_flowData->channelBufferLength()}
@@ -20,6 +19,9 @@ namespace mxl::lib
         {
             throw std::runtime_error{"Flow is not accessible due to insufficient permissions."};
         }
+
+        // If we can not announce that we are sleeping, writers may not wake us up until they noticed us in some other way.
+        waitStrategy().limitSleep(UNANNOUNCED_WAIT_INTERVAL, _flowData->unannouncedUntil());
     }
 
     FlowData const& PosixContinuousFlowReader::getFlowData() const
@@ -48,7 +50,7 @@ namespace mxl::lib
 
     std::size_t PosixContinuousFlowReader::getMaxReadLength() const
     {
-        return _bufferLength / 2U;
+        return _flowData->maxAccessLength();
     }
 
     mxlStatus PosixContinuousFlowReader::waitForSamples(std::uint64_t index, Timepoint deadline) const
@@ -67,8 +69,19 @@ namespace mxl::lib
         return MXL_ERR_UNKNOWN;
     }
 
+    mxlStatus PosixContinuousFlowReader::pollSamples(std::uint64_t index) const
+    {
+        if (_flowData)
+        {
+            auto const result = getSamplesImpl(index, 0U, nullptr);
+            return ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || isFlowValidImpl()) ? result : MXL_ERR_FLOW_INVALID;
+        }
+
+        return MXL_ERR_UNKNOWN;
+    }
+
     mxlStatus PosixContinuousFlowReader::getSamples(std::uint64_t index, std::size_t count, Timepoint deadline,
-        mxlWrappedMultiBufferSlice& payloadBuffersSlices)
+        mxlStridedWrappedMultiBufferSlice& payloadBuffersSlices)
     {
         if (_flowData)
         {
@@ -84,7 +97,7 @@ namespace mxl::lib
         return MXL_ERR_UNKNOWN;
     }
 
-    mxlStatus PosixContinuousFlowReader::getSamples(std::uint64_t index, std::size_t count, mxlWrappedMultiBufferSlice& payloadBuffersSlices)
+    mxlStatus PosixContinuousFlowReader::getSamples(std::uint64_t index, std::size_t count, mxlStridedWrappedMultiBufferSlice& payloadBuffersSlices)
     {
         if (_flowData)
         {
@@ -106,23 +119,24 @@ namespace mxl::lib
 
     bool PosixContinuousFlowReader::isFlowValidImpl() const
     {
-        auto const flowState = _flowData->flowState();
-        auto const flowDataPath = makeFlowDataFilePath(getDomain(), to_string(getId()));
-
-        struct stat st;
-        if (::stat(flowDataPath.string().c_str(), &st) != 0)
-        {
-            return false;
-        }
-        return (st.st_ino == flowState->inode);
+        return isFlowStateValid(*_flowData->flowState());
     }
 
     mxlStatus PosixContinuousFlowReader::getSamplesImpl(std::uint64_t index, std::size_t count,
-        mxlWrappedMultiBufferSlice* payloadBuffersSlices) const
+        mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices) const
     {
-        if (auto const headIndex = _flowData->flowInfo()->runtime.headIndex; index <= headIndex)
+        auto const& runtime = _flowData->flowInfo()->runtime;
+        if (auto const headIndex = runtime.headIndex; index <= headIndex)
         {
-            auto const minIndex = (headIndex >= (_bufferLength / 2U)) ? (headIndex - (_bufferLength / 2U)) : std::uint64_t{0};
+            // Callers that copy the samples call us again afterwards to check that the writer didn't overwrite them in the
+            // meantime, so the index of the batch that the writer opened last has to be read after the samples.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // NOTE: atomic_ref<T const> is only available from C++26 on.
+            auto const openHeadIndex = std::atomic_ref{const_cast<std::uint64_t&>(runtime.openHeadIndex)}.load(std::memory_order_relaxed);
+
+            // Writers that don't publish the index they opened last may be writing up to half of the buffer ahead of the head.
+            auto const writeLimit = (openHeadIndex >= headIndex) ? openHeadIndex : (headIndex + (_bufferLength / 2U));
+            auto const minIndex = (writeLimit >= _bufferLength) ? (writeLimit - _bufferLength) : std::uint64_t{0};
 
             if ((index >= minIndex) && ((index - minIndex) >= count))
             {
@@ -131,20 +145,22 @@ namespace mxl::lib
                     auto const startOffset = (index + _bufferLength - count) % _bufferLength;
                     auto const endOffset = (index % _bufferLength);
 
-                    auto const firstLength = (startOffset < endOffset) ? count : _bufferLength - startOffset;
+                    // Mirrored channel buffers continue past their end, so the window never has to be split.
+                    auto const firstLength = (_flowData->channelRingsMirrored() || (startOffset < endOffset)) ? count : _bufferLength - startOffset;
                     auto const secondLength = count - firstLength;
 
-                    auto const baseBufferPtr = static_cast<std::uint8_t const*>(_flowData->channelData());
-                    auto const sampleWordSize = _flowData->sampleWordSize();
+                    auto const baseBufferPtr = static_cast<std::uint8_t const*>(_flowData->channelRings());
+                    auto const sampleStride = _flowData->sampleStride();
 
-                    payloadBuffersSlices->base.fragments[0].pointer = baseBufferPtr + sampleWordSize * startOffset;
-                    payloadBuffersSlices->base.fragments[0].size = sampleWordSize * firstLength;
+                    payloadBuffersSlices->base.fragments[0].pointer = baseBufferPtr + sampleStride * startOffset;
+                    payloadBuffersSlices->base.fragments[0].size = sampleStride * firstLength;
 
                     payloadBuffersSlices->base.fragments[1].pointer = baseBufferPtr;
-                    payloadBuffersSlices->base.fragments[1].size = sampleWordSize * secondLength;
+                    payloadBuffersSlices->base.fragments[1].size = sampleStride * secondLength;
 
-                    payloadBuffersSlices->stride = sampleWordSize * _bufferLength;
+                    payloadBuffersSlices->stride = _flowData->channelRingStride();
                     payloadBuffersSlices->count = _channelCount;
+                    payloadBuffersSlices->elementStride = sampleStride;
                 }
 
                 return MXL_STATUS_OK;
@@ -157,22 +173,42 @@ namespace mxl::lib
     }
 
     mxlStatus PosixContinuousFlowReader::getSamplesImpl(std::uint64_t index, std::size_t count, Timepoint deadline,
-        mxlWrappedMultiBufferSlice* payloadBuffersSlices) const
+        mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices) const
     {
         auto const flow = _flowData->flow();
         auto const syncObject = std::atomic_ref{flow->state.syncCounter};
+        auto const waiters = _flowData->flowWaiters();
+        auto const sleepers = (waiters != nullptr) ? &waiters->syncWaiters : nullptr;
+        auto woken = false;
         while (true)
         {
             auto const previousSyncCounter = syncObject.load(std::memory_order_acquire);
             auto const result = getSamplesImpl(index, count, payloadBuffersSlices);
+            // There is no point in waiting for new data if the flow has been retired in the meantime.
+            if ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || isFlowRetired(flow->state))
+            {
+                return result;
+            }
+            if (woken)
+            {
+                waitStrategy().recordWastedWakeup();
+            }
+
             // NOTE: Before C++26 there is no way to access the address of the object wrapped
             //      by an atomic_ref. If there were it would be much more appropriate to pass
             //      syncObject by reference here and only unwrap the underlying integer in the
             //      implementation of waitUntilChanged.
-            if ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || !waitUntilChanged(&flow->state.syncCounter, previousSyncCounter, deadline))
+            if (!waitStrategy().waitUntilChanged(
+                    &flow->state.syncCounter,
+                    previousSyncCounter,
+                    deadline,
+                    &flow->info.runtime.lastWriteTime,
+                    sleepers,
+                    &flow->info.runtime.nextCommitTime))
             {
                 return result;
             }
+            woken = true;
         }
     }
 }
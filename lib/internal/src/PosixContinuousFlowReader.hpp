@@ -52,12 +52,15 @@ namespace mxl::lib
         /** \see ContinuousFlowReader::waitForSamples */
         virtual mxlStatus waitForSamples(std::uint64_t index, Timepoint deadline) const override;
 
+        /** \see ContinuousFlowReader::pollSamples */
+        virtual mxlStatus pollSamples(std::uint64_t index) const override;
+
         /** \see ContinuousFlowReader::getSamples */
         virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, Timepoint deadline,
-            mxlWrappedMultiBufferSlice& payloadBuffersSlices) override;
+            mxlStridedWrappedMultiBufferSlice& payloadBuffersSlices) override;
 
         /** \see ContinuousFlowReader::getSamples */
-        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, mxlWrappedMultiBufferSlice& payloadBuffersSlices) override;
+        virtual mxlStatus getSamples(std::uint64_t index, std::size_t count, mxlStridedWrappedMultiBufferSlice& payloadBuffersSlices) override;
 
     protected:
         /** \see FlowReader::isFlowValid */
@@ -78,7 +81,7 @@ namespace mxl::lib
          * used by other methods that have previously asserted that we're
          * operating on a valid flow (i.e. that _flowData is a valid pointer).
          */
-        mxlStatus getSamplesImpl(std::uint64_t index, std::size_t count, mxlWrappedMultiBufferSlice* payloadBuffersSlices) const;
+        mxlStatus getSamplesImpl(std::uint64_t index, std::size_t count, mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices) const;
 
         /**
          * Implementation of the blocking form of getSamples() and waitForSamples()
@@ -86,7 +89,8 @@ namespace mxl::lib
          * that we're operating on a valid flow (i.e. that _flowData is a valid
          * pointer).
          */
-        mxlStatus getSamplesImpl(std::uint64_t index, std::size_t count, Timepoint deadline, mxlWrappedMultiBufferSlice* payloadBuffersSlices) const;
+        mxlStatus getSamplesImpl(std::uint64_t index, std::size_t count, Timepoint deadline,
+            mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices) const;
 
     private:
         std::unique_ptr<ContinuousFlowData> _flowData;
@@ -2,15 +2,18 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PosixContinuousFlowWriter.hpp"
+#include <atomic>
 #include <stdexcept>
 #include <mxl/time.h>
+#include "mxl-internal/FlowWaiters.hpp"
 #include "mxl-internal/Sync.hpp"
+#include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
     PosixContinuousFlowWriter::PosixContinuousFlowWriter(FlowManager const& manager, uuids::uuid const& flowId,
         std::unique_ptr<ContinuousFlowData>&& data)
-        : ContinuousFlowWriter{flowId, manager.getDomain()}
+        : ContinuousFlowWriter{data->layout(), flowId, manager.getDomain()}
         , _flowData{std::move(data)}
         , _channelCount{_flowData->channelCount()}
         , _bufferLength{_flowData->channelBufferLength()}
@@ -68,32 +71,37 @@ namespace mxl::lib
 
     std::size_t PosixContinuousFlowWriter::getMaxWriteLength() const
     {
-        return _bufferLength / 2U;
+        return _flowData->maxAccessLength();
     }
 
-    mxlStatus PosixContinuousFlowWriter::openSamples(std::uint64_t index, std::size_t count, mxlMutableWrappedMultiBufferSlice& payloadBufferSlices)
+    mxlStatus PosixContinuousFlowWriter::openSamples(std::uint64_t index, std::size_t count,
+        mxlMutableStridedWrappedMultiBufferSlice& payloadBufferSlices)
     {
         if (_flowData)
         {
-            if (count <= (_bufferLength / 2))
+            if (count <= _flowData->maxAccessLength())
             {
+                publishOpenHeadIndex(index);
+
                 auto const startOffset = (index + _bufferLength - count) % _bufferLength;
                 auto const endOffset = (index % _bufferLength);
 
-                auto const firstLength = (startOffset < endOffset) ? count : _bufferLength - startOffset;
+                // Mirrored channel buffers continue past their end, so the window never has to be split.
+                auto const firstLength = (_flowData->channelRingsMirrored() || (startOffset < endOffset)) ? count : _bufferLength - startOffset;
                 auto const secondLength = count - firstLength;
 
-                auto const baseBufferPtr = static_cast<std::uint8_t*>(_flowData->channelData());
-                auto const sampleWordSize = _flowData->sampleWordSize();
+                auto const baseBufferPtr = static_cast<std::uint8_t*>(_flowData->channelRings());
+                auto const sampleStride = _flowData->sampleStride();
 
-                payloadBufferSlices.base.fragments[0].pointer = baseBufferPtr + sampleWordSize * startOffset;
-                payloadBufferSlices.base.fragments[0].size = sampleWordSize * firstLength;
+                payloadBufferSlices.base.fragments[0].pointer = baseBufferPtr + sampleStride * startOffset;
+                payloadBufferSlices.base.fragments[0].size = sampleStride * firstLength;
 
                 payloadBufferSlices.base.fragments[1].pointer = baseBufferPtr;
-                payloadBufferSlices.base.fragments[1].size = sampleWordSize * secondLength;
+                payloadBufferSlices.base.fragments[1].size = sampleStride * secondLength;
 
-                payloadBufferSlices.stride = sampleWordSize * _bufferLength;
+                payloadBufferSlices.stride = _flowData->channelRingStride();
                 payloadBufferSlices.count = _channelCount;
+                payloadBufferSlices.elementStride = sampleStride;
 
                 _currentIndex = index;
 
@@ -115,9 +123,17 @@ namespace mxl::lib
 
             if (signalCompletedBatch())
             {
+                // Only updated once per synchronization batch, which is precise enough for both the flow metadata and
+                // readers measuring their wake-up latency. Readers are only woken up once per batch as well, so this is
+                // also the cadence that they are interested in.
+                auto const now = currentTime(Clock::TAI);
+                flow->info.runtime.lastWriteTime = now.value;
+                publishCommitCadence(flow->info.runtime, now);
+
                 // Let readers know that the head has moved
-                flow->state.syncCounter++;
-                wakeAll(&flow->state.syncCounter);
+                // This is skipped if none of them announced that it is sleeping, which saves a system call per commit.
+                std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
+                (void)wakeSyncWaiters(flow->state, _flowData->announcedFlowWaiters(now));
             }
 
             return MXL_STATUS_OK;
@@ -135,6 +151,19 @@ namespace mxl::lib
         return MXL_STATUS_OK;
     }
 
+    void PosixContinuousFlowWriter::publishOpenHeadIndex(std::uint64_t index) noexcept
+    {
+        auto const openHeadIndex = std::atomic_ref{_flowData->flow()->info.runtime.openHeadIndex};
+
+        // Only ever move forward, so that a batch that rewrites older samples doesn't hide one that is still in progress.
+        auto current = openHeadIndex.load(std::memory_order_relaxed);
+        while ((current < index) && !openHeadIndex.compare_exchange_weak(current, index, std::memory_order_relaxed))
+        {}
+
+        // Readers check the index after copying samples, so it has to be visible before the first sample is overwritten.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
     bool PosixContinuousFlowWriter::signalCompletedBatch() noexcept
     {
         auto const flow = _flowData->flow();
@@ -57,7 +57,7 @@ namespace mxl::lib
         virtual std::size_t getMaxWriteLength() const override;
 
         /** \see ContinuousFlowWriter::openSamples */
-        virtual mxlStatus openSamples(std::uint64_t index, std::size_t count, mxlMutableWrappedMultiBufferSlice& payloadBufferSlices) override;
+        virtual mxlStatus openSamples(std::uint64_t index, std::size_t count, mxlMutableStridedWrappedMultiBufferSlice& payloadBufferSlices) override;
 
         /** \see ContinuousFlowWriter::commit */
         virtual mxlStatus commit() override;
@@ -71,6 +71,13 @@ namespace mxl::lib
         virtual bool makeExclusive() override;
 
     private:
+        /**
+         * Publish the head index of a batch that is about to be opened in the
+         * runtime information of the flow, before any of its samples are
+         * written, so that readers stop handing out the samples it overwrites.
+         */
+        void publishOpenHeadIndex(std::uint64_t index) noexcept;
+
         bool signalCompletedBatch() noexcept;
 
     private:
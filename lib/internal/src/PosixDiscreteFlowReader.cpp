@@ -4,6 +4,7 @@
 #include "PosixDiscreteFlowReader.hpp"
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <algorithm>
 #include <array>
@@ -19,6 +20,7 @@
 #include <mxl/time.h>
 #include "mxl-internal/Flow.hpp"
 #include "mxl-internal/FlowManager.hpp"
+#include "mxl-internal/FlowWaiters.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
 #include "mxl-internal/SharedMemory.hpp"
@@ -40,14 +42,25 @@ namespace mxl::lib
     PosixDiscreteFlowReader::PosixDiscreteFlowReader(FlowManager const& manager, uuids::uuid const& flowId, std::unique_ptr<DiscreteFlowData>&& data)
         : DiscreteFlowReader{flowId, manager.getDomain()}
         , _flowData{std::move(data)}
+        , _heartbeat{}
         , _accessFileFd{-1}
     {
-        auto const accessFile = makeFlowAccessFilePath(manager.getDomain(), to_string(flowId));
-        _accessFileFd = ::open(accessFile.string().c_str(), O_RDWR);
+        if (auto const heartbeats = _flowData->readerHeartbeats(); heartbeats != nullptr)
+        {
+            _heartbeat.emplace(*heartbeats);
+        }
+        else
+        {
+            auto const accessFile = makeFlowAccessFilePath(manager.getDomain(), to_string(flowId));
+            _accessFileFd = ::open(accessFile.string().c_str(), O_RDWR);
+
+            // Opening the access file may fail if the domain is in a read only volume.
+            // we can still execute properly but the 'lastReadTime' will never be updated.
+            // Ignore failures.
+        }
 
-        // Opening the access file may fail if the domain is in a read only volume.
-        // we can still execute properly but the 'lastReadTime' will never be updated.
-        // Ignore failures.
+        // If we can not announce that we are sleeping, writers may not wake us up until they noticed us in some other way.
+        waitStrategy().limitSleep(UNANNOUNCED_WAIT_INTERVAL, _flowData->unannouncedUntil());
     }
 
     PosixDiscreteFlowReader::~PosixDiscreteFlowReader()
@@ -74,7 +87,7 @@ namespace mxl::lib
 
     mxlFlowInfo PosixDiscreteFlowReader::getFlowInfo() const
     {
-        return *getFlowData().flowInfo();
+        return _flowData->flowInfoWithReaderHeartbeats();
     }
 
     mxlFlowConfigInfo PosixDiscreteFlowReader::getFlowConfigInfo() const
@@ -107,6 +120,20 @@ namespace mxl::lib
         return result;
     }
 
+    mxlStatus PosixDiscreteFlowReader::pollGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices) const
+    {
+        auto result = MXL_ERR_UNKNOWN;
+        if (_flowData)
+        {
+            result = getGrainImpl(in_index, in_minValidSlices, nullptr, nullptr);
+            if ((result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && !isFlowValidImpl())
+            {
+                result = MXL_ERR_FLOW_INVALID;
+            }
+        }
+        return result;
+    }
+
     mxlStatus PosixDiscreteFlowReader::getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline,
         mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload)
     {
@@ -116,8 +143,7 @@ namespace mxl::lib
             result = getGrainImpl(in_index, in_minValidSlices, in_deadline, out_grainInfo, out_payload);
             if (result == MXL_STATUS_OK)
             {
-                // We ignore the return value of updateFileAccessTime. It may fail if the domain is in a read-only volume.
-                (void)updateFileAccessTime(_accessFileFd);
+                notifyRead();
             }
             else if (result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
             {
@@ -142,8 +168,7 @@ namespace mxl::lib
             result = getGrainImpl(in_index, in_minValidSlices, out_grainInfo, out_payload);
             if (result == MXL_STATUS_OK)
             {
-                // We ignore the return value of updateFileAccessTime. It may fail if the domain is in a read-only volume.
-                (void)updateFileAccessTime(_accessFileFd);
+                notifyRead();
             }
             else if (result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
             {
@@ -159,6 +184,69 @@ namespace mxl::lib
         return result;
     }
 
+    mxlStatus PosixDiscreteFlowReader::getGrainRange(std::uint64_t in_firstIndex, std::size_t in_count, Timepoint in_deadline,
+        mxlGrainInfo* out_grainInfos, std::uint8_t** out_payloads, std::size_t* out_availableCount)
+    {
+        *out_availableCount = 0U;
+
+        auto result = MXL_ERR_UNKNOWN;
+        if (_flowData)
+        {
+            result = getGrainImpl(in_firstIndex, MXL_GRAIN_VALID_SLICES_ALL, in_deadline, out_grainInfos, out_payloads);
+            if (result == MXL_STATUS_OK)
+            {
+                // The remaining grains are collected without waiting. We stop at the first one that isn't complete yet, so that
+                // callers always receive a gapless sequence.
+                auto available = std::size_t{1};
+                while ((available < in_count) &&
+                       (getGrainImpl(in_firstIndex + available, MXL_GRAIN_VALID_SLICES_ALL, &out_grainInfos[available], &out_payloads[available]) ==
+                           MXL_STATUS_OK))
+                {
+                    ++available;
+                }
+
+                *out_availableCount = available;
+                notifyRead();
+            }
+            else if ((result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && !isFlowValidImpl())
+            {
+                result = MXL_ERR_FLOW_INVALID;
+            }
+        }
+        return result;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getGrainInfoLite(std::uint64_t in_index, mxlGrainInfoLite* out_grainInfo) const
+    {
+        auto result = MXL_ERR_UNKNOWN;
+        if (_flowData)
+        {
+            // Partial grains are reported as they are, which is what callers that poll for progress on a grain want.
+            // Only the meaningful prefix of the snapshot is ever initialized.
+            mxlGrainInfo info;
+            result = getGrainImpl(in_index, 0U, &info, nullptr);
+            if (result == MXL_STATUS_OK)
+            {
+                *out_grainInfo = mxlGrainInfoLite{};
+                out_grainInfo->index = info.index;
+                out_grainInfo->flags = info.flags;
+                out_grainInfo->grainSize = info.grainSize;
+                out_grainInfo->totalSlices = info.totalSlices;
+                out_grainInfo->validSlices = info.validSlices;
+            }
+            else if ((result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && !isFlowValidImpl())
+            {
+                result = MXL_ERR_FLOW_INVALID;
+            }
+        }
+        return result;
+    }
+
+    bool PosixDiscreteFlowReader::isHugePageBacked() const
+    {
+        return _flowData && _flowData->isHugePageBacked();
+    }
+
     mxlStatus PosixDiscreteFlowReader::getGrainImpl(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
         std::uint8_t** out_payload) const
     {
@@ -172,13 +260,21 @@ namespace mxl::lib
             {
                 auto const offset = in_index % grainCount;
                 auto const grain = _flowData->grainAt(offset);
+                if (grain == nullptr)
+                {
+                    // Only possible if the grain is mapped lazily and its file is gone, which means that the flow is as well.
+                    return MXL_ERR_FLOW_INVALID;
+                }
 
-                if ((grain->header.info.validSlices >= std::min(in_minValidSlices, grain->header.info.totalSlices)) ||
-                    ((grain->header.info.flags & MXL_GRAIN_FLAG_INVALID) != 0))
+                // Only the meaningful prefix of the snapshot is ever initialized.
+                mxlGrainInfo info;
+                loadGrainInfo(grain->header, info);
+
+                if ((info.validSlices >= std::min(in_minValidSlices, info.totalSlices)) || ((info.flags & MXL_GRAIN_FLAG_INVALID) != 0))
                 {
                     if (out_grainInfo != nullptr)
                     {
-                        *out_grainInfo = grain->header.info;
+                        std::memcpy(out_grainInfo, &info, MXL_GRAIN_INFO_PREFIX_SIZE);
                     }
                     if (out_payload != nullptr)
                     {
@@ -207,25 +303,81 @@ namespace mxl::lib
 
     mxlStatus PosixDiscreteFlowReader::getGrainImpl(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline,
         mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const
+    {
+        // Most of the time the grain is available already. Registering a waiter costs atomic operations on cache lines shared with
+        // the writer, so we only do that once it is clear that we have to wait. The grain is checked again after registering.
+        if (auto const result = getGrainImpl(in_index, in_minValidSlices, out_grainInfo, out_payload);
+            (result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || isFlowRetired(_flowData->flow()->state))
+        {
+            return result;
+        }
+
+        // Tell the writer what we are waiting for, so that it only wakes us up once we can make progress, instead of on every
+        // single slice it commits. Registration is only possible if the flow provides a waiters segment that we are allowed to
+        // write to, and there is a free slot left in it.
+        if (auto const waiters = _flowData->flowWaiters(); waiters != nullptr)
+        {
+            if (auto const waiter = GrainWaiter{*waiters, in_index, in_minValidSlices}; waiter.isRegistered())
+            {
+                return getGrainImpl(waiter.wakeCounter(), nullptr, in_index, in_minValidSlices, in_deadline, out_grainInfo, out_payload);
+            }
+
+            // Writers only wake readers sleeping on the sync counter if they announced themselves.
+            return getGrainImpl(
+                &_flowData->flow()->state.syncCounter, &waiters->syncWaiters, in_index, in_minValidSlices, in_deadline, out_grainInfo, out_payload);
+        }
+
+        return getGrainImpl(&_flowData->flow()->state.syncCounter, nullptr, in_index, in_minValidSlices, in_deadline, out_grainInfo, out_payload);
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getGrainImpl(std::uint32_t const* in_counter, std::uint32_t* in_sleepers, std::uint64_t in_index,
+        std::uint16_t in_minValidSlices, Timepoint in_deadline, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const
     {
         auto const flow = _flowData->flow();
-        auto const syncObject = std::atomic_ref{flow->state.syncCounter};
+        // NOTE: atomic_ref<T const> is only available from C++26 on.
+        auto const counter = std::atomic_ref{*const_cast<std::uint32_t*>(in_counter)};
+        auto woken = false;
         while (true)
         {
-            // We remember the sync counter before checking the head index, otherwise we would introduce a race condition:
+            // We remember the counter before checking the head index, otherwise we would introduce a race condition:
             // 1. We check the header index, data won't be available yet.
             // 2. Writer writes the data and updates the counter.
             // 3. If we used the current value of the counter for the futex, we would delay everything by 1 grain.
-            auto const previousSyncCounter = syncObject.load(std::memory_order_acquire);
+            auto const previousCounter = counter.load(std::memory_order_acquire);
             auto const result = getGrainImpl(in_index, in_minValidSlices, out_grainInfo, out_payload);
-            // NOTE: Before C++26 there is no way to access the address of the object wrapped
-            //      by an atomic_ref. If there were it would be much more appropriate to pass
-            //      syncObject by reference here and only unwrap the underlying integer in the
-            //      implementation of waitUntilChanged.
-            if ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || !waitUntilChanged(&flow->state.syncCounter, previousSyncCounter, in_deadline))
+            // There is no point in waiting for new data if the flow has been retired in the meantime.
+            if ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || isFlowRetired(flow->state))
+            {
+                return result;
+            }
+            if (woken)
+            {
+                waitStrategy().recordWastedWakeup();
+            }
+
+            if (!waitStrategy().waitUntilChanged(in_counter,
+                    previousCounter,
+                    in_deadline,
+                    &flow->info.runtime.lastWriteTime,
+                    in_sleepers,
+                    &flow->info.runtime.nextCommitTime))
             {
                 return result;
             }
+            woken = true;
+        }
+    }
+
+    void PosixDiscreteFlowReader::notifyRead() noexcept
+    {
+        if (_heartbeat)
+        {
+            _heartbeat->beat();
+        }
+        else
+        {
+            // We ignore the return value of updateFileAccessTime. It may fail if the domain is in a read-only volume.
+            (void)updateFileAccessTime(_accessFileFd);
         }
     }
 
@@ -236,14 +388,6 @@ namespace mxl::lib
 
     bool PosixDiscreteFlowReader::isFlowValidImpl() const
     {
-        auto const flowState = _flowData->flowState();
-        auto const flowDataPath = makeFlowDataFilePath(getDomain(), to_string(getId()));
-
-        struct stat st;
-        if (::stat(flowDataPath.string().c_str(), &st) != 0)
-        {
-            return false;
-        }
-        return (st.st_ino == flowState->inode);
+        return isFlowStateValid(*_flowData->flowState());
     }
 }
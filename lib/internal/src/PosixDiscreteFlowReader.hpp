@@ -5,11 +5,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <uuid.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include "mxl-internal/DiscreteFlowData.hpp"
 #include "mxl-internal/DiscreteFlowReader.hpp"
+#include "mxl-internal/ReaderHeartbeats.hpp"
 
 namespace mxl::lib
 {
@@ -28,7 +30,7 @@ namespace mxl::lib
         PosixDiscreteFlowReader(FlowManager const& manager, uuids::uuid const& flowId, std::unique_ptr<DiscreteFlowData>&& data);
 
         /**
-         * Close the access file fd.
+         * Release the heartbeat slot or close the access file fd.
          */
         virtual ~PosixDiscreteFlowReader();
 
@@ -52,6 +54,9 @@ namespace mxl::lib
         /** \see DiscreteFlowReader::waitForGrain */
         virtual mxlStatus waitForGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline) const override;
 
+        /** \see DiscreteFlowReader::pollGrain */
+        virtual mxlStatus pollGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices) const override;
+
         /** \see DiscreteFlowReader::getGrain */
         virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) override;
@@ -60,6 +65,17 @@ namespace mxl::lib
         virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) override;
 
+        /** \see DiscreteFlowReader::getGrainRange */
+        virtual mxlStatus getGrainRange(std::uint64_t in_firstIndex, std::size_t in_count, Timepoint in_deadline, mxlGrainInfo* out_grainInfos,
+            std::uint8_t** out_payloads, std::size_t* out_availableCount) override;
+
+        /** \see DiscreteFlowReader::getGrainInfoLite */
+        virtual mxlStatus getGrainInfoLite(std::uint64_t in_index, mxlGrainInfoLite* out_grainInfo) const override;
+
+        /** \see DiscreteFlowReader::isHugePageBacked */
+        [[nodiscard]]
+        virtual bool isHugePageBacked() const override;
+
     protected:
         /** \see FlowReader::isFlowValid */
         [[nodiscard]]
@@ -91,8 +107,27 @@ namespace mxl::lib
         mxlStatus getGrainImpl(std::uint64_t in_index, std::uint16_t in_minValidSlices, Timepoint in_deadline, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) const;
 
+        /**
+         * Wait for the specified grain by sleeping on the specified futex
+         * word, which is either our slot in the waiters segment of the flow,
+         * or the sync counter of the flow. In the latter case in_sleepers
+         * optionally refers to the counter in which we announce ourselves
+         * while sleeping.
+         */
+        mxlStatus getGrainImpl(std::uint32_t const* in_counter, std::uint32_t* in_sleepers, std::uint64_t in_index, std::uint16_t in_minValidSlices,
+            Timepoint in_deadline, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const;
+
+        /**
+         * Let the writer know that we just read from the flow, either through
+         * our heartbeat slot, or by touching the access file of the flow if
+         * the flow does not provide reader heartbeats.
+         */
+        void notifyRead() noexcept;
+
     private:
         std::unique_ptr<DiscreteFlowData> _flowData;
+        /** Our heartbeat slot, if the flow provides reader heartbeats. */
+        std::optional<ReaderHeartbeat> _heartbeat;
         int _accessFileFd;
     };
 
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PosixDiscreteFlowWriter.hpp"
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <fcntl.h>
 #include <uuid.h>
@@ -12,6 +14,8 @@
 #include <mxl/time.h>
 #include "mxl-internal/Flow.hpp"
 #include "mxl-internal/FlowManager.hpp"
+#include "mxl-internal/FlowWaiters.hpp"
+#include "mxl-internal/ReaderHeartbeats.hpp"
 #include "mxl-internal/Sync.hpp"
 #include "mxl-internal/Timing.hpp"
 
@@ -22,6 +26,7 @@ namespace mxl::lib
         : DiscreteFlowWriter{flowId, manager.getDomain()}
         , _flowData{std::move(data)}
         , _currentIndex{MXL_UNDEFINED_INDEX}
+        , _lastHeartbeatAggregation{}
         , _watcher(watcher)
     {
         _watcher->addFlow(this, flowId);
@@ -59,7 +64,7 @@ namespace mxl::lib
 
     mxlFlowInfo PosixDiscreteFlowWriter::getFlowInfo() const
     {
-        return *getFlowData().flowInfo();
+        return _flowData->flowInfoWithReaderHeartbeats();
     }
 
     mxlFlowConfigInfo PosixDiscreteFlowWriter::getFlowConfigInfo() const
@@ -76,7 +81,11 @@ namespace mxl::lib
     {
         auto& flowData = static_cast<DiscreteFlowData const&>(getFlowData());
         auto const offset = in_index % flowData.flowInfo()->config.discrete.grainCount;
-        return flowData.grainAt(offset)->header.info;
+
+        // Another writer of the flow may be committing this grain right now.
+        auto result = mxlGrainInfo{};
+        loadGrainInfo(flowData.grainAt(offset)->header, result);
+        return result;
     }
 
     mxlStatus PosixDiscreteFlowWriter::openGrain(std::uint64_t in_index, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload)
@@ -85,8 +94,9 @@ namespace mxl::lib
         {
             auto offset = in_index % _flowData->flowInfo()->config.discrete.grainCount;
             auto const grain = _flowData->grainAt(offset);
-            grain->header.info.index = in_index; // Set the absolute grain index associated to that ring buffer entry
-            *out_grainInfo = grain->header.info;
+            loadGrainInfo(grain->header, *out_grainInfo);
+            out_grainInfo->index = in_index; // Set the absolute grain index associated to that ring buffer entry
+            storeGrainInfo(grain->header, *out_grainInfo);
             *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
             _currentIndex = in_index;
             return MXL_STATUS_OK;
@@ -133,8 +143,22 @@ namespace mxl::lib
             flow->info.runtime.headIndex = _currentIndex;
 
             auto const offset = _currentIndex % flow->info.config.discrete.grainCount;
-            *_flowData->grainInfoAt(offset) = mxlGrainInfo;
-            flow->info.runtime.lastWriteTime = currentTime(mxl::lib::Clock::TAI).value;
+            storeGrainInfo(_flowData->grainAt(offset)->header, mxlGrainInfo);
+            auto const now = currentTime(mxl::lib::Clock::TAI);
+            flow->info.runtime.lastWriteTime = now.value;
+            publishCommitCadence(flow->info.runtime, now);
+
+            // Fold the heartbeats of our readers into the last read time every once in a while. Readers only store their
+            // heartbeats at this rate anyway, so doing it on every commit would not yield more accurate results.
+            if (auto const heartbeats = _flowData->readerHeartbeats();
+                (heartbeats != nullptr) && ((now - _lastHeartbeatAggregation) >= READER_HEARTBEAT_INTERVAL))
+            {
+                _lastHeartbeatAggregation = now;
+                if (auto const lastReadTime = aggregateReaderHeartbeats(*heartbeats); lastReadTime > flow->info.runtime.lastReadTime)
+                {
+                    flow->info.runtime.lastReadTime = lastReadTime;
+                }
+            }
 
             // If the grain is complete, reset the current index of the flow writer.
             if (mxlGrainInfo.validSlices == mxlGrainInfo.totalSlices)
@@ -143,8 +167,15 @@ namespace mxl::lib
             }
 
             // Let readers know that the head has moved or that new data is available in a partial grain
-            flow->state.syncCounter++;
-            wakeAll(&flow->state.syncCounter);
+            // This is skipped if none of them announced that it is sleeping, which saves a system call per commit.
+            std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
+            (void)wakeSyncWaiters(flow->state, _flowData->announcedFlowWaiters(now));
+
+            // Readers that registered what they are waiting for are only woken up once they can actually make progress.
+            if (auto const waiters = _flowData->flowWaiters(); waiters != nullptr)
+            {
+                wakeGrainWaiters(*waiters, mxlGrainInfo.index, mxlGrainInfo);
+            }
 
             return MXL_STATUS_OK;
         }
@@ -10,6 +10,7 @@
 #include "mxl-internal/DiscreteFlowData.hpp"
 #include "mxl-internal/DiscreteFlowWriter.hpp"
 #include "mxl-internal/DomainWatcher.hpp"
+#include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
@@ -77,6 +78,8 @@ namespace mxl::lib
         std::unique_ptr<DiscreteFlowData> _flowData;
         /** The currently opened grain index. MXL_UNDEFINED_INDEX if no grain is currently opened. */
         std::uint64_t _currentIndex;
+        /** The last time the heartbeats of our readers were aggregated into the last read time of the flow. */
+        Timepoint _lastHeartbeatAggregation;
 
         // The watcher reference needs live in the most derived class of `FlowWriter` because it only synchronizes with the `DomainWatcher` thread
         // while the destructor runs. If it was inside the `FlowWriter` destructor itself, the domain watcher thread could call `flowRead()` of a
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/ReaderHeartbeats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <unistd.h>
+
+namespace mxl::lib
+{
+    namespace
+    {
+        std::uint64_t makeOwnerToken() noexcept
+        {
+            static auto counter = std::atomic<std::uint32_t>{0U};
+            return (static_cast<std::uint64_t>(::getpid()) << 32U) | (counter.fetch_add(1U, std::memory_order_relaxed) + 1U);
+        }
+    }
+
+    ReaderHeartbeat::ReaderHeartbeat(ReaderHeartbeats& heartbeats) noexcept
+        : _slot{nullptr}
+        , _owner{makeOwnerToken()}
+        , _lastBeat{}
+    {
+        for (auto i = std::size_t{0}; i < READER_HEARTBEAT_SLOT_COUNT; ++i)
+        {
+            auto expected = std::uint64_t{0};
+            if (std::atomic_ref{heartbeats.slots[i].owner}.compare_exchange_strong(expected, _owner, std::memory_order_relaxed))
+            {
+                _slot = &heartbeats.slots[i];
+
+                auto const slotsInUse = std::atomic_ref{heartbeats.slotsInUse};
+                auto current = slotsInUse.load(std::memory_order_relaxed);
+                while ((current <= i) && !slotsInUse.compare_exchange_weak(current, static_cast<std::uint32_t>(i + 1U), std::memory_order_relaxed))
+                {}
+                return;
+            }
+        }
+
+        // All slots are taken, possibly by readers that crashed without releasing theirs. Share one with another reader, which is
+        // harmless, because only the most recent heartbeat of all readers is of interest.
+        _slot = &heartbeats.slots[_owner % READER_HEARTBEAT_SLOT_COUNT];
+        _owner = 0U;
+    }
+
+    ReaderHeartbeat::~ReaderHeartbeat()
+    {
+        if (_owner != 0U)
+        {
+            // Leave the last read time in place, so that it is still accounted for by the writer.
+            auto expected = _owner;
+            std::atomic_ref{_slot->owner}.compare_exchange_strong(expected, 0U, std::memory_order_relaxed);
+        }
+    }
+
+    void ReaderHeartbeat::beat() noexcept
+    {
+        if (auto const now = currentTime(Clock::TAI); (now - _lastBeat) >= READER_HEARTBEAT_INTERVAL)
+        {
+            _lastBeat = now;
+            std::atomic_ref{_slot->lastReadTime}.store(static_cast<std::uint64_t>(now.value), std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t aggregateReaderHeartbeats(ReaderHeartbeats const& heartbeats) noexcept
+    {
+        // Only slots that were claimed at some point can hold a heartbeat.
+        auto const slotsInUse = std::min<std::size_t>(
+            std::atomic_ref{const_cast<std::uint32_t&>(heartbeats.slotsInUse)}.load(std::memory_order_relaxed), READER_HEARTBEAT_SLOT_COUNT);
+
+        auto result = std::uint64_t{0};
+        for (auto i = std::size_t{0}; i < slotsInUse; ++i)
+        {
+            auto const lastReadTime = std::atomic_ref{const_cast<std::uint64_t&>(heartbeats.slots[i].lastReadTime)}.load(std::memory_order_relaxed);
+            result = std::max(result, lastReadTime);
+        }
+        return result;
+    }
+}
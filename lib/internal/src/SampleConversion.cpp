@@ -0,0 +1,664 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/SampleConversion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <mxl/platform.h>
+
+#if defined(__SSE2__)
+#   include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /**
+         * Largest number of samples that are interleaved into an intermediate
+         * block before converting them to or from an integer format, small enough
+         * for the block to stay in the L1 cache.
+         */
+        constexpr auto CONVERSION_BLOCK_SAMPLES = std::size_t{2048};
+
+        /** Copy a single word, with the size known at compile time wherever possible. */
+        template<std::size_t WordSize>
+        inline void copyWord(std::byte const* src, std::byte* dst, std::size_t) noexcept
+        {
+            std::memcpy(dst, src, WordSize);
+        }
+
+        template<>
+        inline void copyWord<0U>(std::byte const* src, std::byte* dst, std::size_t wordSize) noexcept
+        {
+            std::memcpy(dst, src, wordSize);
+        }
+
+        /** Transpose the rows [0, rows) starting at column `col`, one word at a time. */
+        template<std::size_t WordSize>
+        void transposeScalar(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t rows, std::size_t col,
+            std::size_t cols, std::size_t wordSize) noexcept
+        {
+            for (auto i = std::size_t{0}; i < rows; ++i)
+            {
+                auto const srcRow = src + i * srcStride;
+                auto const dstCol = dst + i * wordSize;
+                for (auto j = col; j < cols; ++j)
+                {
+                    copyWord<WordSize>(srcRow + j * wordSize, dstCol + j * dstStride, wordSize);
+                }
+            }
+        }
+
+#if defined(__AVX2__)
+        inline void transpose8x8(__m256 (&r)[8]) noexcept
+        {
+            auto const t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            auto const t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            auto const t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            auto const t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            auto const t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            auto const t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            auto const t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            auto const t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+            auto const u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            auto const u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            auto const u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            auto const u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            auto const u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            auto const u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            auto const u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            auto const u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            r[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+            r[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+            r[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+            r[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+            r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+            r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+            r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+            r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+        }
+
+        /** Transpose 8 rows of 32 bit words in tiles of 8x8 words. Returns the first column that was not transposed. */
+        std::size_t transposeRows8(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t cols) noexcept
+        {
+            __m256 r[8];
+            auto j = std::size_t{0};
+            for (; (j + 8U) <= cols; j += 8U)
+            {
+                for (auto k = 0U; k < 8U; ++k)
+                {
+                    r[k] = _mm256_loadu_ps(reinterpret_cast<float const*>(src + k * srcStride + j * 4U));
+                }
+                transpose8x8(r);
+                for (auto k = 0U; k < 8U; ++k)
+                {
+                    _mm256_storeu_ps(reinterpret_cast<float*>(dst + (j + k) * dstStride), r[k]);
+                }
+            }
+#   if defined(__AVX512F__) && defined(__AVX512VL__)
+            // Masked loads take care of the remaining columns, so that short reads don't fall back to the scalar path.
+            if (j < cols)
+            {
+                auto const remaining = cols - j;
+                auto const mask = static_cast<__mmask8>((1U << remaining) - 1U);
+                for (auto k = 0U; k < 8U; ++k)
+                {
+                    r[k] = _mm256_maskz_loadu_ps(mask, reinterpret_cast<float const*>(src + k * srcStride + j * 4U));
+                }
+                transpose8x8(r);
+                for (auto k = std::size_t{0}; k < remaining; ++k)
+                {
+                    _mm256_storeu_ps(reinterpret_cast<float*>(dst + (j + k) * dstStride), r[k]);
+                }
+                j = cols;
+            }
+#   endif
+            return j;
+        }
+#endif
+
+#if defined(__SSE2__)
+        /** Transpose 4 rows of 32 bit words in tiles of 4x4 words. Returns the first column that was not transposed. */
+        std::size_t transposeRows4(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t cols) noexcept
+        {
+            auto j = std::size_t{0};
+            for (; (j + 4U) <= cols; j += 4U)
+            {
+                auto r0 = _mm_loadu_ps(reinterpret_cast<float const*>(src + j * 4U));
+                auto r1 = _mm_loadu_ps(reinterpret_cast<float const*>(src + srcStride + j * 4U));
+                auto r2 = _mm_loadu_ps(reinterpret_cast<float const*>(src + 2U * srcStride + j * 4U));
+                auto r3 = _mm_loadu_ps(reinterpret_cast<float const*>(src + 3U * srcStride + j * 4U));
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + j * dstStride), r0);
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + (j + 1U) * dstStride), r1);
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + (j + 2U) * dstStride), r2);
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + (j + 3U) * dstStride), r3);
+            }
+            return j;
+        }
+
+        /** Interleave 2 rows of 32 bit words, 4 columns at a time. Returns the first column that was not transposed. */
+        std::size_t transposeRows2(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t cols) noexcept
+        {
+            auto j = std::size_t{0};
+            for (; (j + 4U) <= cols; j += 4U)
+            {
+                auto const a = _mm_loadu_ps(reinterpret_cast<float const*>(src + j * 4U));
+                auto const b = _mm_loadu_ps(reinterpret_cast<float const*>(src + srcStride + j * 4U));
+                auto const lo = _mm_unpacklo_ps(a, b);
+                auto const hi = _mm_unpackhi_ps(a, b);
+                _mm_storel_pi(reinterpret_cast<__m64*>(dst + j * dstStride), lo);
+                _mm_storeh_pi(reinterpret_cast<__m64*>(dst + (j + 1U) * dstStride), lo);
+                _mm_storel_pi(reinterpret_cast<__m64*>(dst + (j + 2U) * dstStride), hi);
+                _mm_storeh_pi(reinterpret_cast<__m64*>(dst + (j + 3U) * dstStride), hi);
+            }
+            return j;
+        }
+
+        /** Deinterleave rows of 2 words each into 2 rows, 4 rows at a time. Returns the first row that was not transposed. */
+        std::size_t transposeCols2(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t rows) noexcept
+        {
+            auto i = std::size_t{0};
+            for (; (i + 4U) <= rows; i += 4U)
+            {
+                auto lo = _mm_setzero_ps();
+                auto hi = _mm_setzero_ps();
+                lo = _mm_loadl_pi(lo, reinterpret_cast<__m64 const*>(src + i * srcStride));
+                lo = _mm_loadh_pi(lo, reinterpret_cast<__m64 const*>(src + (i + 1U) * srcStride));
+                hi = _mm_loadl_pi(hi, reinterpret_cast<__m64 const*>(src + (i + 2U) * srcStride));
+                hi = _mm_loadh_pi(hi, reinterpret_cast<__m64 const*>(src + (i + 3U) * srcStride));
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + i * 4U), _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(reinterpret_cast<float*>(dst + dstStride + i * 4U), _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+            return i;
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        /** Transpose 4 rows of 32 bit words in tiles of 4x4 words. Returns the first column that was not transposed. */
+        std::size_t transposeRows4(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t cols) noexcept
+        {
+            auto j = std::size_t{0};
+            for (; (j + 4U) <= cols; j += 4U)
+            {
+                auto const r0 = vld1q_f32(reinterpret_cast<float const*>(src + j * 4U));
+                auto const r1 = vld1q_f32(reinterpret_cast<float const*>(src + srcStride + j * 4U));
+                auto const r2 = vld1q_f32(reinterpret_cast<float const*>(src + 2U * srcStride + j * 4U));
+                auto const r3 = vld1q_f32(reinterpret_cast<float const*>(src + 3U * srcStride + j * 4U));
+                auto const p01 = vtrnq_f32(r0, r1);
+                auto const p23 = vtrnq_f32(r2, r3);
+                vst1q_f32(reinterpret_cast<float*>(dst + j * dstStride), vcombine_f32(vget_low_f32(p01.val[0]), vget_low_f32(p23.val[0])));
+                vst1q_f32(reinterpret_cast<float*>(dst + (j + 1U) * dstStride), vcombine_f32(vget_low_f32(p01.val[1]), vget_low_f32(p23.val[1])));
+                vst1q_f32(reinterpret_cast<float*>(dst + (j + 2U) * dstStride), vcombine_f32(vget_high_f32(p01.val[0]), vget_high_f32(p23.val[0])));
+                vst1q_f32(reinterpret_cast<float*>(dst + (j + 3U) * dstStride), vcombine_f32(vget_high_f32(p01.val[1]), vget_high_f32(p23.val[1])));
+            }
+            return j;
+        }
+
+        /** Interleave 2 rows of 32 bit words, 4 columns at a time. Returns the first column that was not transposed. */
+        std::size_t transposeRows2(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t cols) noexcept
+        {
+            auto j = std::size_t{0};
+            for (; (j + 4U) <= cols; j += 4U)
+            {
+                auto const a = vld1q_f32(reinterpret_cast<float const*>(src + j * 4U));
+                auto const b = vld1q_f32(reinterpret_cast<float const*>(src + srcStride + j * 4U));
+                auto const lo = vzip1q_f32(a, b);
+                auto const hi = vzip2q_f32(a, b);
+                vst1_f32(reinterpret_cast<float*>(dst + j * dstStride), vget_low_f32(lo));
+                vst1_f32(reinterpret_cast<float*>(dst + (j + 1U) * dstStride), vget_high_f32(lo));
+                vst1_f32(reinterpret_cast<float*>(dst + (j + 2U) * dstStride), vget_low_f32(hi));
+                vst1_f32(reinterpret_cast<float*>(dst + (j + 3U) * dstStride), vget_high_f32(hi));
+            }
+            return j;
+        }
+
+        /** Deinterleave rows of 2 words each into 2 rows, 4 rows at a time. Returns the first row that was not transposed. */
+        std::size_t transposeCols2(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t rows) noexcept
+        {
+            auto i = std::size_t{0};
+            for (; (i + 4U) <= rows; i += 4U)
+            {
+                auto const lo = vcombine_f32(vld1_f32(reinterpret_cast<float const*>(src + i * srcStride)),
+                    vld1_f32(reinterpret_cast<float const*>(src + (i + 1U) * srcStride)));
+                auto const hi = vcombine_f32(vld1_f32(reinterpret_cast<float const*>(src + (i + 2U) * srcStride)),
+                    vld1_f32(reinterpret_cast<float const*>(src + (i + 3U) * srcStride)));
+                vst1q_f32(reinterpret_cast<float*>(dst + i * 4U), vuzp1q_f32(lo, hi));
+                vst1q_f32(reinterpret_cast<float*>(dst + dstStride + i * 4U), vuzp2q_f32(lo, hi));
+            }
+            return i;
+        }
+#endif
+
+        void transposeWords32(std::byte const* src, std::size_t srcStride, std::byte* dst, std::size_t dstStride, std::size_t rows,
+            std::size_t cols) noexcept
+        {
+            auto i = std::size_t{0};
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+            if ((cols == 2U) && (rows > 2U))
+            {
+                // Deinterleaving a stereo pair, which would otherwise never fill a whole tile.
+                auto const done = transposeCols2(src, srcStride, dst, dstStride, rows);
+                transposeScalar<4U>(src + done * srcStride, srcStride, dst + done * 4U, dstStride, rows - done, 0U, cols, 4U);
+                return;
+            }
+#endif
+#if defined(__AVX2__)
+            for (; (i + 8U) <= rows; i += 8U)
+            {
+                auto const done = transposeRows8(src + i * srcStride, srcStride, dst + i * 4U, dstStride, cols);
+                transposeScalar<4U>(src + i * srcStride, srcStride, dst + i * 4U, dstStride, 8U, done, cols, 4U);
+            }
+#endif
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+            for (; (i + 4U) <= rows; i += 4U)
+            {
+                auto const done = transposeRows4(src + i * srcStride, srcStride, dst + i * 4U, dstStride, cols);
+                transposeScalar<4U>(src + i * srcStride, srcStride, dst + i * 4U, dstStride, 4U, done, cols, 4U);
+            }
+            for (; (i + 2U) <= rows; i += 2U)
+            {
+                auto const done = transposeRows2(src + i * srcStride, srcStride, dst + i * 4U, dstStride, cols);
+                transposeScalar<4U>(src + i * srcStride, srcStride, dst + i * 4U, dstStride, 2U, done, cols, 4U);
+            }
+#endif
+            transposeScalar<4U>(src + i * srcStride, srcStride, dst + i * 4U, dstStride, rows - i, 0U, cols, 4U);
+        }
+
+        /** Number of samples converted at once, sized to keep the intermediate arrays in registers or the L1 cache. */
+        constexpr auto QUANTIZE_CHUNK_SAMPLES = std::size_t{64};
+
+        /**
+         * Triangular (TPDF) dither noise in the range (-1, 1), generated by
+         * subtracting two uniformly distributed values drawn from xorshift
+         * generators. Runs several independent generators side by side, so that
+         * the compiler can vectorize them across lanes.
+         */
+        class TpdfDither
+        {
+        public:
+            explicit TpdfDither(std::uint64_t seed) noexcept
+            {
+                for (auto lane = std::size_t{0}; lane < LANES; ++lane)
+                {
+                    // Spread the seed across the lanes with a multiplicative hash, xorshift must not start from zero.
+                    auto const mixed = (seed + lane) * 0x9e37'79b9'7f4a'7c15ULL;
+                    _state[lane] = static_cast<std::uint32_t>(mixed >> 32U) | 1U;
+                }
+            }
+
+            void fill(float (&out)[QUANTIZE_CHUNK_SAMPLES]) noexcept
+            {
+                std::uint32_t state[LANES];
+                std::memcpy(state, _state, sizeof(state));
+                for (auto i = std::size_t{0}; i < QUANTIZE_CHUNK_SAMPLES; i += LANES)
+                {
+                    for (auto lane = std::size_t{0}; lane < LANES; ++lane)
+                    {
+                        auto const a = nextUniform(state[lane]);
+                        out[i + lane] = a - nextUniform(state[lane]);
+                    }
+                }
+                std::memcpy(_state, state, sizeof(state));
+            }
+
+        private:
+            constexpr static auto LANES = std::size_t{8};
+
+            static float nextUniform(std::uint32_t& state) noexcept
+            {
+                state ^= state << 13U;
+                state ^= state >> 17U;
+                state ^= state << 5U;
+                // The top 24 bits fit into a float exactly, and into a signed integer, which converts faster.
+                return static_cast<float>(static_cast<std::int32_t>(state >> 8U)) * (1.0f / 16777216.0f);
+            }
+
+            std::uint32_t _state[LANES];
+        };
+
+        /**
+         * Scale, round and clip native samples to signed integers of the specified
+         * width, written as branch free loops that the compiler can vectorize.
+         */
+        template<unsigned Bits, typename Sample>
+        void quantize(Sample const* in, float const* dither, std::size_t count, std::int32_t* out) noexcept
+        {
+            // Work in double precision for 32 bit integers, whose range exceeds the precision of a float.
+            using Scaled = std::conditional_t<(Bits > 24U), double, Sample>;
+            constexpr auto fullScale = static_cast<Scaled>(std::uint32_t{1} << (Bits - 1U));
+            constexpr auto minValue = -fullScale;
+            constexpr auto maxValue = fullScale - 1;
+
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                auto value = static_cast<Scaled>(in[i]) * fullScale + static_cast<Scaled>(dither[i]);
+                // NaN is turned into silence instead of invoking undefined behaviour in the conversion.
+                value = (value == value) ? value : Scaled{0};
+                value = (value > minValue) ? value : minValue;
+                value = (value < maxValue) ? value : maxValue;
+                out[i] = static_cast<std::int32_t>(std::rint(value));
+            }
+        }
+
+        template<typename Sample>
+        void convertFromNative(std::byte const* in, std::size_t count, mxlSampleFormat format, TpdfDither* dither, std::byte* out) noexcept
+        {
+            constexpr float silence[QUANTIZE_CHUNK_SAMPLES] = {};
+
+            auto const samples = reinterpret_cast<Sample const*>(in);
+            float noise[QUANTIZE_CHUNK_SAMPLES];
+            std::int32_t values[QUANTIZE_CHUNK_SAMPLES];
+            for (auto offset = std::size_t{0}; offset < count; offset += QUANTIZE_CHUNK_SAMPLES)
+            {
+                auto const n = std::min(QUANTIZE_CHUNK_SAMPLES, count - offset);
+                auto const useDither = (dither != nullptr) && (format != MXL_SAMPLE_FORMAT_S32);
+                if (useDither)
+                {
+                    dither->fill(noise);
+                }
+                auto const noisePtr = useDither ? noise : silence;
+
+                switch (format)
+                {
+                    case MXL_SAMPLE_FORMAT_S16:
+                    {
+                        quantize<16U>(samples + offset, noisePtr, n, values);
+                        std::int16_t narrowed[QUANTIZE_CHUNK_SAMPLES];
+                        for (auto i = std::size_t{0}; i < n; ++i)
+                        {
+                            narrowed[i] = static_cast<std::int16_t>(values[i]);
+                        }
+                        std::memcpy(out + offset * sizeof(std::int16_t), narrowed, n * sizeof(std::int16_t));
+                        break;
+                    }
+
+                    case MXL_SAMPLE_FORMAT_S24:
+                    {
+                        quantize<24U>(samples + offset, noisePtr, n, values);
+                        auto const dst = out + offset * 3U;
+                        for (auto i = std::size_t{0}; i < n; ++i)
+                        {
+                            auto const value = static_cast<std::uint32_t>(values[i]);
+                            dst[3U * i] = static_cast<std::byte>(value);
+                            dst[3U * i + 1U] = static_cast<std::byte>(value >> 8U);
+                            dst[3U * i + 2U] = static_cast<std::byte>(value >> 16U);
+                        }
+                        break;
+                    }
+
+                    case MXL_SAMPLE_FORMAT_S32:
+                        quantize<32U>(samples + offset, noisePtr, n, values);
+                        std::memcpy(out + offset * sizeof(std::int32_t), values, n * sizeof(std::int32_t));
+                        break;
+
+                    default: return;
+                }
+            }
+        }
+
+        template<typename Sample>
+        void convertToNative(std::byte const* in, std::size_t count, mxlSampleFormat format, std::byte* out) noexcept
+        {
+            auto const samples = reinterpret_cast<Sample*>(out);
+            switch (format)
+            {
+                case MXL_SAMPLE_FORMAT_S16:
+                    for (auto i = std::size_t{0}; i < count; ++i)
+                    {
+                        auto value = std::int16_t{};
+                        std::memcpy(&value, in + i * sizeof(value), sizeof(value));
+                        samples[i] = static_cast<Sample>(value) * Sample{1.0 / 32768.0};
+                    }
+                    break;
+
+                case MXL_SAMPLE_FORMAT_S24:
+                    for (auto i = std::size_t{0}; i < count; ++i)
+                    {
+                        // Place the 24 bits in the upper bytes and shift back down to sign extend them.
+                        auto const value = static_cast<std::int32_t>((std::to_integer<std::uint32_t>(in[3U * i]) << 8U) |
+                                                                     (std::to_integer<std::uint32_t>(in[3U * i + 1U]) << 16U) |
+                                                                     (std::to_integer<std::uint32_t>(in[3U * i + 2U]) << 24U)) >>
+                                           8;
+                        samples[i] = static_cast<Sample>(value) * Sample{1.0 / 8388608.0};
+                    }
+                    break;
+
+                case MXL_SAMPLE_FORMAT_S32:
+                    for (auto i = std::size_t{0}; i < count; ++i)
+                    {
+                        auto value = std::int32_t{};
+                        std::memcpy(&value, in + i * sizeof(value), sizeof(value));
+                        samples[i] = static_cast<Sample>(static_cast<double>(value) * (1.0 / 2147483648.0));
+                    }
+                    break;
+
+                default: break;
+            }
+        }
+
+        /**
+         * Split a conversion into tiles of whole frames that fit into an intermediate
+         * block, or into single frames split into runs of channels if even a single
+         * frame does not fit.
+         */
+        struct ConversionTiling
+        {
+            std::size_t channelsPerTile;
+            std::size_t framesPerTile;
+
+            explicit ConversionTiling(std::size_t channels) noexcept
+                : channelsPerTile{std::min(channels, CONVERSION_BLOCK_SAMPLES)}
+                , framesPerTile{std::max(CONVERSION_BLOCK_SAMPLES / std::max(channels, std::size_t{1}), std::size_t{1})}
+            {}
+        };
+
+        /**
+         * Copy a block of channels by frames words between two buffers, each of
+         * which separates its channels and frames by the specified strides in bytes.
+         * Planar and interleaved buffers are either transposed or copied frame by frame.
+         */
+        void copyStridedWords(std::byte const* src, std::size_t srcChannelStride, std::size_t srcFrameStride, std::byte* dst,
+            std::size_t dstChannelStride, std::size_t dstFrameStride, std::size_t channels, std::size_t frames, std::size_t wordSize) noexcept
+        {
+            if ((srcFrameStride == wordSize) && (dstChannelStride == wordSize))
+            {
+                transposeWords(src, srcChannelStride, dst, dstFrameStride, channels, frames, wordSize);
+            }
+            else if ((srcChannelStride == wordSize) && (dstFrameStride == wordSize))
+            {
+                transposeWords(src, srcFrameStride, dst, dstChannelStride, frames, channels, wordSize);
+            }
+            else if ((srcChannelStride == wordSize) && (dstChannelStride == wordSize))
+            {
+                auto const frameSize = channels * wordSize;
+                if ((srcFrameStride == frameSize) && (dstFrameStride == frameSize))
+                {
+                    std::memcpy(dst, src, frames * frameSize);
+                    return;
+                }
+                for (auto frame = std::size_t{0}; frame < frames; ++frame)
+                {
+                    std::memcpy(dst + frame * dstFrameStride, src + frame * srcFrameStride, frameSize);
+                }
+            }
+            else
+            {
+                for (auto frame = std::size_t{0}; frame < frames; ++frame)
+                {
+                    for (auto channel = std::size_t{0}; channel < channels; ++channel)
+                    {
+                        copyWord<0U>(src + channel * srcChannelStride + frame * srcFrameStride,
+                            dst + channel * dstChannelStride + frame * dstFrameStride,
+                            wordSize);
+                    }
+                }
+            }
+        }
+    }
+
+    MXL_EXPORT
+    std::size_t getSampleFormatSize(mxlSampleFormat format, std::size_t nativeWordSize) noexcept
+    {
+        auto const convertible = (nativeWordSize == sizeof(float)) || (nativeWordSize == sizeof(double));
+        switch (format)
+        {
+            case MXL_SAMPLE_FORMAT_NATIVE: return nativeWordSize;
+            case MXL_SAMPLE_FORMAT_S16:    return convertible ? 2U : 0U;
+            case MXL_SAMPLE_FORMAT_S24:    return convertible ? 3U : 0U;
+            case MXL_SAMPLE_FORMAT_S32:    return convertible ? 4U : 0U;
+            default:                       return 0U;
+        }
+    }
+
+    MXL_EXPORT
+    void transposeWords(void const* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t rows, std::size_t cols,
+        std::size_t wordSize) noexcept
+    {
+        auto const srcBytes = static_cast<std::byte const*>(src);
+        auto const dstBytes = static_cast<std::byte*>(dst);
+        if (((rows == 1U) && (dstStride == wordSize)) || ((cols == 1U) && (srcStride == wordSize)))
+        {
+            // A single channel is stored the same way, interleaved or not.
+            std::memcpy(dstBytes, srcBytes, rows * cols * wordSize);
+            return;
+        }
+
+        switch (wordSize)
+        {
+            case 4U: transposeWords32(srcBytes, srcStride, dstBytes, dstStride, rows, cols); break;
+            case 8U: transposeScalar<8U>(srcBytes, srcStride, dstBytes, dstStride, rows, 0U, cols, 8U); break;
+            default: transposeScalar<0U>(srcBytes, srcStride, dstBytes, dstStride, rows, 0U, cols, wordSize); break;
+        }
+    }
+
+    MXL_EXPORT
+    void interleaveSamples(mxlStridedWrappedMultiBufferSlice const& slices, std::size_t wordSize, mxlSampleFormat format, std::uint32_t flags,
+        std::uint64_t ditherSeed, void* out) noexcept
+    {
+        auto const channels = slices.count;
+        auto const frameSize = channels * getSampleFormatSize(format, wordSize);
+        auto dst = static_cast<std::byte*>(out);
+
+        auto dither = TpdfDither{ditherSeed};
+        auto const ditherPtr = ((flags & MXL_SAMPLE_CONVERSION_FLAG_DITHER) != 0U) ? &dither : nullptr;
+
+        for (auto const& fragment : slices.base.fragments)
+        {
+            auto const src = static_cast<std::byte const*>(fragment.pointer);
+            auto const frames = fragment.size / slices.elementStride;
+            if (format == MXL_SAMPLE_FORMAT_NATIVE)
+            {
+                copyStridedWords(src, slices.stride, slices.elementStride, dst, wordSize, frameSize, channels, frames, wordSize);
+                dst += frames * frameSize;
+                continue;
+            }
+
+            alignas(64) std::byte block[CONVERSION_BLOCK_SAMPLES * sizeof(double)];
+            auto const tiling = ConversionTiling{channels};
+            for (auto frame = std::size_t{0}; frame < frames; frame += tiling.framesPerTile)
+            {
+                auto const tileFrames = std::min(tiling.framesPerTile, frames - frame);
+                for (auto channel = std::size_t{0}; channel < channels; channel += tiling.channelsPerTile)
+                {
+                    auto const tileChannels = std::min(tiling.channelsPerTile, channels - channel);
+                    copyStridedWords(src + channel * slices.stride + frame * slices.elementStride,
+                        slices.stride,
+                        slices.elementStride,
+                        block,
+                        wordSize,
+                        tileChannels * wordSize,
+                        tileChannels,
+                        tileFrames,
+                        wordSize);
+
+                    // Tiles of whole frames are contiguous in the output and converted at once, runs of channels frame by frame.
+                    auto const sampleSize = frameSize / channels;
+                    auto const runs = (tileChannels == channels) ? std::size_t{1} : tileFrames;
+                    auto const runLength = (tileChannels == channels) ? tileFrames * channels : tileChannels;
+                    for (auto k = std::size_t{0}; k < runs; ++k)
+                    {
+                        auto const runSrc = block + k * tileChannels * wordSize;
+                        auto const runDst = dst + (frame + k) * frameSize + channel * sampleSize;
+                        if (wordSize == sizeof(float))
+                        {
+                            convertFromNative<float>(runSrc, runLength, format, ditherPtr, runDst);
+                        }
+                        else
+                        {
+                            convertFromNative<double>(runSrc, runLength, format, ditherPtr, runDst);
+                        }
+                    }
+                }
+            }
+            dst += frames * frameSize;
+        }
+    }
+
+    MXL_EXPORT
+    void deinterleaveSamples(void const* in, mxlSampleFormat format, std::size_t wordSize,
+        mxlMutableStridedWrappedMultiBufferSlice const& slices) noexcept
+    {
+        auto const channels = slices.count;
+        auto const frameSize = channels * getSampleFormatSize(format, wordSize);
+        auto src = static_cast<std::byte const*>(in);
+
+        for (auto const& fragment : slices.base.fragments)
+        {
+            auto const dst = static_cast<std::byte*>(fragment.pointer);
+            auto const frames = fragment.size / slices.elementStride;
+            if (format == MXL_SAMPLE_FORMAT_NATIVE)
+            {
+                copyStridedWords(src, wordSize, frameSize, dst, slices.stride, slices.elementStride, channels, frames, wordSize);
+                src += frames * frameSize;
+                continue;
+            }
+
+            alignas(64) std::byte block[CONVERSION_BLOCK_SAMPLES * sizeof(double)];
+            auto const tiling = ConversionTiling{channels};
+            for (auto frame = std::size_t{0}; frame < frames; frame += tiling.framesPerTile)
+            {
+                auto const tileFrames = std::min(tiling.framesPerTile, frames - frame);
+                for (auto channel = std::size_t{0}; channel < channels; channel += tiling.channelsPerTile)
+                {
+                    auto const tileChannels = std::min(tiling.channelsPerTile, channels - channel);
+
+                    auto const sampleSize = frameSize / channels;
+                    auto const runs = (tileChannels == channels) ? std::size_t{1} : tileFrames;
+                    auto const runLength = (tileChannels == channels) ? tileFrames * channels : tileChannels;
+                    for (auto k = std::size_t{0}; k < runs; ++k)
+                    {
+                        auto const runSrc = src + (frame + k) * frameSize + channel * sampleSize;
+                        auto const runDst = block + k * tileChannels * wordSize;
+                        if (wordSize == sizeof(float))
+                        {
+                            convertToNative<float>(runSrc, runLength, format, runDst);
+                        }
+                        else
+                        {
+                            convertToNative<double>(runSrc, runLength, format, runDst);
+                        }
+                    }
+
+                    copyStridedWords(block,
+                        wordSize,
+                        tileChannels * wordSize,
+                        dst + channel * slices.stride + frame * slices.elementStride,
+                        slices.stride,
+                        slices.elementStride,
+                        tileChannels,
+                        tileFrames,
+                        wordSize);
+                }
+            }
+            src += frames * frameSize;
+        }
+    }
+}
@@ -3,8 +3,16 @@
 
 #include "mxl-internal/SharedMemory.hpp"
 #include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <string_view>
 #include <stdexcept>
 #include <system_error>
 #include <fcntl.h>
@@ -19,8 +27,132 @@
 
 namespace mxl::lib
 {
+    namespace
+    {
+        /// The size of a PMD mapped huge page on x86-64, used if the kernel doesn't tell us otherwise.
+        constexpr auto DEFAULT_HUGE_PAGE_SIZE = std::size_t{2U * 1024U * 1024U};
+
+        std::size_t readHugePageSize() noexcept
+        {
+#ifdef __linux__
+            auto size = std::size_t{0};
+            if (auto in = std::ifstream{"/sys/kernel/mm/transparent_hugepage/hpage_pmd_size"}; (in >> size) && (size != 0U))
+            {
+                return size;
+            }
+#endif
+            return DEFAULT_HUGE_PAGE_SIZE;
+        }
+
+        /// Ensure the file is large enough to hold the shared data. Returns 0 on success or an errno value on failure.
+        int allocateFile(int fd, std::size_t size) noexcept
+        {
+#ifdef __linux__
+            return ::posix_fallocate(fd, 0, size);
+#else
+            return (::ftruncate(fd, size) < 0) ? errno : 0;
+#endif
+        }
+
+        /// Set the size of the file without allocating any memory for it. Returns 0 on success or an errno value on failure.
+        int resizeFile(int fd, std::size_t size) noexcept
+        {
+            return (::ftruncate(fd, size) < 0) ? errno : 0;
+        }
+
+        void adviseHugePages(void* data, std::size_t size) noexcept
+        {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (::madvise(data, size, MADV_HUGEPAGE) != 0)
+            {
+                auto const error = errno;
+                MXL_DEBUG("Failed to advise huge pages for shared memory segment: {}", ::strerror(error));
+            }
+#else
+            (void)data;
+            (void)size;
+#endif
+        }
+
+        /// Map all pages of a mapping up front, allocating them if the mapping is writable. Returns false if this is not supported, or
+        /// if not all pages could be mapped.
+        bool populateMapping(void* data, std::size_t size, bool writable = true) noexcept
+        {
+#if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+            return (::madvise(data, size, writable ? MADV_POPULATE_WRITE : MADV_POPULATE_READ) == 0);
+#else
+            (void)data;
+            (void)size;
+            (void)writable;
+            return false;
+#endif
+        }
+    }
+
+    std::size_t pageSize() noexcept
+    {
+        static auto const result = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return result;
+    }
+
+    std::size_t hugePageSize() noexcept
+    {
+        static auto const result = readHugePageSize();
+        return result;
+    }
+
+    std::size_t roundUpToHugePageSize(std::size_t size) noexcept
+    {
+        auto const pageSize = hugePageSize();
+        return ((size + pageSize - 1U) / pageSize) * pageSize;
+    }
+
+    MirroredMapping::MirroredMapping(int fd, bool writable, std::size_t ringSize, std::size_t ringCount)
+        : MirroredMapping{}
+    {
+        if ((ringSize == 0U) || (ringCount == 0U) || ((ringSize % pageSize()) != 0U))
+        {
+            throw std::invalid_argument{"Attempt to mirror rings that are not a multiple of the page size."};
+        }
+
+        // Reserve the address range for all rings and their mirrors first, so that the fixed mappings below can't clobber
+        // anything else.
+        auto const reservationSize = 2U * ringSize * ringCount;
+        auto const reservation = ::mmap(nullptr, reservationSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reservation == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(), "Could not reserve address space for mirrored rings.");
+        }
+        _data = reservation;
+        _ringSize = ringSize;
+        _ringCount = ringCount;
+
+        auto const protection = PROT_READ | (writable ? PROT_WRITE : 0);
+        for (auto ring = std::size_t{0}; ring < ringCount; ++ring)
+        {
+            auto const offset = static_cast<::off_t>(ring * ringSize);
+            for (auto const copy : {std::size_t{0}, std::size_t{1}})
+            {
+                auto const address = static_cast<std::uint8_t*>(_data) + (((2U * ring) + copy) * ringSize);
+                if (::mmap(address, ringSize, protection, MAP_FILE | MAP_SHARED | MAP_FIXED, fd, offset) == MAP_FAILED)
+                {
+                    // No need to unmap anything, as the destructor *will* be called, because we delegated to the default constructor.
+                    throw std::system_error(errno, std::generic_category(), "Could not map mirrored ring.");
+                }
+            }
+        }
+    }
+
+    MirroredMapping::~MirroredMapping()
+    {
+        if (_data != nullptr)
+        {
+            (void)::munmap(_data, 2U * _ringSize * _ringCount);
+        }
+    }
+
     MXL_EXPORT
-    SharedMemoryBase::SharedMemoryBase(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode)
+    SharedMemoryBase::SharedMemoryBase(char const* path, AccessMode mode, std::size_t payloadSize, LockMode lockMode, PageMode pageMode)
         : SharedMemoryBase{}
     {
         constexpr auto const OMODE_CREATE = O_EXCL | O_CREAT | O_RDWR | O_CLOEXEC;
@@ -29,15 +161,9 @@ namespace mxl::lib
 
         if ((mode == AccessMode::CREATE_READ_WRITE) && ((_fd = ::open(path, OMODE_CREATE, 0664)) != -1))
         {
-#ifdef __linux__
-            // Ensure the file is large enough to hold the shared data
-            if (auto error = ::posix_fallocate(_fd, 0, payloadSize); error != 0)
-            {
-#elif defined __APPLE__
-            if (::ftruncate(_fd, payloadSize) < 0)
+            // Memory for huge page backed segments is allocated once the mapping has been advised accordingly below.
+            if (auto const error = (pageMode == PageMode::Huge) ? resizeFile(_fd, payloadSize) : allocateFile(_fd, payloadSize); error != 0)
             {
-                auto const error = errno;
-#endif
                 // No need to close _fd, as the destructor *will* be called,
                 // because we delegated to the default constructor.
                 throw std::system_error(error, std::generic_category(), "Could not resize shared memory segment.");
@@ -88,6 +214,23 @@ namespace mxl::lib
                 {
                     _data = shared_data_buffer;
                     _mappedSize = statBuf.st_size;
+
+                    if (pageMode == PageMode::Huge)
+                    {
+                        adviseHugePages(_data, _mappedSize);
+
+                        // Populating the advised mapping allocates huge pages wherever the file system and the available memory
+                        // permit, and regular pages otherwise. Fall back to allocating regular pages for the whole file if the
+                        // kernel can't do that, so that running out of memory is still reported here instead of on first access.
+                        if (created() && !populateMapping(_data, _mappedSize))
+                        {
+                            MXL_DEBUG("Could not populate huge page backed shared memory segment, falling back to regular pages.");
+                            if (auto const error = allocateFile(_fd, _mappedSize); error != 0)
+                            {
+                                throw std::system_error(error, std::generic_category(), "Could not resize shared memory segment.");
+                            }
+                        }
+                    }
                 }
                 else
                 {
@@ -133,6 +276,94 @@ namespace mxl::lib
         }
     }
 
+    bool SharedMemoryBase::isHugePageBacked() const
+    {
+#ifdef __linux__
+        if (_data == nullptr)
+        {
+            return false;
+        }
+
+        // Pages of shared files are only mapped into our address space on first access.
+        (void)*static_cast<std::uint8_t const volatile*>(_data);
+
+        auto const address = reinterpret_cast<std::uintptr_t>(_data);
+        auto const pageSizeKb = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) / 1024U;
+        auto smaps = std::ifstream{"/proc/self/smaps"};
+        auto inMapping = false;
+        for (auto line = std::string{}; std::getline(smaps, line);)
+        {
+            auto start = std::uintptr_t{0};
+            auto end = std::uintptr_t{0};
+            if (std::sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2)
+            {
+                if (inMapping)
+                {
+                    break;
+                }
+                inMapping = (start <= address) && (address < end);
+                continue;
+            }
+
+            char name[64];
+            auto value = std::size_t{0};
+            if (inMapping && (std::sscanf(line.c_str(), "%63[^:]: %zu kB", name, &value) == 2))
+            {
+                // Transparent huge pages show up as PMD mappings, hugetlbfs pages through the page size of the mapping.
+                auto const field = std::string_view{name};
+                if ((((field == "ShmemPmdMapped") || (field == "FilePmdMapped")) && (value != 0U)) ||
+                    ((field == "KernelPageSize") && (value > pageSizeKb)))
+                {
+                    return true;
+                }
+            }
+        }
+#endif
+        return false;
+    }
+
+    void SharedMemoryBase::prefault(std::size_t offset, std::size_t length) noexcept
+    {
+        if ((_data == nullptr) || (offset >= _mappedSize))
+        {
+            return;
+        }
+
+        // madvise() requires a page aligned start address.
+        auto const pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto const begin = (offset / pageSize) * pageSize;
+        auto const end = std::min(offset + length, _mappedSize);
+        auto const first = static_cast<std::uint8_t*>(_data) + begin;
+        auto const writable = (_mode != AccessMode::READ_ONLY);
+
+        if (!populateMapping(first, end - begin, writable))
+        {
+            // Fault the pages in one by one on kernels that can't populate mappings. The atomic no-op write leaves the contents
+            // alone, even if someone else writes to the page concurrently.
+            for (auto page = first; page < static_cast<std::uint8_t*>(_data) + end; page += pageSize)
+            {
+                if (writable)
+                {
+                    (void)std::atomic_ref{*page}.fetch_or(0U, std::memory_order_relaxed);
+                }
+                else
+                {
+                    (void)*static_cast<std::uint8_t const volatile*>(page);
+                }
+            }
+        }
+    }
+
+    MirroredMapping SharedMemoryBase::mapMirrored(std::size_t ringSize, std::size_t ringCount) const
+    {
+        if ((_fd == -1) || ((ringSize * ringCount) > _mappedSize))
+        {
+            throw std::invalid_argument{"Attempt to mirror rings beyond the end of a shared memory segment."};
+        }
+
+        return MirroredMapping{_fd, (_mode != AccessMode::READ_ONLY), ringSize, ringCount};
+    }
+
     bool SharedMemoryBase::makeExclusive()
     {
         if (_lockType == LockType::Exclusive)
@@ -5,7 +5,10 @@
 #include <cerrno>
 #include <climits>
 #include <cstdint>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <stdexcept>
 #include <unistd.h>
 #if defined(__linux__)
 #   include <sys/syscall.h>
@@ -15,6 +18,7 @@
 #   include <os/os_sync_wait_on_address.h>
 #endif
 #include "mxl-internal/Logging.hpp"
+#include "mxl-internal/Thread.hpp"
 
 namespace mxl::lib
 {
@@ -43,6 +47,33 @@ namespace mxl::lib
             return ::syscall(SYS_futex, futex, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
         }
 
+#   if defined(SYS_futex_waitv)
+#       define MXL_HAVE_FUTEX_WAITV 1
+
+        int do_wait_multiple(std::span<WaitTarget const> targets, Timepoint deadline)
+        {
+            auto waiters = std::array<::futex_waitv, MAX_WAIT_TARGETS>{};
+            for (auto i = std::size_t{0}; i < targets.size(); ++i)
+            {
+                waiters[i].val = targets[i].expected;
+                waiters[i].uaddr = reinterpret_cast<std::uintptr_t>(targets[i].address);
+                // Deliberately not FUTEX_PRIVATE_FLAG, the monitored words live in memory shared with other processes.
+                waiters[i].flags = FUTEX_32;
+            }
+
+            // Contrary to FUTEX_WAIT, the timeout of FUTEX_WAITV is an absolute point in time of the specified clock.
+            auto const deadlineTs = asTimeSpec(deadline);
+            return ::syscall(SYS_futex_waitv, waiters.data(), targets.size(), 0, &deadlineTs, CLOCK_REALTIME);
+        }
+
+        bool probe_wait_multiple() noexcept
+        {
+            // Kernels implementing FUTEX_WAITV reject an empty set of futexes with EINVAL, older ones fail with ENOSYS and
+            // sandboxes may fail with EPERM.
+            return (::syscall(SYS_futex_waitv, nullptr, 0, 0, nullptr, CLOCK_REALTIME) == -1) && (errno == EINVAL);
+        }
+#   endif
+
 #elif defined(__APPLE__)
         int do_wait(void const* futex, std::uint32_t expected, Duration timeout)
         {
@@ -136,6 +167,279 @@ namespace mxl::lib
         do_wake_all(in_addr);
     }
 
+    bool isWaitOnMultipleSupported() noexcept
+    {
+#if defined(MXL_HAVE_FUTEX_WAITV)
+        static auto const result = probe_wait_multiple();
+        return result;
+#else
+        return false;
+#endif
+    }
+
+    bool waitUntilAnyChanged(std::span<WaitTarget const> in_targets, Timepoint in_deadline)
+    {
+#if defined(MXL_HAVE_FUTEX_WAITV)
+        if (in_targets.size() > MAX_WAIT_TARGETS)
+        {
+            throw std::invalid_argument{"Too many addresses to wait on."};
+        }
+
+        while (true)
+        {
+            for (auto const& target : in_targets)
+            {
+                // NOTE: atomic_ref<T const> is only available from C++26 on.
+                if (std::atomic_ref{*const_cast<std::uint32_t*>(target.address)}.load(std::memory_order_acquire) != target.expected)
+                {
+                    return true;
+                }
+            }
+
+            if (currentTime(Clock::Realtime) >= in_deadline)
+            {
+                return false;
+            }
+
+            if (do_wait_multiple(in_targets, in_deadline) == -1)
+            {
+                switch (errno)
+                {
+                    case EAGAIN:
+                        // The kernel detected one of the values to not be equal to its expected value.
+                        continue;
+
+                    case EINTR:
+                        // Interrupted. try again.
+                        continue;
+
+                    case ETIMEDOUT: MXL_TRACE("ETIMEDOUT. returning false"); break;
+
+                    default:        MXL_DEBUG("Failed to wait on multiple addresses: {}", errno); break;
+                }
+                return false;
+            }
+        }
+#else
+        (void)in_targets;
+        (void)in_deadline;
+        throw std::logic_error{"Waiting on multiple addresses is not supported on this platform."};
+#endif
+    }
+
+    WaitStrategy::WaitStrategy() noexcept
+        : _policy{WaitPolicy::Futex}
+        , _maxSpin{DEFAULT_MAX_SPIN}
+        , _maxSleep{}
+        , _maxSleepUntil{}
+        , _averageWait{DEFAULT_MAX_SPIN.value / 2}
+        , _waits{0}
+        , _spinWakeups{0}
+        , _futexWakeups{0}
+        , _timeouts{0}
+        , _latencySamples{0}
+        , _totalWakeupLatency{0}
+        , _maxWakeupLatency{0}
+        , _wastedWakeups{0}
+    {}
+
+    void WaitStrategy::configure(WaitPolicy in_policy, Duration in_maxSpin) noexcept
+    {
+        _policy = in_policy;
+        _maxSpin = in_maxSpin;
+        // Start out assuming that spinning pays off, the average will quickly correct itself otherwise.
+        _averageWait.store(in_maxSpin.value / 2, std::memory_order_relaxed);
+    }
+
+    WaitPolicy WaitStrategy::policy() const noexcept
+    {
+        return _policy;
+    }
+
+    void WaitStrategy::limitSleep(Duration in_maxSleep, Timepoint in_until) noexcept
+    {
+        _maxSleep = in_maxSleep;
+        _maxSleepUntil = in_until;
+    }
+
+    bool WaitStrategy::waitUntilChanged(std::uint32_t const* in_addr, std::uint32_t in_expected, Timepoint in_deadline,
+        std::uint64_t const* in_changeTime, std::uint32_t* in_sleepers, std::uint64_t const* in_nextChangeTime)
+    {
+#if _LIBCPP_VERSION
+        // libc++ limitation due to: https://github.com/llvm/llvm-project/issues/118378
+        auto syncObject = std::atomic_ref{*const_cast<std::uint32_t*>(in_addr)};
+#else
+        auto syncObject = std::atomic_ref{*in_addr};
+#endif
+        if (syncObject.load(std::memory_order_acquire) != in_expected)
+        {
+            return true;
+        }
+
+        _waits.fetch_add(1U, std::memory_order_relaxed);
+        auto const start = currentTime(Clock::Realtime);
+
+        if (auto const budget = spinBudget(); budget.value > 0)
+        {
+            auto now = start;
+
+            // If the change is announced to happen well beyond the spin budget, sleep in the kernel until shortly before
+            // instead of giving up on spinning, so that the change is still picked up by spinning. The sleep ends early if
+            // the change happens before it is due.
+            if (auto const wakeup = std::min(spinStart(start, budget, in_nextChangeTime), in_deadline); wakeup > start)
+            {
+                if (sleepUntilChanged(in_addr, in_expected, wakeup, in_sleepers))
+                {
+                    recordWakeup(start, currentTime(Clock::Realtime), false, in_changeTime);
+                    return true;
+                }
+                now = currentTime(Clock::Realtime);
+            }
+
+            auto const spinDeadline = std::min(now + budget, in_deadline);
+            while (now < spinDeadline)
+            {
+                // Only consult the clock every few iterations, it is considerably more expensive than a pause.
+                for (auto i = 0; i < 64; ++i)
+                {
+                    if (syncObject.load(std::memory_order_acquire) != in_expected)
+                    {
+                        recordWakeup(start, currentTime(Clock::Realtime), true, in_changeTime);
+                        return true;
+                    }
+                    this_thread::yieldProcessor();
+                }
+                now = currentTime(Clock::Realtime);
+            }
+        }
+
+        if (sleepUntilChanged(in_addr, in_expected, in_deadline, in_sleepers))
+        {
+            recordWakeup(start, currentTime(Clock::Realtime), false, in_changeTime);
+            return true;
+        }
+
+        _timeouts.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    void WaitStrategy::recordWastedWakeup() noexcept
+    {
+        _wastedWakeups.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    bool WaitStrategy::sleepUntilChanged(std::uint32_t const* in_addr, std::uint32_t in_expected, Timepoint in_deadline,
+        std::uint32_t* in_sleepers) const
+    {
+        if (in_sleepers != nullptr)
+        {
+            std::atomic_ref{*in_sleepers}.fetch_add(1U, std::memory_order_relaxed);
+            // Pairs with the fence of the modifying party: Either it observes our announcement and wakes us up, or the kernel
+            // observes the changed value and doesn't put us to sleep in the first place.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        auto result = false;
+        while (true)
+        {
+            auto const now = currentTime(Clock::Realtime);
+            auto const sleepDeadline = ((_maxSleep.value > 0) && (now < _maxSleepUntil)) ? std::min(now + _maxSleep, in_deadline) : in_deadline;
+            if (mxl::lib::waitUntilChanged(in_addr, in_expected, sleepDeadline))
+            {
+                result = true;
+                break;
+            }
+            if (sleepDeadline >= in_deadline)
+            {
+                break;
+            }
+        }
+
+        if (in_sleepers != nullptr)
+        {
+            std::atomic_ref{*in_sleepers}.fetch_sub(1U, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    WaitStatistics WaitStrategy::statistics() const noexcept
+    {
+        return {
+            _waits.load(std::memory_order_relaxed),
+            _spinWakeups.load(std::memory_order_relaxed),
+            _futexWakeups.load(std::memory_order_relaxed),
+            _timeouts.load(std::memory_order_relaxed),
+            _latencySamples.load(std::memory_order_relaxed),
+            _totalWakeupLatency.load(std::memory_order_relaxed),
+            _maxWakeupLatency.load(std::memory_order_relaxed),
+            _wastedWakeups.load(std::memory_order_relaxed),
+        };
+    }
+
+    Duration WaitStrategy::spinBudget() const noexcept
+    {
+        switch (_policy)
+        {
+            case WaitPolicy::Spin: return _maxSpin;
+
+            case WaitPolicy::Adaptive:
+            {
+                // Spinning only pays off if the change is likely to arrive within the spin budget. Give it some headroom over
+                // the average, but don't spin at all if waits typically take longer than we are willing to spin.
+                auto const averageWait = _averageWait.load(std::memory_order_relaxed);
+                return (averageWait <= _maxSpin.value) ? Duration{std::min(2 * averageWait, _maxSpin.value)} : Duration{};
+            }
+
+            default: return Duration{};
+        }
+    }
+
+    Timepoint WaitStrategy::spinStart(Timepoint in_now, Duration in_budget, std::uint64_t const* in_nextChangeTime) noexcept
+    {
+        if (in_nextChangeTime != nullptr)
+        {
+            auto const nextChangeTime = std::atomic_ref{*const_cast<std::uint64_t*>(in_nextChangeTime)}.load(std::memory_order_relaxed);
+            if (nextChangeTime != 0U)
+            {
+                // The hint is a TAI timestamp, while waits are timed against the realtime clock.
+                auto const untilChange = Timepoint{static_cast<Timepoint::value_type>(nextChangeTime)} - currentTime(Clock::TAI);
+                if (untilChange > in_budget)
+                {
+                    return in_now + (untilChange - in_budget);
+                }
+            }
+        }
+        return in_now;
+    }
+
+    void WaitStrategy::recordWakeup(Timepoint in_start, Timepoint in_end, bool in_spun, std::uint64_t const* in_changeTime) noexcept
+    {
+        (in_spun ? _spinWakeups : _futexWakeups).fetch_add(1U, std::memory_order_relaxed);
+
+        if (_policy == WaitPolicy::Adaptive)
+        {
+            // Racy read-modify-write, but losing the occasional sample is harmless.
+            auto const averageWait = _averageWait.load(std::memory_order_relaxed);
+            _averageWait.store(averageWait + ((in_end - in_start).value - averageWait) / 8, std::memory_order_relaxed);
+        }
+
+        if (in_changeTime != nullptr)
+        {
+            auto const changeTime = std::atomic_ref{*const_cast<std::uint64_t*>(in_changeTime)}.load(std::memory_order_relaxed);
+            auto const now = static_cast<std::uint64_t>(currentTime(Clock::TAI).value);
+            if ((changeTime != 0U) && (now >= changeTime))
+            {
+                auto const latency = now - changeTime;
+                _latencySamples.fetch_add(1U, std::memory_order_relaxed);
+                _totalWakeupLatency.fetch_add(latency, std::memory_order_relaxed);
+
+                auto maxLatency = _maxWakeupLatency.load(std::memory_order_relaxed);
+                while ((latency > maxLatency) && !_maxWakeupLatency.compare_exchange_weak(maxLatency, latency, std::memory_order_relaxed))
+                {}
+            }
+        }
+    }
+
     // Explicit template instantiations
     template bool waitUntilChanged<std::uint32_t>(std::uint32_t const* in_addr, std::uint32_t in_expected, Timepoint in_deadline);
     template bool waitUntilChanged<std::uint32_t>(std::uint32_t const* in_addr, std::uint32_t in_expected, Duration in_timeout);
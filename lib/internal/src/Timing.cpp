@@ -2,14 +2,146 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl-internal/Timing.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
 #include <mxl/platform.h>
 #include "mxl-internal/detail/ClockHelpers.hpp"
 
 namespace mxl::lib
 {
+    namespace
+    {
+        /** How often the offset between a derived TAI clock source and the kernel TAI clock is measured again. */
+        constexpr auto TAI_OFFSET_REFRESH_INTERVAL = fromSeconds(1.0);
+
+        /**
+         * The maximum difference between a derived TAI clock source and the kernel TAI clock that is accepted when
+         * validating the source. Generous enough to tolerate being preempted between the two clock reads.
+         */
+        constexpr auto TAI_SOURCE_TOLERANCE = fromMicroSeconds(100.0);
+
+        /** The number of samples from which the offset measurement with the narrowest read window is taken. */
+        constexpr auto TAI_OFFSET_SAMPLES = 5;
+
+        /**
+         * The offset of a derived TAI clock source. Each source has its own, so that an offset is only ever combined
+         * with a reading of the clock it was measured against.
+         */
+        struct DerivedTaiClock
+        {
+            /** Offset to add to the source clock to obtain TAI, in nanoseconds. */
+            std::atomic<std::int64_t> offset{0};
+
+            /** Source clock time at which the offset is due to be refreshed, in nanoseconds. */
+            std::atomic<std::int64_t> nextRefresh{std::numeric_limits<std::int64_t>::max()};
+        };
+
+        struct TaiClockState
+        {
+            std::atomic<TaiClockSource> source{TaiClockSource::Kernel};
+
+            /** Serializes the selection of the source. */
+            std::mutex selectionMutex;
+
+            /** Whether the source has been selected, after which it can't be changed anymore. Guarded by selectionMutex. */
+            bool selected{false};
+
+            DerivedTaiClock realtime;
+            DerivedTaiClock monotonic;
+        };
+
+        constinit auto taiClock = TaiClockState{};
+
+        Timepoint readClock(clockid_t clockId) noexcept
+        {
+            std::timespec ts;
+            return (::clock_gettime(clockId, &ts) == 0) ? asTimepoint(ts) : Timepoint{};
+        }
+
+        Timepoint kernelTaiTime() noexcept
+        {
+            auto const result = readClock(detail::clockToId(Clock::TAI));
+            return result ? result + detail::getClockOffset(Clock::TAI) : result;
+        }
+
+        clockid_t sourceClockId(TaiClockSource source) noexcept
+        {
+            return (source == TaiClockSource::Monotonic) ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+        }
+
+        DerivedTaiClock& derivedClock(TaiClockSource source) noexcept
+        {
+            return (source == TaiClockSource::Monotonic) ? taiClock.monotonic : taiClock.realtime;
+        }
+
+        /**
+         * Measure the offset between the kernel TAI clock and the specified source clock. Of several samples the one
+         * with the narrowest window between the source clock reads bracketing the TAI read is used.
+         *
+         * \return true if all clocks could be read.
+         */
+        bool measureTaiOffset(clockid_t sourceClock, std::int64_t& offset) noexcept
+        {
+            auto bestWindow = std::numeric_limits<std::int64_t>::max();
+            for (auto i = 0; i < TAI_OFFSET_SAMPLES; ++i)
+            {
+                auto const before = readClock(sourceClock);
+                auto const tai = kernelTaiTime();
+                auto const after = readClock(sourceClock);
+                if (!before || !tai || !after)
+                {
+                    return false;
+                }
+
+                if (auto const window = (after - before).value; window < bestWindow)
+                {
+                    bestWindow = window;
+                    offset = tai.value - (before.value + window / 2);
+                }
+            }
+            return true;
+        }
+
+        Timepoint derivedTaiTime(TaiClockSource source) noexcept
+        {
+            auto& clock = derivedClock(source);
+            auto const sourceClock = sourceClockId(source);
+            auto const now = readClock(sourceClock);
+            if (!now)
+            {
+                return now;
+            }
+
+            // Whoever manages to move the refresh deadline measures the offset, everybody else carries on with
+            // the previous one in the meantime.
+            auto nextRefresh = clock.nextRefresh.load(std::memory_order_relaxed);
+            if ((now.value >= nextRefresh) &&
+                clock.nextRefresh.compare_exchange_strong(nextRefresh, (now + TAI_OFFSET_REFRESH_INTERVAL).value, std::memory_order_relaxed))
+            {
+                auto offset = std::int64_t{};
+                if (measureTaiOffset(sourceClock, offset))
+                {
+                    clock.offset.store(offset, std::memory_order_relaxed);
+                }
+            }
+
+            return now + Duration{clock.offset.load(std::memory_order_relaxed)};
+        }
+    }
+
     MXL_EXPORT
     Timepoint currentTime(Clock clock) noexcept
     {
+        if (clock == Clock::TAI)
+        {
+            if (auto const source = taiClock.source.load(std::memory_order_acquire); source != TaiClockSource::Kernel)
+            {
+                return derivedTaiTime(source);
+            }
+        }
+
         auto result = Timepoint{};
 
         std::timespec ts;
@@ -20,6 +152,47 @@ namespace mxl::lib
         return result;
     }
 
+    TaiClockSourceStatus setTaiClockSource(TaiClockSource source) noexcept
+    {
+        auto lock = std::lock_guard{taiClock.selectionMutex};
+        if (taiClock.selected)
+        {
+            return (source == taiClock.source.load(std::memory_order_relaxed)) ? TaiClockSourceStatus::Selected : TaiClockSourceStatus::Conflicting;
+        }
+
+        if (source != TaiClockSource::Kernel)
+        {
+            auto const sourceClock = sourceClockId(source);
+            auto offset = std::int64_t{};
+            if (!measureTaiOffset(sourceClock, offset))
+            {
+                return TaiClockSourceStatus::Inaccurate;
+            }
+
+            // Check that the derived time actually tracks the kernel TAI clock before putting it into effect.
+            auto const now = readClock(sourceClock);
+            auto const kernel = kernelTaiTime();
+            if (!now || !kernel || (std::abs((kernel - (now + Duration{offset})).value) > TAI_SOURCE_TOLERANCE.value))
+            {
+                return TaiClockSourceStatus::Inaccurate;
+            }
+
+            // Readers that observe the new source through the release below also observe its offset.
+            auto& clock = derivedClock(source);
+            clock.offset.store(offset, std::memory_order_relaxed);
+            clock.nextRefresh.store((now + TAI_OFFSET_REFRESH_INTERVAL).value, std::memory_order_relaxed);
+        }
+
+        taiClock.source.store(source, std::memory_order_release);
+        taiClock.selected = true;
+        return TaiClockSourceStatus::Selected;
+    }
+
+    TaiClockSource getTaiClockSource() noexcept
+    {
+        return taiClock.source.load(std::memory_order_relaxed);
+    }
+
     Timepoint currentTimeUTC() noexcept
     {
         auto result = Timepoint{};
@@ -3,19 +3,27 @@
 
 #include <chrono>
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <filesystem>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <thread>
+#include <utility>
+#include <vector>
 #include <uuid.h>
 #include <catch2/catch_test_macros.hpp>
 #include <fmt/format.h>
+#include <sys/stat.h>
 #include "mxl-internal/FlowManager.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/Timing.hpp"
 #include "../../tests/Utils.hpp"
 
 using namespace mxl::lib;
@@ -133,6 +141,318 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Creat
     REQUIRE(!exists(flowDirectory));
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Create Single Segment Video Flow Structure", "[flow manager]")
+{
+    auto const flowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const flowId = *uuids::uuid::from_string("6a3c1f0e-52b1-4b8c-9d52-2f4be1a4c7d3");
+    auto const grainRate = mxlRational{60000, 1001};
+
+    auto const payloadSize = 5000;
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{payloadSize, 0, 0, 0};
+
+    auto manager = std::make_shared<FlowManager>(domain);
+    auto [created, flowData] = manager->createOrOpenDiscreteFlow(
+        flowId, flowDef, MXL_DATA_FORMAT_VIDEO, 5, grainRate, payloadSize, 1, sliceSizes, 1, 1, DiscreteFlowLayout::SingleSegment);
+
+    REQUIRE(created);
+    REQUIRE(flowData->flowInfo()->version == FLOW_DATA_VERSION_SINGLE_SEGMENT);
+    REQUIRE(flowData->layout() == DiscreteFlowLayout::SingleSegment);
+    REQUIRE(flowData->grainCount() == 5);
+
+    // Grains are laid out back to back with a page aligned stride.
+    auto const stride = grainSegmentStride(payloadSize);
+    REQUIRE(stride % 4096U == 0U);
+    for (auto i = std::size_t{0}; i < 5U; ++i)
+    {
+        auto const grain = flowData->grainAt(i);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(grain) % 4096U == 0U);
+        REQUIRE(reinterpret_cast<std::uint8_t const*>(grain) == reinterpret_cast<std::uint8_t const*>(flowData->grainAt(0)) + i * stride);
+        REQUIRE(grain->header.info.grainSize == payloadSize);
+        REQUIRE(grain->header.info.version == GRAIN_HEADER_VERSION);
+    }
+    REQUIRE(flowData->grainAt(5) == nullptr);
+
+    // The grain directory only contains the single segment file.
+    auto const flowDirectory = makeFlowDirectoryName(domain, uuids::to_string(flowId));
+    auto const grainDir = makeGrainDirectoryName(flowDirectory);
+    REQUIRE(is_regular_file(makeGrainSegmentFilePath(grainDir)));
+    REQUIRE(std::distance(std::filesystem::directory_iterator{grainDir}, std::filesystem::directory_iterator{}) == 1);
+
+    // Data written through the writer mapping is visible through a reader mapping.
+    flowData->grainInfoAt(3)->index = 42U;
+    {
+        auto openData = manager->openFlow(flowId, AccessMode::READ_ONLY);
+        auto const d = dynamic_cast<DiscreteFlowData*>(openData.get());
+        REQUIRE(d != nullptr);
+        REQUIRE(d->layout() == DiscreteFlowLayout::SingleSegment);
+        REQUIRE(d->grainCount() == 5U);
+        REQUIRE(d->grainInfoAt(3)->index == 42U);
+        REQUIRE(d->grainInfoAt(4)->grainSize == payloadSize);
+    }
+
+    // Opening with the default layout must not change the layout of the existing flow.
+    {
+        auto [created, flow] = manager->createOrOpenDiscreteFlow(flowId, flowDef, MXL_DATA_FORMAT_VIDEO, 5, grainRate, payloadSize, 1, sliceSizes);
+        REQUIRE_FALSE(created);
+        REQUIRE(flow->layout() == DiscreteFlowLayout::SingleSegment);
+    }
+
+    flowData.reset();
+    REQUIRE(manager->deleteFlow(flowId));
+    REQUIRE(!exists(flowDirectory));
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Parallel grain allocation", "[flow manager]")
+{
+    auto const flowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const flowId = *uuids::uuid::from_string("9c2e4b1a-3d5f-4a6b-8c7d-1e2f3a4b5c6d");
+    auto const grainRate = mxlRational{60000, 1001};
+
+    // Large enough for the grains to be allocated by multiple threads.
+    auto const payloadSize = std::size_t{5120U * 1080U};
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{5120, 0, 0, 0};
+    auto const grainCount = std::size_t{24};
+
+    auto manager = std::make_shared<FlowManager>(domain);
+    for (auto const& [layout, prefault] : {std::pair{DiscreteFlowLayout::PerGrainFiles, false},
+             std::pair{DiscreteFlowLayout::PerGrainFiles, true},
+             std::pair{DiscreteFlowLayout::SingleSegment, false},
+             std::pair{DiscreteFlowLayout::SingleSegment, true}})
+    {
+        auto const timeBeforeCreation = currentTime(Clock::TAI).value;
+        auto [created, flowData] = manager->createOrOpenDiscreteFlow(
+            flowId, flowDef, MXL_DATA_FORMAT_VIDEO, grainCount, grainRate, payloadSize, 1080, sliceSizes, 1, 1, layout, false, false, prefault);
+        REQUIRE(created);
+        REQUIRE(flowData->layout() == layout);
+        REQUIRE(flowData->grainCount() == grainCount);
+
+        auto const& common = flowData->flowInfo()->config.common;
+        REQUIRE(common.creationTime >= static_cast<std::uint64_t>(timeBeforeCreation));
+        REQUIRE(common.creationDuration > 0U);
+        REQUIRE(common.creationTime + common.creationDuration <= static_cast<std::uint64_t>(currentTime(Clock::TAI).value));
+
+        // Every grain is initialized and backed by its own memory, regardless of the thread that allocated it.
+        for (auto i = std::size_t{0}; i < grainCount; ++i)
+        {
+            auto const grain = flowData->grainAt(i);
+            REQUIRE(grain != nullptr);
+            REQUIRE(grain->header.info.version == GRAIN_HEADER_VERSION);
+            REQUIRE(grain->header.info.grainSize == payloadSize);
+            REQUIRE(grain->header.info.totalSlices == 1080U);
+            std::memset(reinterpret_cast<std::uint8_t*>(grain) + MXL_GRAIN_PAYLOAD_OFFSET, static_cast<int>(i), payloadSize);
+        }
+
+        // The grains are opened in the same order by readers.
+        {
+            auto openData = manager->openFlow(flowId, AccessMode::READ_ONLY);
+            auto const d = dynamic_cast<DiscreteFlowData*>(openData.get());
+            REQUIRE(d != nullptr);
+            REQUIRE(d->flowInfo()->config.common.creationTime == common.creationTime);
+            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            {
+                auto const payload = reinterpret_cast<std::uint8_t const*>(d->grainAt(i)) + MXL_GRAIN_PAYLOAD_OFFSET;
+                REQUIRE(payload[0] == static_cast<std::uint8_t>(i));
+                REQUIRE(payload[payloadSize - 1U] == static_cast<std::uint8_t>(i));
+            }
+        }
+
+        flowData.reset();
+        REQUIRE(manager->deleteFlow(flowId));
+    }
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Lazy grain mapping", "[flow manager]")
+{
+    auto const flowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const flowId = *uuids::uuid::from_string("d4c3b2a1-6f5e-4d7c-8b9a-0f1e2d3c4b5a");
+    auto const grainRate = mxlRational{60000, 1001};
+
+    auto const payloadSize = 1024;
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{payloadSize, 0, 0, 0};
+    auto const grainCount = std::size_t{8};
+
+    auto manager = std::make_shared<FlowManager>(domain);
+    auto [created, writerData] =
+        manager->createOrOpenDiscreteFlow(flowId, flowDef, MXL_DATA_FORMAT_VIDEO, grainCount, grainRate, payloadSize, 1, sliceSizes);
+    REQUIRE(created);
+    for (auto i = std::size_t{0}; i < grainCount; ++i)
+    {
+        writerData->grainAt(i)->header.info.index = i;
+    }
+
+    // Nothing is mapped up front, and each grain is mapped once on first access.
+    {
+        auto flowData = manager->openFlow(flowId, AccessMode::READ_ONLY, GrainMapping::Lazy);
+        auto const reader = dynamic_cast<DiscreteFlowData*>(flowData.get());
+        REQUIRE(reader != nullptr);
+        REQUIRE(reader->grainCount() == grainCount);
+        REQUIRE(reader->mappedGrainCount() == 0U);
+
+        auto const grain = reader->grainAt(5);
+        REQUIRE(grain != nullptr);
+        REQUIRE(grain->header.info.index == 5U);
+        REQUIRE(reader->mappedGrainCount() == 1U);
+        REQUIRE(reader->grainAt(5) == grain);
+        REQUIRE(reader->mappedGrainCount() == 1U);
+        REQUIRE(reader->grainAt(grainCount) == nullptr);
+
+        // Concurrent first accesses agree on the mapping of each grain.
+        auto grains = std::array<std::array<Grain const*, 8>, 4>{};
+        auto threads = std::list<std::thread>{};
+        for (auto t = std::size_t{0}; t < grains.size(); ++t)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    for (auto i = std::size_t{0}; i < grainCount; ++i)
+                    {
+                        grains[t][(i + t) % grainCount] = reader->grainAt((i + t) % grainCount);
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (auto i = std::size_t{0}; i < grainCount; ++i)
+        {
+            REQUIRE(grains[0][i] != nullptr);
+            REQUIRE(grains[0][i]->header.info.index == i);
+            for (auto const& threadGrains : grains)
+            {
+                REQUIRE(threadGrains[i] == grains[0][i]);
+            }
+        }
+        REQUIRE(reader->mappedGrainCount() == grainCount);
+    }
+
+    // Grains stay mapped once they were accessed, so that pointers handed out earlier remain valid.
+    {
+        auto flowData = manager->openFlow(flowId, AccessMode::READ_ONLY, GrainMapping::Lazy);
+        auto const reader = dynamic_cast<DiscreteFlowData*>(flowData.get());
+        REQUIRE(reader != nullptr);
+
+        auto const first = reader->grainAt(0);
+        REQUIRE(first != nullptr);
+        for (auto i = std::size_t{0}; i < grainCount; ++i)
+        {
+            REQUIRE(reader->grainAt(i)->header.info.index == i);
+        }
+        REQUIRE(reader->mappedGrainCount() == grainCount);
+        REQUIRE(reader->grainAt(0) == first);
+        REQUIRE(first->header.info.index == 0U);
+    }
+
+    // Grains that can't be mapped anymore are reported as missing.
+    {
+        auto flowData = manager->openFlow(flowId, AccessMode::READ_ONLY, GrainMapping::Lazy);
+        auto const reader = dynamic_cast<DiscreteFlowData*>(flowData.get());
+        REQUIRE(reader != nullptr);
+        REQUIRE(remove(makeGrainDataFilePath(domain, uuids::to_string(flowId), 3)));
+        REQUIRE(reader->grainAt(3) == nullptr);
+        REQUIRE(reader->grainAt(4) != nullptr);
+    }
+
+    writerData.reset();
+    REQUIRE(manager->deleteFlow(flowId));
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Flow pool", "[flow manager]")
+{
+    auto const videoDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const audioDef = mxl::tests::readFile("data/audio_flow.json");
+    auto const firstId = *uuids::uuid::from_string("3b8f1c2d-4e5a-4b6c-9d7e-8f9a0b1c2d3e");
+    auto const secondId = *uuids::uuid::from_string("7a6b5c4d-3e2f-4a1b-8c9d-0e1f2a3b4c5d");
+    auto const audioId = *uuids::uuid::from_string("1f2e3d4c-5b6a-4978-8695-a4b3c2d1e0f9");
+
+    auto const payloadSize = 1024;
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{payloadSize, 0, 0, 0};
+
+    auto const poolDirectory = makeFlowPoolDirectoryName(domain);
+    auto const pooledDataFiles = [&]()
+    {
+        auto result = std::vector<std::filesystem::path>{};
+        if (exists(poolDirectory))
+        {
+            for (auto const& entry : std::filesystem::directory_iterator{poolDirectory})
+            {
+                result.push_back(makeFlowDataFilePath(entry.path()));
+            }
+        }
+        return result;
+    };
+    // The pool is refilled in the background.
+    auto const waitForPooledFlows = [&](std::size_t count)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while ((pooledDataFiles().size() != count) && (std::chrono::steady_clock::now() < deadline))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        return pooledDataFiles().size() == count;
+    };
+
+    auto manager = std::make_shared<FlowManager>(domain);
+    manager->setFlowPoolSize(2U);
+
+    // The first flow of a geometry is created from scratch and fills the pool for the next ones.
+    auto [firstCreated, first] =
+        manager->createOrOpenDiscreteFlow(firstId, videoDef, MXL_DATA_FORMAT_VIDEO, 5, mxlRational{60000, 1001}, payloadSize, 1, sliceSizes);
+    REQUIRE(firstCreated);
+    REQUIRE(waitForPooledFlows(2U));
+
+    auto skeletonInodes = std::vector<ino_t>{};
+    for (auto const& dataFile : pooledDataFiles())
+    {
+        struct ::stat st;
+        REQUIRE(::stat(dataFile.c_str(), &st) == 0);
+        skeletonInodes.push_back(st.st_ino);
+    }
+
+    // A flow of the same geometry, but with a different identity and rate, is created from one of the pooled skeletons.
+    auto [secondCreated, second] =
+        manager->createOrOpenDiscreteFlow(secondId, videoDef, MXL_DATA_FORMAT_VIDEO, 5, mxlRational{50, 1}, payloadSize, 1, sliceSizes);
+    REQUIRE(secondCreated);
+    REQUIRE(uuids::uuid{second->flowInfo()->config.common.id} == secondId);
+    REQUIRE(second->flowInfo()->config.common.grainRate.numerator == 50);
+    REQUIRE(second->flowInfo()->config.common.creationTime != 0U);
+    REQUIRE(second->flowInfo()->config.discrete.grainCount == 5U);
+    REQUIRE(second->grainCount() == 5U);
+    REQUIRE(second->grainAt(4)->header.info.grainSize == static_cast<std::uint32_t>(payloadSize));
+    REQUIRE(mxl::tests::readFile(makeFlowDescriptorFilePath(domain, uuids::to_string(secondId))) == videoDef);
+
+    struct ::stat st;
+    REQUIRE(::stat(makeFlowDataFilePath(domain, uuids::to_string(secondId)).c_str(), &st) == 0);
+    REQUIRE(std::find(skeletonInodes.begin(), skeletonInodes.end(), st.st_ino) != skeletonInodes.end());
+    REQUIRE(second->flowState()->inode == st.st_ino);
+
+    // The claimed skeleton is replaced.
+    REQUIRE(waitForPooledFlows(2U));
+
+    // Continuous flows are pooled separately.
+    auto [audioCreated, audio] =
+        manager->createOrOpenContinuousFlow(audioId, audioDef, MXL_DATA_FORMAT_AUDIO, mxlRational{48000, 1}, 2, sizeof(float), 4096);
+    REQUIRE(audioCreated);
+    REQUIRE(waitForPooledFlows(4U));
+
+    // Pooled skeletons are not flows.
+    REQUIRE(manager->listFlows().size() == 3U);
+
+    REQUIRE(manager->trimFlowPool() == 0U);
+    manager->setFlowPoolSize(1U);
+    REQUIRE(manager->trimFlowPool() == 2U);
+    manager->setFlowPoolSize(0U);
+    REQUIRE(manager->trimFlowPool() == 2U);
+    REQUIRE(pooledDataFiles().empty());
+
+    first.reset();
+    second.reset();
+    audio.reset();
+    REQUIRE(manager->deleteFlow(firstId));
+    REQUIRE(manager->deleteFlow(secondId));
+    REQUIRE(manager->deleteFlow(audioId));
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Create Audio Flow Structure", "[flow manager]")
 {
     auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
@@ -642,3 +962,234 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "FlowManager: paralle
     // In each iteration all workers that did not create the flow should have opened it.
     REQUIRE(numOpened.load() == numIterations * (numWorkers - 1));
 }
+
+TEST_CASE("Grain header : Consistent grain info snapshots", "[flow manager][concurrency]")
+{
+    auto const header = std::make_unique<GrainHeader>();
+
+    // The writer keeps all meaningful fields derived from the same counter, so any mix of two updates is detectable.
+    auto const makeInfo = [](std::uint64_t i)
+    {
+        auto info = mxlGrainInfo{};
+        info.index = i;
+        info.flags = static_cast<std::uint32_t>(i);
+        info.grainSize = static_cast<std::uint32_t>(i * 3U);
+        info.totalSlices = static_cast<std::uint16_t>(i * 5U);
+        info.validSlices = static_cast<std::uint16_t>(i * 7U);
+        return info;
+    };
+    storeGrainInfo(*header, makeInfo(0U));
+
+    auto stop = std::atomic<bool>{false};
+    auto writer = std::thread{[&]()
+        {
+            for (auto i = std::uint64_t{1}; !stop.load(std::memory_order_relaxed); ++i)
+            {
+                storeGrainInfo(*header, makeInfo(i));
+            }
+        }};
+
+    auto torn = std::size_t{0};
+    for (auto n = 0; n < 1'000'000; ++n)
+    {
+        mxlGrainInfo info;
+        loadGrainInfo(*header, info);
+
+        auto const expected = makeInfo(info.index);
+        if ((info.flags != expected.flags) || (info.grainSize != expected.grainSize) || (info.totalSlices != expected.totalSlices) ||
+            (info.validSlices != expected.validSlices))
+        {
+            ++torn;
+        }
+    }
+
+    stop = true;
+    writer.join();
+
+    REQUIRE(torn == 0);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Flow waiters", "[flow manager]")
+{
+    auto const videoDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const videoId = *uuids::uuid::from_string("0b5a3f4e-6c2d-4e8a-9f1b-2d7c8e9a0b1c");
+    auto const audioDef = mxl::tests::readFile("data/audio_flow.json");
+    auto const audioId = *uuids::uuid::from_string("7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b190");
+    auto const grainRate = mxlRational{60000, 1001};
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{5120, 0, 0, 0};
+
+    auto manager = std::make_shared<FlowManager>(domain);
+    auto [videoCreated, videoData] = manager->createOrOpenDiscreteFlow(videoId,
+        videoDef,
+        MXL_DATA_FORMAT_VIDEO,
+        5,
+        grainRate,
+        5120 * 1080,
+        1080,
+        sliceSizes,
+        1,
+        1,
+        DiscreteFlowLayout::PerGrainFiles,
+        false,
+        false,
+        false,
+        true);
+    REQUIRE(videoCreated);
+    REQUIRE(videoData->flowInfo()->version == FLOW_DATA_VERSION_WAITERS);
+    auto [audioCreated, audioData] = manager->createOrOpenContinuousFlow(audioId,
+        audioDef,
+        MXL_DATA_FORMAT_AUDIO,
+        mxlRational{48000, 1},
+        2,
+        sizeof(float),
+        4096,
+        1,
+        1,
+        ContinuousFlowLayout::Planar,
+        ChannelMapping::Linear,
+        true);
+    REQUIRE(audioCreated);
+    REQUIRE(audioData->flowInfo()->version == FLOW_DATA_VERSION_WAITERS);
+
+    // Both kinds of flows provide a waiters segment if asked to, which readers can map as well.
+    REQUIRE(is_regular_file(makeFlowWaitersFilePath(domain, to_string(videoId))));
+    REQUIRE(is_regular_file(makeFlowWaitersFilePath(domain, to_string(audioId))));
+    REQUIRE(audioData->flowWaiters() != nullptr);
+    auto const readerData = manager->openFlow(videoId, AccessMode::READ_ONLY);
+    auto const waiters = readerData->flowWaiters();
+    REQUIRE(waiters != nullptr);
+
+    SECTION("Grain waiters are only woken once their condition is satisfied")
+    {
+        auto const fullGrain = GrainWaiter{*waiters, 10U, MXL_GRAIN_VALID_SLICES_ALL};
+        auto const halfGrain = GrainWaiter{*waiters, 10U, 540U};
+        auto const nextGrain = GrainWaiter{*waiters, 11U, 1U};
+        REQUIRE(fullGrain.isRegistered());
+        REQUIRE(halfGrain.isRegistered());
+        REQUIRE(nextGrain.isRegistered());
+
+        auto info = mxlGrainInfo{};
+        info.index = 10U;
+        info.totalSlices = 1080U;
+        info.validSlices = 100U;
+        REQUIRE(wakeGrainWaiters(*videoData->flowWaiters(), 10U, info) == 0U);
+
+        info.validSlices = 540U;
+        REQUIRE(wakeGrainWaiters(*videoData->flowWaiters(), 10U, info) == 1U);
+
+        info.validSlices = 1080U;
+        REQUIRE(wakeGrainWaiters(*videoData->flowWaiters(), 10U, info) == 2U);
+
+        info.index = 11U;
+        info.validSlices = 0U;
+        info.flags = MXL_GRAIN_FLAG_INVALID;
+        REQUIRE(wakeGrainWaiters(*videoData->flowWaiters(), 11U, info) == 3U);
+    }
+
+    SECTION("Released grain waiters are not woken")
+    {
+        {
+            auto const waiter = GrainWaiter{*waiters, 10U, 1U};
+            REQUIRE(waiter.isRegistered());
+        }
+
+        auto info = mxlGrainInfo{};
+        info.index = 10U;
+        info.totalSlices = 1080U;
+        info.validSlices = 1080U;
+        REQUIRE(wakeGrainWaiters(*videoData->flowWaiters(), 10U, info) == 0U);
+    }
+
+    SECTION("Waking readers sleeping on the sync counter is skipped if none announced itself")
+    {
+        auto const& state = *videoData->flowState();
+        REQUIRE_FALSE(wakeSyncWaiters(state, videoData->flowWaiters()));
+        REQUIRE(wakeSyncWaiters(state, nullptr));
+
+        ++waiters->syncWaiters;
+        REQUIRE(wakeSyncWaiters(state, videoData->flowWaiters()));
+        --waiters->syncWaiters;
+    }
+
+    SECTION("Writers notice readers that can not announce themselves")
+    {
+        // Readers that mapped the segment writable never have to check the sync counter on their own.
+        REQUIRE(readerData->unannouncedUntil() == Timepoint{});
+
+        auto const waitersPath = makeFlowWaitersFilePath(domain, to_string(videoId)).string();
+        auto probe = UnannouncedReaderProbe{waitersPath.c_str()};
+        auto now = currentTime(Clock::TAI);
+        REQUIRE_FALSE(probe.arePresent(now));
+        REQUIRE(videoData->announcedFlowWaiters(now) == videoData->flowWaiters());
+
+        {
+            auto const lock = UnannouncedReaderLock{waitersPath.c_str()};
+            REQUIRE(lock.isLocked());
+            REQUIRE(lock.noticedBy() > currentTime(Clock::Realtime));
+
+            // The lock is only probed once per check interval.
+            REQUIRE_FALSE(probe.arePresent(now));
+            now = now + UNANNOUNCED_READER_CHECK_INTERVAL;
+            REQUIRE(probe.arePresent(now));
+            REQUIRE(videoData->announcedFlowWaiters(now) == nullptr);
+        }
+
+        now = now + UNANNOUNCED_READER_CHECK_INTERVAL;
+        REQUIRE_FALSE(probe.arePresent(now));
+        REQUIRE(videoData->announcedFlowWaiters(now) == videoData->flowWaiters());
+    }
+
+    REQUIRE(manager->deleteFlow(videoId));
+    REQUIRE(manager->deleteFlow(audioId));
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : No flow waiters on legacy flows", "[flow manager]")
+{
+    auto const flowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const flowId = *uuids::uuid::from_string("5c0e9d8a-2b7f-4a31-8e6d-0f9a1b2c3d4e");
+    auto const grainRate = mxlRational{60000, 1001};
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{5120, 0, 0, 0};
+
+    auto manager = std::make_shared<FlowManager>(domain);
+
+    SECTION("Flows are accessible to older SDK versions by default")
+    {
+        auto [created, flowData] =
+            manager->createOrOpenDiscreteFlow(flowId, flowDef, MXL_DATA_FORMAT_VIDEO, 5, grainRate, 5120 * 1080, 1080, sliceSizes);
+        REQUIRE(created);
+        REQUIRE(flowData->flowInfo()->version == FLOW_DATA_VERSION);
+        REQUIRE(flowData->flowWaiters() == nullptr);
+        REQUIRE_FALSE(exists(makeFlowWaitersFilePath(domain, to_string(flowId))));
+
+        REQUIRE(manager->deleteFlow(flowId));
+    }
+
+    auto [created, flowData] = manager->createOrOpenDiscreteFlow(flowId,
+        flowDef,
+        MXL_DATA_FORMAT_VIDEO,
+        5,
+        grainRate,
+        5120 * 1080,
+        1080,
+        sliceSizes,
+        1,
+        1,
+        DiscreteFlowLayout::PerGrainFiles,
+        false,
+        false,
+        false,
+        true);
+    REQUIRE(created);
+    REQUIRE(flowData->flowWaiters() != nullptr);
+
+    // Pretend that the flow was created by an SDK version that only knows about FLOW_DATA_VERSION. Readers and writers of such
+    // flows must not rely on the waiters segment, because their peers may neither register nor wake any waiters.
+    flowData->flowInfo()->version = FLOW_DATA_VERSION;
+    auto const readerData = manager->openFlow(flowId, AccessMode::READ_ONLY);
+    REQUIRE(readerData->flowWaiters() == nullptr);
+    REQUIRE(readerData->unannouncedUntil() == Timepoint{});
+    auto const writerData = manager->openFlow(flowId, AccessMode::READ_WRITE);
+    REQUIRE(writerData->flowWaiters() == nullptr);
+
+    REQUIRE(manager->deleteFlow(flowId));
+}
@@ -1,15 +1,24 @@
 // SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <catch2/catch_test_macros.hpp>
 #include "mxl-internal/DomainWatcher.hpp"
 #include "mxl-internal/Instance.hpp"
 #include "mxl-internal/PathUtils.hpp"
 #include "mxl-internal/PosixFlowIoFactory.hpp"
+#include "mxl-internal/Timing.hpp"
+#include "mxl-internal/detail/ClockHelpers.hpp"
 #include "../../tests/Utils.hpp"
 
 using namespace mxl::lib;
@@ -88,3 +97,64 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Options : invalid co
 
     REQUIRE(instance->getHistoryDurationNs() == 200'000'000ULL); // default value
 }
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Options : TAI clock source", "[options]")
+{
+    auto const createInstance = [&](std::string const& name)
+    {
+        auto domainWatcher = std::make_shared<DomainWatcher>(domain);
+        auto flowIoFactory = std::make_unique<mxl::lib::PosixFlowIoFactory>(domainWatcher);
+        auto const options = std::string{R"({"urn:x-mxl:option:tai_clock_source/v1.0": ")"} + name + R"("})";
+        return std::make_shared<Instance>(domain, options, std::move(flowIoFactory), domainWatcher);
+    };
+
+    auto const kernelTaiTime = []()
+    {
+        std::timespec ts;
+        return (::clock_gettime(detail::clockToId(Clock::TAI), &ts) == 0) ? asTimepoint(ts) + detail::getClockOffset(Clock::TAI) : Timepoint{};
+    };
+
+    // Unknown sources are ignored and don't count as a selection.
+    createInstance("sundial");
+    REQUIRE(getTaiClockSource() == TaiClockSource::Kernel);
+
+    // Read the time while the source is selected, which must not mix up the clock and offset of different sources. The
+    // tolerance is generous, because the thread may be preempted between reading the clocks.
+    auto done = std::atomic<bool>{false};
+    auto maxError = std::atomic<std::int64_t>{0};
+    auto reader = std::thread{[&]()
+        {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                auto const before = kernelTaiTime();
+                auto const time = currentTime(Clock::TAI);
+                auto const after = kernelTaiTime();
+                auto const error = std::max((before - time).value, (time - after).value);
+                if (error > maxError.load(std::memory_order_relaxed))
+                {
+                    maxError.store(error, std::memory_order_relaxed);
+                }
+            }
+        }};
+
+    // The source is only put into effect if it tracks the kernel TAI clock closely enough, which a loaded or virtualized host
+    // may fail to confirm. The kernel TAI clock is kept in that case.
+    auto const instance = createInstance("monotonic");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    done = true;
+    reader.join();
+    REQUIRE(maxError.load() <= fromMilliSeconds(10.0).value);
+
+    if (getTaiClockSource() == TaiClockSource::Monotonic)
+    {
+        // The source can only be selected once per process, later requests for a different source are rejected.
+        auto const other = createInstance("realtime");
+        REQUIRE(getTaiClockSource() == TaiClockSource::Monotonic);
+        REQUIRE(setTaiClockSource(TaiClockSource::Kernel) == TaiClockSourceStatus::Conflicting);
+        REQUIRE(setTaiClockSource(TaiClockSource::Monotonic) == TaiClockSourceStatus::Selected);
+    }
+    else
+    {
+        REQUIRE(getTaiClockSource() == TaiClockSource::Kernel);
+    }
+}
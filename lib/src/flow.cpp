@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <uuid.h>
 #include <sys/file.h>
@@ -12,6 +13,7 @@
 #include "mxl-internal/Instance.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/SampleConversion.hpp"
 
 namespace
 {
@@ -19,6 +21,88 @@ namespace
     {
         return currentTime(mxl::lib::Clock::Realtime) + mxl::lib::Duration{static_cast<std::int64_t>(timeoutNs)};
     }
+
+    /**
+     * Narrow slices that cover all channels of a continuous flow down to the
+     * specified range of channels.
+     * \return false if the range is empty or exceeds the channels covered by
+     *      the slices, in which case the slices are left untouched.
+     */
+    bool selectChannels(mxlStridedWrappedMultiBufferSlice& slices, std::size_t firstChannel, std::size_t channelCount) noexcept
+    {
+        if ((channelCount == 0U) || (firstChannel >= slices.count) || (channelCount > (slices.count - firstChannel)))
+        {
+            return false;
+        }
+
+        auto const offset = firstChannel * slices.stride;
+        for (auto& fragment : slices.base.fragments)
+        {
+            fragment.pointer = static_cast<std::uint8_t const*>(fragment.pointer) + offset;
+        }
+        slices.count = channelCount;
+        return true;
+    }
+
+    /** Drop the element stride of slices of a flow with planar layout, in which it always equals the word size. */
+    mxlWrappedMultiBufferSlice toPlanarSlices(mxlStridedWrappedMultiBufferSlice const& slices) noexcept
+    {
+        return {slices.base, slices.stride, slices.count};
+    }
+
+    mxlMutableWrappedMultiBufferSlice toPlanarSlices(mxlMutableStridedWrappedMultiBufferSlice const& slices) noexcept
+    {
+        return {slices.base, slices.stride, slices.count};
+    }
+
+    /** Size in bytes of a single sample stored in a continuous flow with the specified layout. */
+    template<typename Slices>
+    std::size_t getWordSize(mxl::lib::ContinuousFlowLayout layout, Slices const& slices) noexcept
+    {
+        return (layout == mxl::lib::ContinuousFlowLayout::Interleaved) ? slices.stride : slices.elementStride;
+    }
+
+    mxlStatus copySamplesInterleaved(mxlFlowReader reader, std::uint64_t index, std::size_t count, std::size_t firstChannel,
+        std::optional<std::size_t> channelCount, std::uint64_t timeoutNs, mxlSampleFormat format, std::uint32_t flags, void* buffer,
+        std::size_t bufferSize)
+    {
+        using namespace mxl::lib;
+
+        if ((buffer != nullptr) && (getSampleFormatSize(format, sizeof(float)) != 0U))
+        {
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
+            {
+                auto slices = mxlStridedWrappedMultiBufferSlice{};
+                if (auto const status = cppReader->getSamples(index, count, toDeadline(timeoutNs), slices); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+                if (!selectChannels(slices, firstChannel, channelCount.value_or(slices.count)))
+                {
+                    return MXL_ERR_INVALID_ARG;
+                }
+                if (count == 0U)
+                {
+                    return MXL_STATUS_OK;
+                }
+
+                auto const wordSize = getWordSize(cppReader->getLayout(), slices);
+                auto const sampleSize = getSampleFormatSize(format, wordSize);
+                if ((sampleSize == 0U) || (bufferSize < (count * slices.count * sampleSize)))
+                {
+                    return MXL_ERR_INVALID_ARG;
+                }
+
+                interleaveSamples(slices, wordSize, format, flags, index, buffer);
+
+                // The writer may have started to overwrite the oldest samples while we copied them, in which case the copy is torn.
+                return cppReader->getSamples(index, count, slices);
+            }
+
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
 }
 
 using namespace mxl::lib;
@@ -133,7 +217,7 @@ mxlStatus mxlGetFlowDef(mxlInstance instance, char const* flowId, char* buffer,
 
 extern "C"
 MXL_EXPORT
-mxlStatus mxlCreateFlowReader(mxlInstance instance, char const* flowId, char const* /*options*/, mxlFlowReader* reader)
+mxlStatus mxlCreateFlowReader(mxlInstance instance, char const* flowId, char const* options, mxlFlowReader* reader)
 {
     try
     {
@@ -143,7 +227,8 @@ mxlStatus mxlCreateFlowReader(mxlInstance instance, char const* flowId, char con
             {
                 if ((flowId != nullptr) && uuids::uuid::is_valid_uuid(flowId))
                 {
-                    *reader = reinterpret_cast<mxlFlowReader>(cppInstance->getFlowReader(flowId));
+                    *reader = reinterpret_cast<mxlFlowReader>(
+                        cppInstance->getFlowReader(flowId, (options == nullptr) ? std::nullopt : std::make_optional(options)));
                     return MXL_STATUS_OK;
                 }
             }
@@ -161,6 +246,11 @@ mxlStatus mxlCreateFlowReader(mxlInstance instance, char const* flowId, char con
         MXL_ERROR("Failed to create flow reader: {}", e.what());
         return MXL_ERR_UNKNOWN;
     }
+    catch (std::invalid_argument const& e)
+    {
+        MXL_ERROR("Failed to create flow reader: {}", e.what());
+        return MXL_ERR_INVALID_ARG;
+    }
     catch (...)
     {
         return MXL_ERR_UNKNOWN;
@@ -239,6 +329,11 @@ mxlStatus mxlCreateFlowWriter(mxlInstance instance, char const* flowDef, char co
             return MXL_ERR_UNKNOWN;
         }
     }
+    catch (std::invalid_argument const& e)
+    {
+        MXL_ERROR("Failed to create flow writer: {}", e.what());
+        return MXL_ERR_INVALID_ARG;
+    }
     catch (std::exception const& e)
     {
         MXL_ERROR("Failed to create flow : {}", e.what());
@@ -368,7 +463,7 @@ mxlStatus mxlFlowReaderGetGrainSlice(mxlFlowReader reader, uint64_t index, uint1
     {
         if ((grainInfo != nullptr) && (payload != nullptr))
         {
-            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
             {
                 return cppReader->getGrain(index, minValidSlices, toDeadline(timeoutNs), grainInfo, payload);
             }
@@ -398,7 +493,7 @@ mxlStatus mxlFlowReaderGetGrainSliceNonBlocking(mxlFlowReader reader, uint64_t i
     {
         if ((grainInfo != nullptr) && (payload != nullptr))
         {
-            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
             {
                 return cppReader->getGrain(index, minValidSlices, grainInfo, payload);
             }
@@ -412,6 +507,134 @@ mxlStatus mxlFlowReaderGetGrainSliceNonBlocking(mxlFlowReader reader, uint64_t i
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetWaitStatistics(mxlFlowReader reader, mxlFlowReaderWaitStatistics* statistics)
+{
+    try
+    {
+        if (statistics != nullptr)
+        {
+            if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
+            {
+                auto const stats = cppReader->getWaitStatistics();
+                statistics->waits = stats.waits;
+                statistics->spinWakeups = stats.spinWakeups;
+                statistics->futexWakeups = stats.futexWakeups;
+                statistics->timeouts = stats.timeouts;
+                statistics->latencySamples = stats.latencySamples;
+                statistics->totalWakeupLatency = stats.totalWakeupLatency;
+                statistics->maxWakeupLatency = stats.maxWakeupLatency;
+                statistics->wastedWakeups = stats.wastedWakeups;
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetGrainRange(mxlFlowReader reader, uint64_t firstIndex, size_t count, uint64_t timeoutNs, mxlGrainInfo* grains,
+    uint8_t** payloads, size_t* availableCount)
+{
+    try
+    {
+        if (availableCount != nullptr)
+        {
+            *availableCount = 0U;
+            if ((count != 0U) && (grains != nullptr) && (payloads != nullptr))
+            {
+                if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
+                {
+                    return cppReader->getGrainRange(firstIndex, count, toDeadline(timeoutNs), grains, payloads, availableCount);
+                }
+                return MXL_ERR_INVALID_FLOW_READER;
+            }
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetGrainInfoLite(mxlFlowReader reader, uint64_t index, mxlGrainInfoLite* grainInfo)
+{
+    try
+    {
+        if (grainInfo != nullptr)
+        {
+            if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
+            {
+                return cppReader->getGrainInfoLite(index, grainInfo);
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderIsHugePageBacked(mxlFlowReader reader, bool* isHugePageBacked)
+{
+    try
+    {
+        if (isHugePageBacked != nullptr)
+        {
+            if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
+            {
+                *isHugePageBacked = cppReader->isHugePageBacked();
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetWaitHandle(mxlInstance instance, mxlFlowReader reader, uint64_t index, uint16_t minValidSlices, int* fd)
+{
+    try
+    {
+        auto const cppInstance = to_Instance(instance);
+        auto const cppReader = to_FlowReader(reader);
+        if ((cppInstance != nullptr) && (cppReader != nullptr) && (fd != nullptr))
+        {
+            *fd = cppInstance->getWaitHandle(*cppReader, index, minValidSlices);
+            return MXL_STATUS_OK;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (std::invalid_argument const&)
+    {
+        return MXL_ERR_INVALID_FLOW_READER;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlFlowWriterGetGrainInfo(mxlFlowWriter writer, uint64_t index, mxlGrainInfo* grainInfo)
@@ -420,7 +643,7 @@ mxlStatus mxlFlowWriterGetGrainInfo(mxlFlowWriter writer, uint64_t index, mxlGra
     {
         if (grainInfo != nullptr)
         {
-            if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            if (auto const cppWriter = to_DiscreteFlowWriter(writer); cppWriter != nullptr)
             {
                 *grainInfo = cppWriter->getGrainInfo(index);
                 return MXL_STATUS_OK;
@@ -444,7 +667,7 @@ mxlStatus mxlFlowWriterOpenGrain(mxlFlowWriter writer, uint64_t index, mxlGrainI
     {
         if ((grainInfo != nullptr) && (payload != nullptr))
         {
-            if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            if (auto const cppWriter = to_DiscreteFlowWriter(writer); cppWriter != nullptr)
             {
                 return cppWriter->openGrain(index, grainInfo, payload);
             }
@@ -465,7 +688,7 @@ mxlStatus mxlFlowWriterCancelGrain(mxlFlowWriter writer)
 {
     try
     {
-        if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+        if (auto const cppWriter = to_DiscreteFlowWriter(writer); cppWriter != nullptr)
         {
             return cppWriter->cancel();
         }
@@ -488,7 +711,7 @@ mxlStatus mxlFlowWriterCommitGrain(mxlFlowWriter writer, mxlGrainInfo const* gra
 
     try
     {
-        if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+        if (auto const cppWriter = to_DiscreteFlowWriter(writer); cppWriter != nullptr)
         {
             return cppWriter->commit(*grainInfo);
         }
@@ -508,7 +731,7 @@ mxlStatus mxlFlowReaderGetMaxReadLengthSamples(mxlFlowReader reader, size_t* max
     {
         if (maxReadLength != nullptr)
         {
-            if (auto const cppReader = dynamic_cast<ContinuousFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
             {
                 *maxReadLength = cppReader->getMaxReadLength();
                 return MXL_STATUS_OK;
@@ -533,9 +756,20 @@ mxlStatus mxlFlowReaderGetSamples(mxlFlowReader reader, uint64_t index, size_t c
     {
         if (payloadBuffersSlices != nullptr)
         {
-            if (auto const cppReader = dynamic_cast<ContinuousFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
             {
-                return cppReader->getSamples(index, count, toDeadline(timeoutNs), *payloadBuffersSlices);
+                if (cppReader->getLayout() != ContinuousFlowLayout::Planar)
+                {
+                    return MXL_ERR_UNSUPPORTED_OPERATION;
+                }
+
+                auto slices = mxlStridedWrappedMultiBufferSlice{};
+                auto const status = cppReader->getSamples(index, count, toDeadline(timeoutNs), slices);
+                if (status == MXL_STATUS_OK)
+                {
+                    *payloadBuffersSlices = toPlanarSlices(slices);
+                }
+                return status;
             }
 
             return MXL_ERR_INVALID_FLOW_READER;
@@ -556,7 +790,66 @@ mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t inde
     {
         if (payloadBuffersSlices != nullptr)
         {
-            if (auto const cppReader = dynamic_cast<ContinuousFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
+            {
+                if (cppReader->getLayout() != ContinuousFlowLayout::Planar)
+                {
+                    return MXL_ERR_UNSUPPORTED_OPERATION;
+                }
+
+                auto slices = mxlStridedWrappedMultiBufferSlice{};
+                auto const status = cppReader->getSamples(index, count, slices);
+                if (status == MXL_STATUS_OK)
+                {
+                    *payloadBuffersSlices = toPlanarSlices(slices);
+                }
+                return status;
+            }
+
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetSamplesStrided(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs,
+    mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices)
+{
+    try
+    {
+        if (payloadBuffersSlices != nullptr)
+        {
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
+            {
+                return cppReader->getSamples(index, count, toDeadline(timeoutNs), *payloadBuffersSlices);
+            }
+
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetSamplesStridedNonBlocking(mxlFlowReader reader, uint64_t index, size_t count,
+    mxlStridedWrappedMultiBufferSlice* payloadBuffersSlices)
+{
+    try
+    {
+        if (payloadBuffersSlices != nullptr)
+        {
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
             {
                 return cppReader->getSamples(index, count, *payloadBuffersSlices);
             }
@@ -571,6 +864,116 @@ mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t inde
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetChannelSamples(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel, size_t channelCount,
+    uint64_t timeoutNs, mxlWrappedMultiBufferSlice* payloadBuffersSlices)
+{
+    try
+    {
+        if (payloadBuffersSlices != nullptr)
+        {
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
+            {
+                if (cppReader->getLayout() != ContinuousFlowLayout::Planar)
+                {
+                    return MXL_ERR_UNSUPPORTED_OPERATION;
+                }
+
+                auto slices = mxlStridedWrappedMultiBufferSlice{};
+                if (auto const status = cppReader->getSamples(index, count, toDeadline(timeoutNs), slices); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+                if (!selectChannels(slices, firstChannel, channelCount))
+                {
+                    return MXL_ERR_INVALID_ARG;
+                }
+
+                *payloadBuffersSlices = toPlanarSlices(slices);
+                return MXL_STATUS_OK;
+            }
+
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetChannelSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel, size_t channelCount,
+    mxlWrappedMultiBufferSlice* payloadBuffersSlices)
+{
+    try
+    {
+        if (payloadBuffersSlices != nullptr)
+        {
+            if (auto const cppReader = to_ContinuousFlowReader(reader); cppReader != nullptr)
+            {
+                if (cppReader->getLayout() != ContinuousFlowLayout::Planar)
+                {
+                    return MXL_ERR_UNSUPPORTED_OPERATION;
+                }
+
+                auto slices = mxlStridedWrappedMultiBufferSlice{};
+                if (auto const status = cppReader->getSamples(index, count, slices); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+                if (!selectChannels(slices, firstChannel, channelCount))
+                {
+                    return MXL_ERR_INVALID_ARG;
+                }
+
+                *payloadBuffersSlices = toPlanarSlices(slices);
+                return MXL_STATUS_OK;
+            }
+
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderCopySamplesInterleaved(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs, mxlSampleFormat format,
+    uint32_t flags, void* buffer, size_t bufferSize)
+{
+    try
+    {
+        return copySamplesInterleaved(reader, index, count, 0U, std::nullopt, timeoutNs, format, flags, buffer, bufferSize);
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderCopyChannelSamplesInterleaved(mxlFlowReader reader, uint64_t index, size_t count, size_t firstChannel, size_t channelCount,
+    uint64_t timeoutNs, mxlSampleFormat format, uint32_t flags, void* buffer, size_t bufferSize)
+{
+    try
+    {
+        return copySamplesInterleaved(reader, index, count, firstChannel, channelCount, timeoutNs, format, flags, buffer, bufferSize);
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlFlowWriterGetMaxWriteLengthSamples(mxlFlowWriter writer, size_t* maxWriteLength)
@@ -579,7 +982,7 @@ mxlStatus mxlFlowWriterGetMaxWriteLengthSamples(mxlFlowWriter writer, size_t* ma
     {
         if (maxWriteLength != nullptr)
         {
-            if (auto const cppWriter = dynamic_cast<ContinuousFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
             {
                 *maxWriteLength = cppWriter->getMaxWriteLength();
                 return MXL_STATUS_OK;
@@ -603,7 +1006,42 @@ mxlStatus mxlFlowWriterOpenSamples(mxlFlowWriter writer, uint64_t index, size_t
     {
         if (payloadBuffersSlices != nullptr)
         {
-            if (auto const cppWriter = dynamic_cast<ContinuousFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
+            {
+                if (cppWriter->getLayout() != ContinuousFlowLayout::Planar)
+                {
+                    return MXL_ERR_UNSUPPORTED_OPERATION;
+                }
+
+                auto slices = mxlMutableStridedWrappedMultiBufferSlice{};
+                auto const status = cppWriter->openSamples(index, count, slices);
+                if (status == MXL_STATUS_OK)
+                {
+                    *payloadBuffersSlices = toPlanarSlices(slices);
+                }
+                return status;
+            }
+
+            return MXL_ERR_INVALID_FLOW_WRITER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowWriterOpenSamplesStrided(mxlFlowWriter writer, uint64_t index, size_t count,
+    mxlMutableStridedWrappedMultiBufferSlice* payloadBuffersSlices)
+{
+    try
+    {
+        if (payloadBuffersSlices != nullptr)
+        {
+            if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
             {
                 return cppWriter->openSamples(index, count, *payloadBuffersSlices);
             }
@@ -624,7 +1062,7 @@ mxlStatus mxlFlowWriterCancelSamples(mxlFlowWriter writer)
 {
     try
     {
-        if (auto const cppWriter = dynamic_cast<ContinuousFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+        if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
         {
             return cppWriter->cancel();
         }
@@ -642,7 +1080,7 @@ mxlStatus mxlFlowWriterCommitSamples(mxlFlowWriter writer)
 {
     try
     {
-        if (auto const cppWriter = dynamic_cast<ContinuousFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+        if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
         {
             return cppWriter->commit();
         }
@@ -654,6 +1092,45 @@ mxlStatus mxlFlowWriterCommitSamples(mxlFlowWriter writer)
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowWriterWriteSamplesInterleaved(mxlFlowWriter writer, uint64_t index, size_t count, mxlSampleFormat format, void const* buffer,
+    size_t bufferSize)
+{
+    try
+    {
+        if ((buffer != nullptr) && (count != 0U) && (getSampleFormatSize(format, sizeof(float)) != 0U))
+        {
+            if (auto const cppWriter = to_ContinuousFlowWriter(writer); cppWriter != nullptr)
+            {
+                auto slices = mxlMutableStridedWrappedMultiBufferSlice{};
+                if (auto const status = cppWriter->openSamples(index, count, slices); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+
+                auto const wordSize = getWordSize(cppWriter->getLayout(), slices);
+                auto const sampleSize = getSampleFormatSize(format, wordSize);
+                if ((sampleSize == 0U) || (bufferSize < (count * slices.count * sampleSize)))
+                {
+                    (void)cppWriter->cancel();
+                    return MXL_ERR_INVALID_ARG;
+                }
+
+                deinterleaveSamples(buffer, format, wordSize, slices);
+                return cppWriter->commit();
+            }
+
+            return MXL_ERR_INVALID_FLOW_WRITER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlCreateFlowSynchronizationGroup(mxlInstance instance, mxlFlowSynchronizationGroup* group)
@@ -705,18 +1182,15 @@ mxlStatus mxlFlowSynchronizationGroupAddReader(mxlFlowSynchronizationGroup group
     {
         if (auto const cppGroup = to_FlowSynchronizationGroup(group); cppGroup != nullptr)
         {
-            if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
+            if (auto const discreteReader = to_DiscreteFlowReader(reader); discreteReader != nullptr)
             {
-                if (auto const discreteReader = dynamic_cast<DiscreteFlowReader const*>(cppReader); discreteReader != nullptr)
-                {
-                    cppGroup->addReader(*discreteReader, MXL_GRAIN_VALID_SLICES_ALL);
-                    return MXL_STATUS_OK;
-                }
-                if (auto const continuousReader = dynamic_cast<ContinuousFlowReader const*>(cppReader); continuousReader != nullptr)
-                {
-                    cppGroup->addReader(*continuousReader);
-                    return MXL_STATUS_OK;
-                }
+                cppGroup->addReader(*discreteReader, MXL_GRAIN_VALID_SLICES_ALL);
+                return MXL_STATUS_OK;
+            }
+            if (auto const continuousReader = to_ContinuousFlowReader(reader); continuousReader != nullptr)
+            {
+                cppGroup->addReader(*continuousReader);
+                return MXL_STATUS_OK;
             }
 
             return MXL_ERR_INVALID_FLOW_READER;
@@ -738,7 +1212,7 @@ mxlStatus mxlFlowSynchronizationGroupAddPartialGrainReader(mxlFlowSynchronizatio
     {
         if (auto const cppGroup = to_FlowSynchronizationGroup(group); cppGroup != nullptr)
         {
-            if (auto const cppReader = dynamic_cast<DiscreteFlowReader const*>(to_FlowReader(reader)); cppReader != nullptr)
+            if (auto const cppReader = to_DiscreteFlowReader(reader); cppReader != nullptr)
             {
                 cppGroup->addReader(*cppReader, minValidSlices);
                 return MXL_STATUS_OK;
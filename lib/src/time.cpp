@@ -2,10 +2,30 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl/time.h"
+#include <algorithm>
+#include <new>
+#include <span>
 #include "mxl-internal/IndexConversion.hpp"
 #include "mxl-internal/Thread.hpp"
 #include "mxl-internal/Timing.hpp"
 
+namespace
+{
+    static_assert(sizeof(mxl::lib::RateConverter) <= sizeof(mxlRateConverter::opaque), "mxlRateConverter is too small for the converter state.");
+    static_assert(alignof(mxl::lib::RateConverter) <= alignof(mxlRateConverter), "mxlRateConverter is underaligned for the converter state.");
+
+    mxl::lib::RateConverter const& toRateConverter(mxlRateConverter const* converter) noexcept
+    {
+        return *std::launder(reinterpret_cast<mxl::lib::RateConverter const*>(converter->opaque));
+    }
+
+    /** Maps the result of an index to timestamp conversion to the convention of the C API. */
+    constexpr std::uint64_t toTimestampResult(mxl::lib::Timepoint result, std::uint64_t index) noexcept
+    {
+        return (result || (index == 0)) ? result.value : MXL_UNDEFINED_INDEX;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 uint64_t mxlGetTime()
@@ -39,8 +59,7 @@ uint64_t mxlIndexToTimestamp(mxlRational const* editRate, uint64_t index)
 {
     if (editRate != nullptr)
     {
-        auto const res = mxl::lib::indexToTimestamp(*editRate, index);
-        return (res || (index == 0)) ? res.value : MXL_UNDEFINED_INDEX;
+        return toTimestampResult(mxl::lib::indexToTimestamp(*editRate, index), index);
     }
     return MXL_UNDEFINED_INDEX;
 }
@@ -60,6 +79,75 @@ uint64_t mxlGetNsUntilIndex(uint64_t index, mxlRational const* editRate)
     return ((nowNs != 0ULL) && (targetNs >= nowNs)) ? targetNs - nowNs : 0ULL;
 }
 
+extern "C"
+MXL_EXPORT
+void mxlRateConverterInit(mxlRateConverter* converter, mxlRational const* editRate)
+{
+    if (converter != nullptr)
+    {
+        new (converter->opaque) mxl::lib::RateConverter{(editRate != nullptr) ? mxl::lib::RateConverter{*editRate} : mxl::lib::RateConverter{}};
+    }
+}
+
+extern "C"
+MXL_EXPORT
+uint64_t mxlRateConverterTimestampToIndex(mxlRateConverter const* converter, uint64_t timestamp)
+{
+    return (converter != nullptr) ? toRateConverter(converter).timestampToIndex(mxl::lib::Timepoint(timestamp)) : MXL_UNDEFINED_INDEX;
+}
+
+extern "C"
+MXL_EXPORT
+uint64_t mxlRateConverterIndexToTimestamp(mxlRateConverter const* converter, uint64_t index)
+{
+    return (converter != nullptr) ? toTimestampResult(toRateConverter(converter).indexToTimestamp(index), index) : MXL_UNDEFINED_INDEX;
+}
+
+extern "C"
+MXL_EXPORT
+void mxlRateConverterTimestampsToIndices(mxlRateConverter const* converter, uint64_t const* timestamps, uint64_t* indices, size_t count)
+{
+    if ((timestamps == nullptr) || (indices == nullptr))
+    {
+        return;
+    }
+
+    if (converter != nullptr)
+    {
+        toRateConverter(converter).timestampsToIndices(std::span{timestamps, count}, std::span{indices, count});
+    }
+    else
+    {
+        std::fill_n(indices, count, MXL_UNDEFINED_INDEX);
+    }
+}
+
+extern "C"
+MXL_EXPORT
+void mxlRateConverterIndicesToTimestamps(mxlRateConverter const* converter, uint64_t const* indices, uint64_t* timestamps, size_t count)
+{
+    if ((indices == nullptr) || (timestamps == nullptr))
+    {
+        return;
+    }
+
+    if (converter != nullptr)
+    {
+        // Converted one by one rather than through RateConverter::indicesToTimestamps(), as the mapping of invalid
+        // results needs the original index, which may already be overwritten if both arrays are the same.
+        auto const& rateConverter = toRateConverter(converter);
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            auto const index = indices[i];
+            timestamps[i] = toTimestampResult(rateConverter.indexToTimestamp(index), index);
+        }
+    }
+    else
+    {
+        std::fill_n(timestamps, count, MXL_UNDEFINED_INDEX);
+    }
+}
+
 extern "C"
 MXL_EXPORT
 void mxlSleepForNs(uint64_t ns)
@@ -12,21 +12,26 @@
 #   include <UdpLayer.h>
 #endif
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <thread>
+#include <vector>
 #include <uuid.h>
+#include <poll.h>
 #include <catch2/catch_test_macros.hpp>
 #include <picojson/wrapper.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include <mxl/time.h>
 #include "../internal/include/mxl-internal/MediaUtils.hpp"
+#include "../internal/include/mxl-internal/SharedMemory.hpp"
 
 namespace fs = std::filesystem;
 
@@ -292,6 +297,50 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Invalid
     mxlDestroyInstance(instanceWriter);
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Invalid flow without retirement (discrete)", "[mxl flows]")
+{
+    auto const opts = "{}";
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instanceReader = mxlCreateInstance(domain.string().c_str(), opts);
+    REQUIRE(instanceReader != nullptr);
+
+    auto instanceWriter = mxlCreateInstance(domain.string().c_str(), opts);
+    REQUIRE(instanceWriter != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    bool flowWasCreated = false;
+    REQUIRE(mxlCreateFlowWriter(instanceWriter, flowDef.c_str(), "", &writer, &configInfo, &flowWasCreated) == MXL_STATUS_OK);
+    REQUIRE(flowWasCreated);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instanceReader, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    // Remove the flow behind the back of the writer, like the garbage collector of an older SDK would do after the
+    // writer crashed. The flow is never retired, so the reader has to detect this through the file system.
+    fs::remove_all(domain / (std::string{flowId} + ".mxl-flow"));
+
+    // The reader only checks the file system every once in a while.
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &buffer) == MXL_ERR_FLOW_INVALID);
+
+    REQUIRE(mxlReleaseFlowReader(instanceReader, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instanceWriter, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instanceReader);
+    mxlDestroyInstance(instanceWriter);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Invalid flow definitions", "[mxl flows]")
 {
     // Create the instance
@@ -553,9 +602,195 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Options
     REQUIRE(configInfo.common.maxCommitBatchSizeHint == 1080U);
     REQUIRE(configInfo.common.maxSyncBatchSizeHint == 1080U);
     REQUIRE(mxlReleaseFlowWriter(instanceWriter, writer) == MXL_STATUS_OK);
+
+    optsObj.clear();
+    optsObj["prefault"] = picojson::value{"yes"}; // Invalid value
+    optsStr = picojson::value(optsObj).serialize();
+    REQUIRE(mxlCreateFlowWriter(instanceWriter, flowDef.c_str(), optsStr.c_str(), &writer, &configInfo, nullptr) == MXL_ERR_UNKNOWN);
+
+    optsObj.clear();
+    optsObj["prefault"] = picojson::value{true};
+    optsStr = picojson::value(optsObj).serialize();
+    auto const timeBeforeCreation = mxlGetTime();
+    REQUIRE(mxlCreateFlowWriter(instanceWriter, flowDef.c_str(), optsStr.c_str(), &writer, &configInfo, &flowWasCreated) == MXL_STATUS_OK);
+    REQUIRE(flowWasCreated);
+    REQUIRE(configInfo.common.creationTime >= timeBeforeCreation);
+    REQUIRE(configInfo.common.creationTime <= mxlGetTime());
+    REQUIRE(configInfo.common.creationDuration > 0U);
+    REQUIRE(mxlReleaseFlowWriter(instanceWriter, writer) == MXL_STATUS_OK);
+
     REQUIRE(mxlDestroyInstance(instanceWriter) == MXL_STATUS_OK);
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Reader heartbeats", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    // Enable reader heartbeats for the whole domain.
+    {
+        std::ofstream ofs(domain / "options.json");
+        REQUIRE(ofs.is_open());
+        ofs << R"({"urn:x-mxl:option:reader_heartbeats/v1.0": true})";
+    }
+
+    auto instanceReader = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instanceReader != nullptr);
+
+    auto instanceWriter = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instanceWriter != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    bool flowWasCreated = false;
+    REQUIRE(mxlCreateFlowWriter(instanceWriter, flowDef.c_str(), "", &writer, &configInfo, &flowWasCreated) == MXL_STATUS_OK);
+    REQUIRE(flowWasCreated);
+
+    // The heartbeat segment lives next to the access file in the flow directory.
+    REQUIRE(fs::exists(domain / (std::string{flowId} + ".mxl-flow") / "heartbeats"));
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instanceReader, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    mxlFlowRuntimeInfo runtimeInfo1;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo1) == MXL_STATUS_OK);
+
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+
+    // The writer only aggregates the heartbeats of its readers every once in a while, so make sure
+    // that the next commit picks up the heartbeat of our read.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 1, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    mxlFlowRuntimeInfo runtimeInfo2;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo2) == MXL_STATUS_OK);
+
+    // We accessed the grain using mxlFlowReaderGetGrain. The writer should have picked up our heartbeat.
+    REQUIRE(runtimeInfo2.lastReadTime > runtimeInfo1.lastReadTime);
+    REQUIRE(runtimeInfo2.lastReadTime <= runtimeInfo2.lastWriteTime);
+
+    // The last read time also advances while the writer is idle, as the heartbeats are folded in whenever the info is read.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+
+    mxlFlowRuntimeInfo runtimeInfo3;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo3) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo3.lastWriteTime == runtimeInfo2.lastWriteTime);
+    REQUIRE(runtimeInfo3.lastReadTime > runtimeInfo2.lastReadTime);
+
+    REQUIRE(mxlReleaseFlowReader(instanceReader, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instanceWriter, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instanceReader);
+    mxlDestroyInstance(instanceWriter);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Commit cadence", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    // A single commit is not enough to tell when the next one is due.
+    mxlFlowRuntimeInfo runtimeInfo;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.nextCommitTime == 0);
+    REQUIRE(runtimeInfo.commitInterval == 0);
+
+    for (auto i = 1U; i < 4U; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(mxlFlowWriterOpenGrain(writer, index + i, &gInfo, &buffer) == MXL_STATUS_OK);
+        gInfo.validSlices = gInfo.totalSlices;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    }
+
+    // The writer expects to commit again about one commit interval after the last one.
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.commitInterval >= 10'000'000U);
+    REQUIRE(runtimeInfo.nextCommitTime == runtimeInfo.lastWriteTime + runtimeInfo.commitInterval);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Huge pages", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    {
+        std::ofstream ofs(domain / "options.json");
+        REQUIRE(ofs.is_open());
+        ofs << R"({"urn:x-mxl:option:huge_pages/v1.0": true})";
+    }
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    REQUIRE((configInfo.common.flags & MXL_FLOW_CONFIG_FLAG_HUGE_PAGES) != 0U);
+
+    // The grains are padded to whole huge pages, regardless of whether the file system actually provides them.
+    auto const grainSize = fs::file_size(domain / (std::string{flowId} + ".mxl-flow") / "grains" / "data.0");
+    REQUIRE(grainSize % mxl::lib::hugePageSize() == 0U);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderIsHugePageBacked(reader, nullptr) == MXL_ERR_INVALID_ARG);
+    auto hugePageBacked = false;
+    REQUIRE(mxlFlowReaderIsHugePageBacked(reader, &hugePageBacked) == MXL_STATUS_OK);
+
+    auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    std::memset(buffer, 0x5A, gInfo.grainSize);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 0, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(buffer[0] == 0x5A);
+    REQUIRE(buffer[gInfo.grainSize - 1] == 0x5A);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Slices", "[mxl flows]")
 {
     char const* opts = "{}";
@@ -644,6 +879,260 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Slices"
 
 #endif
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Grain info lite", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfoLite liteInfo;
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index, nullptr) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index, &liteInfo) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+
+    // Partial grains are reported as they are.
+    gInfo.validSlices = 10;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index, &liteInfo) == MXL_STATUS_OK);
+    REQUIRE(liteInfo.index == index);
+    REQUIRE(liteInfo.flags == 0);
+    REQUIRE(liteInfo.grainSize == gInfo.grainSize);
+    REQUIRE(liteInfo.totalSlices == gInfo.totalSlices);
+    REQUIRE(liteInfo.validSlices == 10);
+
+    gInfo.validSlices = gInfo.totalSlices;
+    gInfo.flags |= MXL_GRAIN_FLAG_INVALID;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index, &liteInfo) == MXL_STATUS_OK);
+    REQUIRE(liteInfo.flags == MXL_GRAIN_FLAG_INVALID);
+    REQUIRE(liteInfo.validSlices == gInfo.totalSlices);
+
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index + 1, &liteInfo) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+    REQUIRE(mxlFlowReaderGetGrainInfoLite(reader, index - configInfo.discrete.grainCount, &liteInfo) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Grain range", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+
+    mxlGrainInfo gInfos[4];
+    uint8_t* buffers[4];
+    auto available = std::size_t{42};
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index, 4, 0, gInfos, buffers, nullptr) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index, 0, 0, gInfos, buffers, &available) == MXL_ERR_INVALID_ARG);
+    REQUIRE(available == 0);
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index, 4, 0, gInfos, buffers, &available) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+    REQUIRE(available == 0);
+
+    // Commit three complete grains followed by a partial one.
+    for (auto i = std::uint64_t{0}; i < 4; ++i)
+    {
+        mxlGrainInfo gInfo;
+        uint8_t* buffer = nullptr;
+        REQUIRE(mxlFlowWriterOpenGrain(writer, index + i, &gInfo, &buffer) == MXL_STATUS_OK);
+        buffer[0] = static_cast<uint8_t>(i);
+        gInfo.validSlices = (i < 3) ? gInfo.totalSlices : 10;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    }
+
+    // Only the leading complete grains are returned.
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index, 4, 0, gInfos, buffers, &available) == MXL_STATUS_OK);
+    REQUIRE(available == 3);
+    for (auto i = std::size_t{0}; i < available; ++i)
+    {
+        REQUIRE(gInfos[i].index == index + i);
+        REQUIRE(gInfos[i].validSlices == gInfos[i].totalSlices);
+        REQUIRE(buffers[i][0] == i);
+    }
+
+    // The range is limited by the requested count.
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index + 1, 1, 0, gInfos, buffers, &available) == MXL_STATUS_OK);
+    REQUIRE(available == 1);
+    REQUIRE(gInfos[0].index == index + 1);
+
+    // Waiting only applies to the first grain of the range.
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index + 3, 1, 10'000'000, gInfos, buffers, &available) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+    REQUIRE(available == 0);
+    REQUIRE(mxlFlowReaderGetGrainRange(reader, index - configInfo.discrete.grainCount, 4, 0, gInfos, buffers, &available) ==
+            MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    REQUIRE(available == 0);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Synchronization group : Wait on multiple flows", "[mxl flows][futex]")
+{
+    auto const videoFlowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const audioFlowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter videoWriter;
+    mxlFlowConfigInfo videoConfigInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, videoFlowDef.c_str(), "", &videoWriter, &videoConfigInfo, nullptr) == MXL_STATUS_OK);
+    mxlFlowWriter audioWriter;
+    mxlFlowConfigInfo audioConfigInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, audioFlowDef.c_str(), "", &audioWriter, &audioConfigInfo, nullptr) == MXL_STATUS_OK);
+
+    mxlFlowReader videoReader;
+    REQUIRE(mxlCreateFlowReader(instance, "5fbec3b1-1b0f-417d-9059-8b94a47197ed", "", &videoReader) == MXL_STATUS_OK);
+    mxlFlowReader audioReader;
+    REQUIRE(mxlCreateFlowReader(instance, "b3bb5be7-9fe9-4324-a5bb-4c70e1084449", "", &audioReader) == MXL_STATUS_OK);
+
+    mxlFlowSynchronizationGroup group;
+    REQUIRE(mxlCreateFlowSynchronizationGroup(instance, &group) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowSynchronizationGroupAddReader(group, videoReader) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowSynchronizationGroupAddReader(group, audioReader) == MXL_STATUS_OK);
+
+    auto const videoIndex = mxlGetCurrentIndex(&videoConfigInfo.common.grainRate);
+    auto const timestamp = mxlIndexToTimestamp(&videoConfigInfo.common.grainRate, videoIndex);
+    auto const audioIndex = mxlTimestampToIndex(&audioConfigInfo.common.grainRate, timestamp);
+
+    REQUIRE(mxlFlowSynchronizationGroupWaitForDataAt(group, timestamp, 10'000'000) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    // Provide the data on the flows one after the other, the group must only return once all of them have it.
+    auto videoCommitted = std::atomic<bool>{false};
+    auto writerThread = std::thread{[&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            auto slice = mxlMutableWrappedMultiBufferSlice{};
+            REQUIRE(mxlFlowWriterOpenSamples(audioWriter, audioIndex, 480, &slice) == MXL_STATUS_OK);
+            REQUIRE(mxlFlowWriterCommitSamples(audioWriter) == MXL_STATUS_OK);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            mxlGrainInfo gInfo;
+            uint8_t* buffer = nullptr;
+            REQUIRE(mxlFlowWriterOpenGrain(videoWriter, videoIndex, &gInfo, &buffer) == MXL_STATUS_OK);
+            gInfo.validSlices = gInfo.totalSlices;
+            videoCommitted = true;
+            REQUIRE(mxlFlowWriterCommitGrain(videoWriter, &gInfo) == MXL_STATUS_OK);
+        }};
+
+    auto const status = mxlFlowSynchronizationGroupWaitForDataAt(group, timestamp, 1'000'000'000);
+    writerThread.join();
+    REQUIRE(status == MXL_STATUS_OK);
+    REQUIRE(videoCommitted);
+
+    // Data that is already available doesn't require waiting.
+    REQUIRE(mxlFlowSynchronizationGroupWaitForDataAt(group, timestamp, 0) == MXL_STATUS_OK);
+
+    REQUIRE(mxlReleaseFlowSynchronizationGroup(instance, group) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(instance, audioReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(instance, videoReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, audioWriter) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, videoWriter) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Wait handle", "[mxl flows][futex]")
+{
+    auto const flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, "5fbec3b1-1b0f-417d-9059-8b94a47197ed", "", &reader) == MXL_STATUS_OK);
+
+    auto const isReadable = [](int fd, int timeoutMs)
+    {
+        auto pfd = ::pollfd{fd, POLLIN, 0};
+        return (::poll(&pfd, 1, timeoutMs) == 1) && ((pfd.revents & POLLIN) != 0);
+    };
+
+    auto fd = -1;
+    auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+    REQUIRE(mxlFlowReaderGetWaitHandle(nullptr, reader, index, MXL_GRAIN_VALID_SLICES_ALL, &fd) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, nullptr, index, MXL_GRAIN_VALID_SLICES_ALL, &fd) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index, MXL_GRAIN_VALID_SLICES_ALL, nullptr) == MXL_ERR_INVALID_ARG);
+
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index, MXL_GRAIN_VALID_SLICES_ALL, &fd) == MXL_STATUS_OK);
+    REQUIRE(fd >= 0);
+    REQUIRE(!isReadable(fd, 20));
+
+    // A partially committed grain must only signal handles waiting for the slices that are valid already.
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices / 2;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(!isReadable(fd, 20));
+
+    auto sameFd = -1;
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index, gInfo.validSlices, &sameFd) == MXL_STATUS_OK);
+    REQUIRE(sameFd == fd);
+    REQUIRE(isReadable(fd, 0));
+
+    // Re-arming resets the handle, and a commit from another thread signals it.
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index, MXL_GRAIN_VALID_SLICES_ALL, &sameFd) == MXL_STATUS_OK);
+    REQUIRE(sameFd == fd);
+    REQUIRE(!isReadable(fd, 0));
+
+    auto writerThread = std::thread{[&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+            gInfo.validSlices = gInfo.totalSlices;
+            REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+        }};
+    auto const signalled = isReadable(fd, 1000);
+    writerThread.join();
+    REQUIRE(signalled);
+
+    mxlGrainInfo readInfo;
+    uint8_t* readBuffer = nullptr;
+    REQUIRE(mxlFlowReaderGetGrainNonBlocking(reader, index, &readInfo, &readBuffer) == MXL_STATUS_OK);
+    REQUIRE(readInfo.validSlices == readInfo.totalSlices);
+
+    // Grains that have been overwritten already can no longer be waited for either.
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index - 1000, MXL_GRAIN_VALID_SLICES_ALL, &sameFd) == MXL_STATUS_OK);
+    REQUIRE(isReadable(fd, 0));
+
+    // Releasing the reader while its handle is armed must be safe.
+    REQUIRE(mxlFlowReaderGetWaitHandle(instance, reader, index + 1, MXL_GRAIN_VALID_SLICES_ALL, &sameFd) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Create/Destroy", "[mxl flows]")
 {
     auto const opts = "{}";
@@ -754,6 +1243,515 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Create/
     mxlDestroyInstance(instanceWriter);
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Interleaved samples", "[mxl flows]")
+{
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    REQUIRE(configInfo.continuous.channelCount == 2U);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    // Choose the range such that it straddles the wrap-around point of the ring buffers.
+    auto constexpr count = std::size_t{64};
+    auto const bufferLength = std::uint64_t{configInfo.continuous.bufferLength};
+    auto const index = ((mxlGetCurrentIndex(&configInfo.common.grainRate) / bufferLength) + 1U) * bufferLength + (count / 2U);
+
+    float frames[count][2];
+    for (auto i = 0U; i < count; ++i)
+    {
+        frames[i][0] = static_cast<float>(i) / 128.0f;
+        frames[i][1] = -static_cast<float>(i) / 128.0f;
+    }
+
+    // Buffers that are too small are rejected without committing anything.
+    REQUIRE(mxlFlowWriterWriteSamplesInterleaved(writer, index, count, MXL_SAMPLE_FORMAT_NATIVE, frames, sizeof(frames) - 1U) ==
+            MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowWriterWriteSamplesInterleaved(writer, index, count, MXL_SAMPLE_FORMAT_NATIVE, frames, sizeof(frames)) == MXL_STATUS_OK);
+
+    {
+        // The samples end up in the planar channel buffers.
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.base.fragments[1].size != 0U);
+
+        for (auto channel = 0U; channel < 2U; ++channel)
+        {
+            auto sample = 0U;
+            for (auto const& fragment : payloadBuffersSlices.base.fragments)
+            {
+                auto const samples = reinterpret_cast<float const*>(static_cast<std::uint8_t const*>(fragment.pointer) + channel * payloadBuffersSlices.stride);
+                for (auto i = 0U; i < (fragment.size / sizeof(float)); ++i, ++sample)
+                {
+                    REQUIRE(samples[i] == frames[sample][channel]);
+                }
+            }
+        }
+    }
+
+    {
+        float readFrames[count][2] = {};
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(reader, index, count, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readFrames, sizeof(readFrames)) ==
+                MXL_STATUS_OK);
+        REQUIRE(std::memcmp(readFrames, frames, sizeof(frames)) == 0);
+
+        std::int16_t readFrames16[count][2] = {};
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(reader, index, count, 0U, MXL_SAMPLE_FORMAT_S16, 0U, readFrames16, sizeof(readFrames16)) ==
+                MXL_STATUS_OK);
+        for (auto i = 0U; i < count; ++i)
+        {
+            REQUIRE(readFrames16[i][0] == static_cast<std::int16_t>(i * 256U));
+            REQUIRE(readFrames16[i][1] == -static_cast<std::int16_t>(i * 256U));
+        }
+
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(reader, index, count, 0U, MXL_SAMPLE_FORMAT_S16, 0U, readFrames16, sizeof(readFrames16) - 1U) ==
+                MXL_ERR_INVALID_ARG);
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(reader, index + count, count, 0U, MXL_SAMPLE_FORMAT_S16, 0U, readFrames16, sizeof(readFrames16)) ==
+                MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+    }
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Channel subset", "[mxl flows]")
+{
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    REQUIRE(configInfo.continuous.channelCount == 2U);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto constexpr count = std::size_t{64};
+    auto const bufferLength = std::uint64_t{configInfo.continuous.bufferLength};
+    auto const index = ((mxlGetCurrentIndex(&configInfo.common.grainRate) / bufferLength) + 1U) * bufferLength + (count / 2U);
+
+    float frames[count][2];
+    for (auto i = 0U; i < count; ++i)
+    {
+        frames[i][0] = static_cast<float>(i) / 128.0f;
+        frames[i][1] = -static_cast<float>(i) / 128.0f;
+    }
+    REQUIRE(mxlFlowWriterWriteSamplesInterleaved(writer, index, count, MXL_SAMPLE_FORMAT_NATIVE, frames, sizeof(frames)) == MXL_STATUS_OK);
+
+    {
+        // The slices of the second channel alone start where the second channel starts in the slices of all channels.
+        mxlWrappedMultiBufferSlice allSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, index, count, &allSlices) == MXL_STATUS_OK);
+
+        mxlWrappedMultiBufferSlice slices;
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 1U, 1U, &slices) == MXL_STATUS_OK);
+        REQUIRE(slices.count == 1U);
+        REQUIRE(slices.stride == allSlices.stride);
+        for (auto i = 0U; i < 2U; ++i)
+        {
+            REQUIRE(slices.base.fragments[i].pointer == static_cast<std::uint8_t const*>(allSlices.base.fragments[i].pointer) + allSlices.stride);
+            REQUIRE(slices.base.fragments[i].size == allSlices.base.fragments[i].size);
+        }
+
+        REQUIRE(mxlFlowReaderGetChannelSamples(reader, index, count, 0U, 2U, 0U, &slices) == MXL_STATUS_OK);
+        REQUIRE(slices.count == 2U);
+        REQUIRE(slices.base.fragments[0].pointer == allSlices.base.fragments[0].pointer);
+
+        // Empty ranges and ranges beyond the channels of the flow are rejected.
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 0U, 0U, &slices) == MXL_ERR_INVALID_ARG);
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 1U, 2U, &slices) == MXL_ERR_INVALID_ARG);
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 2U, 1U, &slices) == MXL_ERR_INVALID_ARG);
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 1U, SIZE_MAX, &slices) == MXL_ERR_INVALID_ARG);
+    }
+
+    {
+        float readSamples[count] = {};
+        REQUIRE(mxlFlowReaderCopyChannelSamplesInterleaved(reader, index, count, 1U, 1U, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readSamples,
+                    sizeof(readSamples)) == MXL_STATUS_OK);
+        for (auto i = 0U; i < count; ++i)
+        {
+            REQUIRE(readSamples[i] == frames[i][1]);
+        }
+
+        // The buffer only needs to hold the selected channels.
+        REQUIRE(mxlFlowReaderCopyChannelSamplesInterleaved(reader, index, count, 0U, 1U, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readSamples,
+                    sizeof(readSamples) - 1U) == MXL_ERR_INVALID_ARG);
+        REQUIRE(mxlFlowReaderCopyChannelSamplesInterleaved(reader, index, count, 2U, 1U, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readSamples,
+                    sizeof(readSamples)) == MXL_ERR_INVALID_ARG);
+    }
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Mirrored channel buffers", "[mxl flows]")
+{
+    auto const mirrored = R"({"channelMapping": "mirrored"})";
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    // Readers of a flow are shared within an instance, so the linearly mapped reader needs its own instance.
+    auto linearInstance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(linearInstance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), mirrored, &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+
+    // Additional references to the writer of the flow in this instance can't ask for a different mapping, but may leave it unspecified.
+    mxlFlowWriter sharedWriter;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), R"({"channelMapping": "linear"})", &sharedWriter, nullptr, nullptr) ==
+            MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), nullptr, &sharedWriter, nullptr, nullptr) == MXL_STATUS_OK);
+    REQUIRE(sharedWriter == writer);
+    REQUIRE(mxlReleaseFlowWriter(instance, sharedWriter) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, mirrored, &reader) == MXL_STATUS_OK);
+
+    // Additional references to the shared reader can't ask for a different mapping, but may leave it unspecified.
+    mxlFlowReader sharedReader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, R"({"channelMapping": "linear"})", &sharedReader) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlowReader(instance, flowId, nullptr, &sharedReader) == MXL_STATUS_OK);
+    REQUIRE(sharedReader == reader);
+    REQUIRE(mxlReleaseFlowReader(instance, sharedReader) == MXL_STATUS_OK);
+
+    mxlFlowReader linearReader;
+    REQUIRE(mxlCreateFlowReader(linearInstance, flowId, R"({"channelMapping": "linear"})", &linearReader) == MXL_STATUS_OK);
+
+    // Choose the range such that it straddles the wrap-around point of the ring buffers.
+    auto constexpr count = std::size_t{64};
+    auto const bufferLength = std::uint64_t{configInfo.continuous.bufferLength};
+    auto const index = ((mxlGetCurrentIndex(&configInfo.common.grainRate) / bufferLength) + 1U) * bufferLength + (count / 2U);
+
+    {
+        mxlMutableWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowWriterOpenSamples(writer, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.base.fragments[0].size == count * sizeof(float));
+        REQUIRE(payloadBuffersSlices.base.fragments[1].size == 0U);
+
+        for (auto channel = 0U; channel < payloadBuffersSlices.count; ++channel)
+        {
+            auto const samples = reinterpret_cast<float*>(
+                static_cast<std::uint8_t*>(payloadBuffersSlices.base.fragments[0].pointer) + channel * payloadBuffersSlices.stride);
+            for (auto i = 0U; i < count; ++i)
+            {
+                samples[i] = static_cast<float>(channel * count + i);
+            }
+        }
+        REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+    }
+
+    {
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.base.fragments[0].size == count * sizeof(float));
+        REQUIRE(payloadBuffersSlices.base.fragments[1].size == 0U);
+
+        for (auto channel = 0U; channel < payloadBuffersSlices.count; ++channel)
+        {
+            auto const samples = reinterpret_cast<float const*>(
+                static_cast<std::uint8_t const*>(payloadBuffersSlices.base.fragments[0].pointer) + channel * payloadBuffersSlices.stride);
+            for (auto i = 0U; i < count; ++i)
+            {
+                REQUIRE(samples[i] == static_cast<float>(channel * count + i));
+            }
+        }
+    }
+
+    {
+        // The samples written through the mirror ended up in the same storage that linearly mapped readers see.
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(linearReader, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.base.fragments[1].size != 0U);
+
+        for (auto channel = 0U; channel < payloadBuffersSlices.count; ++channel)
+        {
+            auto sample = 0U;
+            for (auto const& fragment : payloadBuffersSlices.base.fragments)
+            {
+                auto const samples = reinterpret_cast<float const*>(static_cast<std::uint8_t const*>(fragment.pointer) + channel * payloadBuffersSlices.stride);
+                for (auto i = 0U; i < (fragment.size / sizeof(float)); ++i, ++sample)
+                {
+                    REQUIRE(samples[i] == static_cast<float>(channel * count + sample));
+                }
+            }
+        }
+    }
+
+    REQUIRE(mxlReleaseFlowReader(linearInstance, linearReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(linearInstance);
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Interleaved layout", "[mxl flows]")
+{
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), R"({"continuousFlowLayout": "interleaved"})", &writer, &configInfo, nullptr) ==
+            MXL_STATUS_OK);
+    REQUIRE(configInfo.continuous.channelCount == 2U);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    // Choose the range such that it straddles the wrap-around point of the ring buffer.
+    auto constexpr count = std::size_t{64};
+    auto const bufferLength = std::uint64_t{configInfo.continuous.bufferLength};
+    auto const index = ((mxlGetCurrentIndex(&configInfo.common.grainRate) / bufferLength) + 1U) * bufferLength + (count / 2U);
+
+    {
+        // The planar accessors can't describe the interleaved samples.
+        mxlMutableWrappedMultiBufferSlice planarSlices;
+        REQUIRE(mxlFlowWriterOpenSamples(writer, index, count, &planarSlices) == MXL_ERR_UNSUPPORTED_OPERATION);
+
+        mxlMutableStridedWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowWriterOpenSamplesStrided(writer, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.count == 2U);
+        REQUIRE(payloadBuffersSlices.stride == sizeof(float));
+        REQUIRE(payloadBuffersSlices.elementStride == 2U * sizeof(float));
+        REQUIRE(payloadBuffersSlices.base.fragments[1].size != 0U);
+
+        auto frame = 0U;
+        for (auto const& fragment : payloadBuffersSlices.base.fragments)
+        {
+            for (auto i = 0U; i < (fragment.size / payloadBuffersSlices.elementStride); ++i, ++frame)
+            {
+                for (auto channel = 0U; channel < payloadBuffersSlices.count; ++channel)
+                {
+                    auto const sample = static_cast<float>(channel * count + frame);
+                    std::memcpy(static_cast<std::uint8_t*>(fragment.pointer) + i * payloadBuffersSlices.elementStride +
+                                    channel * payloadBuffersSlices.stride,
+                        &sample,
+                        sizeof(sample));
+                }
+            }
+        }
+        REQUIRE(frame == count);
+        REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+    }
+
+    {
+        mxlWrappedMultiBufferSlice planarSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, index, count, &planarSlices) == MXL_ERR_UNSUPPORTED_OPERATION);
+        REQUIRE(mxlFlowReaderGetChannelSamplesNonBlocking(reader, index, count, 1U, 1U, &planarSlices) == MXL_ERR_UNSUPPORTED_OPERATION);
+
+        // The samples of each frame are stored next to each other.
+        mxlStridedWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesStridedNonBlocking(reader, index, count, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(payloadBuffersSlices.elementStride == 2U * sizeof(float));
+
+        auto frame = 0U;
+        for (auto const& fragment : payloadBuffersSlices.base.fragments)
+        {
+            auto const samples = static_cast<float const*>(fragment.pointer);
+            for (auto i = 0U; i < (fragment.size / payloadBuffersSlices.elementStride); ++i, ++frame)
+            {
+                REQUIRE(samples[2U * i] == static_cast<float>(frame));
+                REQUIRE(samples[2U * i + 1U] == static_cast<float>(count + frame));
+            }
+        }
+    }
+
+    {
+        // The interleaved copies work the same way as with planar flows.
+        float readFrames[count][2] = {};
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(reader, index, count, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readFrames, sizeof(readFrames)) ==
+                MXL_STATUS_OK);
+        float readChannel[count] = {};
+        REQUIRE(mxlFlowReaderCopyChannelSamplesInterleaved(
+                    reader, index, count, 1U, 1U, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, readChannel, sizeof(readChannel)) == MXL_STATUS_OK);
+        for (auto i = 0U; i < count; ++i)
+        {
+            REQUIRE(readFrames[i][0] == static_cast<float>(i));
+            REQUIRE(readFrames[i][1] == static_cast<float>(count + i));
+            REQUIRE(readChannel[i] == static_cast<float>(count + i));
+        }
+
+        std::int16_t frames16[count][2];
+        for (auto i = 0U; i < count; ++i)
+        {
+            frames16[i][0] = static_cast<std::int16_t>(i * 256U);
+            frames16[i][1] = -static_cast<std::int16_t>(i * 256U);
+        }
+        REQUIRE(mxlFlowWriterWriteSamplesInterleaved(writer, index + count, count, MXL_SAMPLE_FORMAT_S16, frames16, sizeof(frames16)) ==
+                MXL_STATUS_OK);
+
+        std::int16_t readFrames16[count][2] = {};
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(
+                    reader, index + count, count, 0U, MXL_SAMPLE_FORMAT_S16, 0U, readFrames16, sizeof(readFrames16)) == MXL_STATUS_OK);
+        REQUIRE(std::memcmp(readFrames16, frames16, sizeof(frames16)) == 0);
+    }
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Reserved write batch", "[mxl flows]")
+{
+    auto constexpr batchSize = std::size_t{480};
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    // Only flows that older SDK versions can't open reserve a single commit batch.
+    auto const options = R"({"maxCommitBatchSizeHint": 480, "flowWaiters": true})";
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), options, &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    // The buffers hold the default history of 200ms plus one commit batch, rather than twice the history.
+    auto const bufferLength = std::size_t{configInfo.continuous.bufferLength};
+    REQUIRE(bufferLength >= 9600U + batchSize);
+    REQUIRE(bufferLength < 2U * 9600U);
+
+    auto maxReadLength = std::size_t{};
+    REQUIRE(mxlFlowReaderGetMaxReadLengthSamples(reader, &maxReadLength) == MXL_STATUS_OK);
+    REQUIRE(maxReadLength == bufferLength - batchSize);
+    auto maxWriteLength = std::size_t{};
+    REQUIRE(mxlFlowWriterGetMaxWriteLengthSamples(writer, &maxWriteLength) == MXL_STATUS_OK);
+    REQUIRE(maxWriteLength == maxReadLength);
+
+    // Fill the whole buffer in commit batches, tagging every sample of the first channel with its index.
+    auto headIndex = mxlGetCurrentIndex(&configInfo.common.grainRate);
+    for (auto written = std::size_t{0}; written < bufferLength; written += batchSize)
+    {
+        headIndex += batchSize;
+
+        mxlMutableWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowWriterOpenSamples(writer, headIndex, batchSize, &payloadBuffersSlices) == MXL_STATUS_OK);
+        auto index = headIndex - batchSize + 1U;
+        for (auto const& fragment : payloadBuffersSlices.base.fragments)
+        {
+            for (auto i = std::size_t{0}; i < (fragment.size / sizeof(std::uint32_t)); ++i)
+            {
+                static_cast<std::uint32_t*>(fragment.pointer)[i] = static_cast<std::uint32_t>(index++);
+            }
+        }
+        REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+    }
+
+    {
+        // Everything but the reserved batch can be read in one go.
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, headIndex, maxReadLength, &payloadBuffersSlices) == MXL_STATUS_OK);
+        auto index = headIndex - maxReadLength + 1U;
+        for (auto const& fragment : payloadBuffersSlices.base.fragments)
+        {
+            for (auto i = std::size_t{0}; i < (fragment.size / sizeof(std::uint32_t)); ++i)
+            {
+                REQUIRE(static_cast<std::uint32_t const*>(fragment.pointer)[i] == static_cast<std::uint32_t>(index++));
+            }
+        }
+        REQUIRE(index == headIndex + 1U);
+
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, headIndex, maxReadLength + 1U, &payloadBuffersSlices) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    }
+
+    {
+        // A batch within the hint that is still being written doesn't affect the readable window.
+        mxlMutableWrappedMultiBufferSlice writeSlices;
+        REQUIRE(mxlFlowWriterOpenSamples(writer, headIndex + batchSize, batchSize, &writeSlices) == MXL_STATUS_OK);
+
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, headIndex, maxReadLength, &payloadBuffersSlices) == MXL_STATUS_OK);
+        REQUIRE(mxlFlowWriterCancelSamples(writer) == MXL_STATUS_OK);
+    }
+
+    {
+        // A larger batch overwrites the oldest samples, which readers must no longer hand out, even before it is committed.
+        mxlMutableWrappedMultiBufferSlice writeSlices;
+        REQUIRE(mxlFlowWriterOpenSamples(writer, headIndex + 2U * batchSize, 2U * batchSize, &writeSlices) == MXL_STATUS_OK);
+
+        mxlWrappedMultiBufferSlice payloadBuffersSlices;
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, headIndex, maxReadLength, &payloadBuffersSlices) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+        REQUIRE(mxlFlowReaderGetSamplesNonBlocking(reader, headIndex, maxReadLength - batchSize, &payloadBuffersSlices) == MXL_STATUS_OK);
+
+        auto samples = std::vector<float>(maxReadLength * configInfo.continuous.channelCount);
+        REQUIRE(mxlFlowReaderCopySamplesInterleaved(
+                    reader, headIndex, maxReadLength, 0U, MXL_SAMPLE_FORMAT_NATIVE, 0U, samples.data(), samples.size() * sizeof(float)) ==
+                MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+        REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+    }
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Half buffer writes on legacy flows", "[mxl flows]")
+{
+    auto constexpr batchSize = std::size_t{480};
+    auto const flowId = "b3bb5be7-9fe9-4324-a5bb-4c70e1084449";
+    auto const flowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), R"({"maxCommitBatchSizeHint": 480})", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    // Readers of older SDK versions may share the flow, which expect the writer to stay within half of the buffer ahead of the
+    // head. The buffers therefore hold twice the default history of 200ms, so that the full history can still be read.
+    auto const bufferLength = std::size_t{configInfo.continuous.bufferLength};
+    REQUIRE(bufferLength >= 2U * 9600U);
+
+    auto maxReadLength = std::size_t{};
+    REQUIRE(mxlFlowReaderGetMaxReadLengthSamples(reader, &maxReadLength) == MXL_STATUS_OK);
+    REQUIRE(maxReadLength == bufferLength / 2U);
+    auto maxWriteLength = std::size_t{};
+    REQUIRE(mxlFlowWriterGetMaxWriteLengthSamples(writer, &maxWriteLength) == MXL_STATUS_OK);
+    REQUIRE(maxWriteLength == bufferLength / 2U);
+
+    auto const headIndex = mxlGetCurrentIndex(&configInfo.common.grainRate) + batchSize;
+    mxlMutableWrappedMultiBufferSlice writeSlices;
+    REQUIRE(mxlFlowWriterOpenSamples(writer, headIndex + maxWriteLength, maxWriteLength + 1U, &writeSlices) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowWriterOpenSamples(writer, headIndex, maxWriteLength, &writeSlices) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    mxlDestroyInstance(instance);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Invalid Flow (continuous)", "[mxl flows]")
 {
     auto const opts = "{}";
@@ -1,11 +1,14 @@
 // SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <string>
 #include <thread>
+#include <vector>
 #include <uuid.h>
 #include <catch2/catch_test_macros.hpp>
 #include <mxl/flow.h>
@@ -82,3 +85,157 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Wait fo
     REQUIRE(mxlDestroyInstance(instanceReader) == MXL_STATUS_OK);
     REQUIRE(mxlDestroyInstance(instanceWriter) == MXL_STATUS_OK);
 }
+
+/// Every wait policy must deliver the grain, and the reader must account for the wait in its statistics.
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Wait policies", "[mxl flows timing]")
+{
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    for (auto const policy : {"futex", "spin", "adaptive"})
+    {
+        mxlFlowWriter writer;
+        mxlFlowConfigInfo configInfo;
+        REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), "", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+        auto const flowId = uuids::to_string(configInfo.common.id);
+
+        mxlFlowReader reader;
+        REQUIRE(mxlCreateFlowReader(instance, flowId.c_str(), R"({"waitPolicy": "bogus"})", &reader) != MXL_STATUS_OK);
+
+        auto const options = std::string{R"({"waitPolicy": ")"} + policy + R"(", "maxSpinNs": 100000})";
+        REQUIRE(mxlCreateFlowReader(instance, flowId.c_str(), options.c_str(), &reader) == MXL_STATUS_OK);
+
+        auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+        auto writerThread = std::thread{[index, writer]
+            {
+                mxlSleepForNs(20'000'000);
+
+                mxlGrainInfo gInfo;
+                std::uint8_t* buffer = nullptr;
+                REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+                gInfo.validSlices = gInfo.totalSlices;
+                REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+            }};
+
+        mxlGrainInfo gInfo;
+        std::uint8_t* buffer = nullptr;
+        REQUIRE(mxlFlowReaderGetGrain(reader, index, 1'000'000'000, &gInfo, &buffer) == MXL_STATUS_OK);
+        writerThread.join();
+
+        mxlFlowReaderWaitStatistics stats;
+        REQUIRE(mxlFlowReaderGetWaitStatistics(reader, &stats) == MXL_STATUS_OK);
+        REQUIRE(stats.waits >= 1);
+        REQUIRE(stats.timeouts == 0);
+        REQUIRE((stats.spinWakeups + stats.futexWakeups) == stats.waits);
+        REQUIRE(stats.latencySamples >= 1);
+        REQUIRE(stats.maxWakeupLatency <= stats.totalWakeupLatency);
+        if (std::string{policy} == "futex")
+        {
+            REQUIRE(stats.spinWakeups == 0);
+        }
+
+        REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+        REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    }
+
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+/// Counts the wake-ups that don't allow readers to make progress while a grain is committed slice by slice. Readers that register
+/// what they are waiting for must only be woken up once, readers that can't register are woken up by every commit.
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Wasted wake-ups", "[mxl flows timing]")
+{
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+    mxlFlowWriter writer;
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlowWriter(instance, flowDef.c_str(), R"({"flowWaiters": true})", &writer, &configInfo, nullptr) == MXL_STATUS_OK);
+    auto const flowId = uuids::to_string(configInfo.common.id);
+
+    // Readers are shared within an instance, so every reader needs an instance of its own.
+    auto fullGrainInstance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(fullGrainInstance != nullptr);
+    mxlFlowReader fullGrainReader;
+    REQUIRE(mxlCreateFlowReader(fullGrainInstance, flowId.c_str(), "", &fullGrainReader) == MXL_STATUS_OK);
+
+    auto halfGrainInstance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(halfGrainInstance != nullptr);
+    mxlFlowReader halfGrainReader;
+    REQUIRE(mxlCreateFlowReader(halfGrainInstance, flowId.c_str(), "", &halfGrainReader) == MXL_STATUS_OK);
+
+    // Readers that can't open the waiters segment fall back to waiting on the sync counter of the flow.
+    REQUIRE(std::filesystem::remove(domain / (flowId + ".mxl-flow") / "waiters"));
+    auto unregisteredInstance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(unregisteredInstance != nullptr);
+    mxlFlowReader unregisteredReader;
+    REQUIRE(mxlCreateFlowReader(unregisteredInstance, flowId.c_str(), "", &unregisteredReader) == MXL_STATUS_OK);
+
+    auto const index = mxlGetCurrentIndex(&configInfo.common.grainRate);
+    auto const readGrain = [index](mxlFlowReader reader, std::uint16_t minValidSlices)
+    {
+        return std::thread{[index, reader, minValidSlices]
+            {
+                mxlGrainInfo gInfo;
+                std::uint8_t* buffer = nullptr;
+                REQUIRE(mxlFlowReaderGetGrainSlice(reader, index, minValidSlices, 5'000'000'000, &gInfo, &buffer) == MXL_STATUS_OK);
+                REQUIRE(gInfo.validSlices >= std::min(minValidSlices, gInfo.totalSlices));
+            }};
+    };
+
+    mxlGrainInfo gInfo;
+    std::uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    auto const totalSlices = gInfo.totalSlices;
+    auto const halfSlices = static_cast<std::uint16_t>(totalSlices / 2U);
+
+    auto readers = std::vector<std::thread>{};
+    readers.push_back(readGrain(fullGrainReader, MXL_GRAIN_VALID_SLICES_ALL));
+    readers.push_back(readGrain(halfGrainReader, halfSlices));
+    readers.push_back(readGrain(unregisteredReader, MXL_GRAIN_VALID_SLICES_ALL));
+
+    // Give the readers a chance to go to sleep, then commit the grain in batches of slices.
+    mxlSleepForNs(50'000'000);
+    constexpr auto batchCount = 36U;
+    for (auto batch = 1U; batch <= batchCount; ++batch)
+    {
+        gInfo.validSlices = static_cast<std::uint16_t>(totalSlices * batch / batchCount);
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+        mxlSleepForNs(1'000'000);
+    }
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    auto const statistics = [](mxlFlowReader reader)
+    {
+        mxlFlowReaderWaitStatistics stats;
+        REQUIRE(mxlFlowReaderGetWaitStatistics(reader, &stats) == MXL_STATUS_OK);
+        return stats;
+    };
+
+    auto const fullGrainStats = statistics(fullGrainReader);
+    REQUIRE(fullGrainStats.waits == 1);
+    REQUIRE(fullGrainStats.wastedWakeups == 0);
+
+    auto const halfGrainStats = statistics(halfGrainReader);
+    REQUIRE(halfGrainStats.waits == 1);
+    REQUIRE(halfGrainStats.wastedWakeups == 0);
+
+    auto const unregisteredStats = statistics(unregisteredReader);
+    REQUIRE(unregisteredStats.wastedWakeups > 0);
+
+    REQUIRE(mxlReleaseFlowReader(unregisteredInstance, unregisteredReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(halfGrainInstance, halfGrainReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowReader(fullGrainInstance, fullGrainReader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(unregisteredInstance) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(halfGrainInstance) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(fullGrainInstance) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
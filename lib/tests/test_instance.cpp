@@ -1,6 +1,11 @@
 // SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
 #include <uuid.h>
 #include <catch2/catch_test_macros.hpp>
 #include <mxl/flow.h>
@@ -180,3 +185,118 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow deletion on ins
     mxlDestroyInstance(instanceB);
     REQUIRE_FALSE(flowDirectoryExists(id));
 }
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Parallel flow creation / opening / release", "[instance]")
+{
+    constexpr auto threadCount = 8;
+    constexpr auto flowsPerThread = 8;
+    constexpr auto iterations = 4;
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), nullptr);
+    REQUIRE(instance != nullptr);
+
+    auto const templateDef = mxl::tests::readFile("data/data_flow.json");
+    auto const templateId = std::string{"db3bd465-2772-484f-8fac-830b0471258b"};
+    auto const makeFlowId = [](int index)
+    {
+        char id[37];
+        std::snprintf(id, sizeof(id), "00000000-0000-4000-8000-%012d", index);
+        return std::string{id};
+    };
+    auto const makeFlowDef = [&](std::string const& id)
+    {
+        auto flowDef = templateDef;
+        return flowDef.replace(flowDef.find(templateId), templateId.size(), id);
+    };
+
+    // Every thread brings up and tears down flows of its own, while all of them also share one flow.
+    auto const sharedFlowId = makeFlowId(threadCount * flowsPerThread);
+    auto const sharedFlowDef = makeFlowDef(sharedFlowId);
+
+    auto failures = std::atomic<int>{0};
+    auto const check = [&](bool condition)
+    {
+        if (!condition)
+        {
+            ++failures;
+        }
+        return condition;
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                auto flowIds = std::vector<std::string>{};
+                auto flowDefs = std::vector<std::string>{};
+                for (auto i = 0; i < flowsPerThread; ++i)
+                {
+                    flowIds.push_back(makeFlowId(t * flowsPerThread + i));
+                    flowDefs.push_back(makeFlowDef(flowIds.back()));
+                }
+
+                for (auto iteration = 0; iteration < iterations; ++iteration)
+                {
+                    auto writers = std::vector<mxlFlowWriter>{};
+                    auto readers = std::vector<mxlFlowReader>{};
+                    for (auto i = 0; i < flowsPerThread; ++i)
+                    {
+                        mxlFlowWriter writer;
+                        mxlFlowConfigInfo configInfo;
+                        auto created = false;
+                        check(mxlCreateFlowWriter(instance, flowDefs[i].c_str(), nullptr, &writer, &configInfo, &created) == MXL_STATUS_OK);
+                        check(created);
+                        writers.push_back(writer);
+
+                        // Additional references to a reader must yield the same reader.
+                        mxlFlowReader reader;
+                        mxlFlowReader sameReader;
+                        check(mxlCreateFlowReader(instance, flowIds[i].c_str(), "", &reader) == MXL_STATUS_OK);
+                        check(mxlCreateFlowReader(instance, flowIds[i].c_str(), "", &sameReader) == MXL_STATUS_OK);
+                        check(reader == sameReader);
+                        readers.push_back(reader);
+                        readers.push_back(sameReader);
+                    }
+
+                    // The shared flow is deleted and created again whenever its writers happen to be released by all threads.
+                    mxlFlowWriter sharedWriter;
+                    mxlFlowConfigInfo configInfo;
+                    if (check(mxlCreateFlowWriter(instance, sharedFlowDef.c_str(), nullptr, &sharedWriter, &configInfo, nullptr) == MXL_STATUS_OK))
+                    {
+                        mxlFlowReader sharedReader;
+                        if (check(mxlCreateFlowReader(instance, sharedFlowId.c_str(), "", &sharedReader) == MXL_STATUS_OK))
+                        {
+                            check(mxlFlowReaderGetConfigInfo(sharedReader, &configInfo) == MXL_STATUS_OK);
+                            check(uuids::to_string(configInfo.common.id) == sharedFlowId);
+                            check(mxlReleaseFlowReader(instance, sharedReader) == MXL_STATUS_OK);
+                        }
+                        check(mxlReleaseFlowWriter(instance, sharedWriter) == MXL_STATUS_OK);
+                    }
+                    for (auto reader : readers)
+                    {
+                        check(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+                    }
+                    for (auto writer : writers)
+                    {
+                        check(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(failures == 0);
+
+    // Releasing the last writer of each flow deletes it.
+    for (auto i = 0; i <= threadCount * flowsPerThread; ++i)
+    {
+        REQUIRE_FALSE(flowDirectoryExists(makeFlowId(i)));
+    }
+
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
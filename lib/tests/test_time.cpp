@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <ctime>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <mxl/mxl.h>
 #include <mxl/time.h>
@@ -79,3 +80,48 @@ TEST_CASE("Index <-> Timestamp roundtrip (others)", "[time]")
         REQUIRE(i == rti);
     }
 }
+
+TEST_CASE("Rate converter matches the index conversion functions", "[time]")
+{
+    auto const rates = {mxlRational{24000, 1001},
+        mxlRational{30000, 1001},
+        mxlRational{60000, 1001},
+        mxlRational{25, 1},
+        mxlRational{50, 1},
+        mxlRational{48000, 1},
+        mxlRational{44100, 1},
+        mxlRational{123456789, 987654321},
+        mxlRational{0, 1001},
+        mxlRational{30000, 0}};
+
+    auto const now = mxlGetTime();
+    auto values = std::vector<std::uint64_t>{0, 1, now, UINT64_MAX >> 1, (UINT64_MAX >> 1) + 1, UINT64_MAX};
+    for (auto i = std::uint64_t{0}; i < 10'000U; ++i)
+    {
+        values.push_back(now + i * 1'000'003U);
+        values.push_back(i * 0x9e37'79b9'7f4a'7c15ULL >> (i % 64));
+    }
+
+    for (auto const& rate : rates)
+    {
+        auto converter = mxlRateConverter{};
+        mxlRateConverterInit(&converter, &rate);
+
+        auto indices = std::vector<std::uint64_t>(values.size());
+        auto timestamps = std::vector<std::uint64_t>(values.size());
+        mxlRateConverterTimestampsToIndices(&converter, values.data(), indices.data(), values.size());
+        mxlRateConverterIndicesToTimestamps(&converter, values.data(), timestamps.data(), values.size());
+
+        for (auto i = std::size_t{0}; i < values.size(); ++i)
+        {
+            auto const value = values[i];
+            REQUIRE(mxlRateConverterTimestampToIndex(&converter, value) == mxlTimestampToIndex(&rate, value));
+            REQUIRE(indices[i] == mxlTimestampToIndex(&rate, value));
+            REQUIRE(mxlRateConverterIndexToTimestamp(&converter, value) == mxlIndexToTimestamp(&rate, value));
+            REQUIRE(timestamps[i] == mxlIndexToTimestamp(&rate, value));
+        }
+    }
+
+    REQUIRE(mxlRateConverterTimestampToIndex(nullptr, now) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlRateConverterIndexToTimestamp(nullptr, 1) == MXL_UNDEFINED_INDEX);
+}
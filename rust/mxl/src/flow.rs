@@ -147,4 +147,16 @@ impl FlowRuntimeInfo {
     pub fn last_read_time(&self) -> u64 {
         self.value.lastReadTime
     }
+
+    pub fn next_commit_time(&self) -> u64 {
+        self.value.nextCommitTime
+    }
+
+    pub fn commit_interval(&self) -> u64 {
+        self.value.commitInterval
+    }
+
+    pub fn open_head_index(&self) -> u64 {
+        self.value.openHeadIndex
+    }
 }
@@ -278,7 +278,7 @@ namespace
 
             auto const pipelineDesc = fmt::format(
                 "appsrc name=appsource is-live=true ! "
-                "audio/x-raw,format=F32LE,layout=non-interleaved,channels={},rate={} ! "
+                "audio/x-raw,format=F32LE,layout=interleaved,channels={},rate={} ! "
                 "audioconvert mix-matrix=\"{}\" ! "
                 "autoaudiosink ts-offset={}",
                 _config.channelCount,
@@ -301,7 +301,7 @@ namespace
                 _audioInfo = ::gst_audio_info_new();
                 ::gst_audio_info_set_format(
                     _audioInfo, GST_AUDIO_FORMAT_F32LE, config.sampleRate.numerator, config.channelCount, channelPositions.data());
-                _audioInfo->layout = GST_AUDIO_LAYOUT_NON_INTERLEAVED;
+                _audioInfo->layout = GST_AUDIO_LAYOUT_INTERLEAVED;
 
                 auto const caps = ::gst_audio_info_to_caps(_audioInfo);
                 ::g_object_set(G_OBJECT(getAppSource()), "caps", caps, nullptr);
@@ -615,61 +615,50 @@ namespace
 
             initializeHighestLatency("Audio", rate, cursor.currentIndex(), cursor.requestedIndex());
 
+            // The samples are interleaved by the SDK straight into the buffer handed to the pipeline. The buffer is kept while
+            // retrying the same window and only replaced once it has been pushed.
+            auto buffer = std::unique_ptr<GstBuffer, void (*)(GstBuffer*)>{nullptr, [](GstBuffer* buf) { ::gst_buffer_unref(buf); }};
+
             while (!g_exit_requested)
             {
                 auto const iterationStartTime = ::mxlGetTime();
                 auto const iterationTimeoutNs =
                     (iterationStartTime < cursor.deliveryDeadline()) ? (cursor.deliveryDeadline() - iterationStartTime) : 0ULL;
 
-                mxlWrappedMultiBufferSlice payload;
-                auto const ret = ::mxlFlowReaderGetSamples(_reader, cursor.requestedIndex(), windowSize, iterationTimeoutNs, &payload);
-
-                if (ret == MXL_STATUS_OK)
+                // The channel count changes if the reader had to be recreated for a new flow.
+                auto const payloadLen = windowSize * _configInfo.continuous.channelCount * sizeof(float);
+                if (!buffer || (::gst_buffer_get_size(buffer.get()) != payloadLen))
                 {
-                    updateHighestLatency("Audio", ::mxlIndexToTimestamp(&rate, cursor.requestedIndex()), ::mxlGetTime());
-
-                    auto const payloadLen = windowSize * payload.count * sizeof(float);
-                    auto const buffer = ::gst_buffer_new_allocate(nullptr, payloadLen, nullptr);
-
-                    auto const audioMeta = ::gst_buffer_add_audio_meta(buffer, gstPipeline.audioInfo(), windowSize, nullptr);
-                    if (!audioMeta)
-                    {
-                        MXL_ERROR("Error while adding meta to audio buffer.");
-                        ::gst_buffer_unref(buffer);
-                        continue;
-                    }
+                    buffer.reset(::gst_buffer_new_allocate(nullptr, payloadLen, nullptr));
+                }
 
-                    GstAudioBuffer audioBuffer;
-                    if (!::gst_audio_buffer_map(&audioBuffer, gstPipeline.audioInfo(), buffer, GST_MAP_WRITE))
-                    {
-                        MXL_ERROR("Error while mapping audio buffer.");
-                        ::gst_buffer_unref(buffer);
-                        continue;
-                    }
+                GstMapInfo map;
+                if (!::gst_buffer_map(buffer.get(), &map, GST_MAP_WRITE))
+                {
+                    MXL_ERROR("Error while mapping audio buffer.");
+                    buffer.reset();
+                    continue;
+                }
 
-                    for (auto channel = std::size_t{0}; channel < payload.count; ++channel)
-                    {
-                        auto currentWritePtr = static_cast<std::byte*>(audioBuffer.planes[channel]);
-                        auto const readPtr0 = static_cast<std::byte const*>(payload.base.fragments[0].pointer) + channel * payload.stride;
-                        auto const readSize0 = payload.base.fragments[0].size;
-                        ::memcpy(currentWritePtr, readPtr0, readSize0);
-                        currentWritePtr += readSize0;
-
-                        auto const readPtr1 = static_cast<std::byte const*>(payload.base.fragments[1].pointer) + channel * payload.stride;
-                        auto const readSize1 = payload.base.fragments[1].size;
-                        ::memcpy(currentWritePtr, readPtr1, readSize1);
-                    }
+                auto const ret = ::mxlFlowReaderCopySamplesInterleaved(
+                    _reader, cursor.requestedIndex(), windowSize, iterationTimeoutNs, MXL_SAMPLE_FORMAT_NATIVE, 0U, map.data, map.size);
+                ::gst_buffer_unmap(buffer.get(), &map);
 
-                    ::gst_audio_buffer_unmap(&audioBuffer);
+                if (ret == MXL_STATUS_OK)
+                {
+                    updateHighestLatency("Audio", ::mxlIndexToTimestamp(&rate, cursor.requestedIndex()), ::mxlGetTime());
 
                     auto const firstSampleIndex = cursor.requestedIndex() - windowSize + 1;
-                    gstPipeline.pushBuffer(buffer, ::mxlIndexToTimestamp(&rate, firstSampleIndex));
+                    gstPipeline.pushBuffer(buffer.get(), ::mxlIndexToTimestamp(&rate, firstSampleIndex));
 
-                    ::gst_buffer_unref(buffer);
+                    // The pipeline holds on to the pushed buffer, so the next window goes into a new one.
+                    buffer.reset();
 
                     cursor.next();
+                    continue;
                 }
-                else if (ret == MXL_ERR_FLOW_INVALID)
+
+                if (ret == MXL_ERR_FLOW_INVALID)
                 {
                     if (handleInvalidFlow(cursor.requestedIndex()))
                     {
@@ -685,7 +674,7 @@ namespace
 
                     // Please note that it can occasionally happen that the last published index in this report is beyond
                     // the requested index, because the flow has been commited to in between the point in time, when the
-                    // call to mxlFlowReaderGetSamples() returned and the flow runtime info was fetched.
+                    // call to mxlFlowReaderCopySamplesInterleaved() returned and the flow runtime info was fetched.
                     MXL_TRACE("Failed to get samples at index {}: TOO EARLY. Last published {}", cursor.requestedIndex(), runtimeInfo.headIndex);
                 }
                 else if (ret == MXL_ERR_OUT_OF_RANGE_TOO_LATE)
@@ -229,6 +229,14 @@ namespace
                    << '\t' << fmt::format("{: >20}: {}", "Last read time", info.runtime.lastReadTime) << '\n';
             }
 
+            os << '\t' << fmt::format("{: >20}: {}", "Next commit time", info.runtime.nextCommitTime) << '\n'
+               << '\t' << fmt::format("{: >20}: {}", "Commit interval", info.runtime.commitInterval) << '\n';
+
+            if (mxlIsContinuousDataFormat(info.config.common.format))
+            {
+                os << '\t' << fmt::format("{: >20}: {}", "Open head index", info.runtime.openHeadIndex) << '\n';
+            }
+
             return os;
         }
 
@@ -511,6 +519,10 @@ namespace
             // Extract the mxlFlowInfo structure.
             auto info = ::mxlFlowInfo{};
             auto const getInfoStatus = ::mxlFlowReaderGetInfo(reader, &info);
+
+            // Only the grains of discrete flows can be backed by huge pages.
+            auto hugePageBacked = false;
+            auto const hugePageStatus = ::mxlFlowReaderIsHugePageBacked(reader, &hugePageBacked);
             ::mxlReleaseFlowReader(instance, reader);
 
             if (getInfoStatus == MXL_STATUS_OK)
@@ -529,6 +541,14 @@ namespace
                               << "Failed to check if flow is active: " << status << std::endl;
                 }
 
+                if (hugePageStatus == MXL_STATUS_OK)
+                {
+                    auto const requested = (info.config.common.flags & MXL_FLOW_CONFIG_FLAG_HUGE_PAGES) != 0U;
+                    std::cout << '\t'
+                              << fmt::format("{: >20}: {}", "Huge pages", hugePageBacked ? "yes" : (requested ? "requested, but not backed" : "no"))
+                              << std::endl;
+                }
+
                 return EXIT_SUCCESS;
             }
             else